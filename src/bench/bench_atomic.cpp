@@ -0,0 +1,171 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "atomic_rational.h"
+
+#ifdef HAVE_GMPXX_H
+#include "gmp_rational.h"
+#endif
+
+using namespace Commons::Math;
+
+template<class F>
+static double seconds ( F f ) {
+
+    const std::chrono::steady_clock::time_point &s ( std::chrono::steady_clock::now() );
+
+    f();
+
+    return std::chrono::duration<double> ( std::chrono::steady_clock::now() - s ).count();
+}
+
+template<class F>
+static void run ( unsigned int threads, F f ) {
+
+    std::vector<std::thread> pool;
+
+    for ( unsigned int t = 0u; t < threads; ++t ) pool.emplace_back ( f, t );
+
+    for ( std::thread &t : pool ) t.join();
+}
+
+template<class A>
+static bool sharded ( const char *name, const std::vector<typename A::rational_type> &v,
+                      unsigned int threads ) {
+
+    typedef typename A::rational_type rat;
+
+    const std::size_t n = v.size() / threads;
+
+    rat m;
+    std::mutex mx;
+    A a ( threads );
+
+    const double locked = seconds ( [&]() {
+        run ( threads, [&] ( unsigned int t ) {
+            for ( std::size_t i = t * n; i < ( t + 1u ) * n; ++i ) {
+                std::lock_guard<std::mutex> l ( mx );
+                m += v[i];
+            }
+        } );
+    } );
+
+    const double shard = seconds ( [&]() {
+        run ( threads, [&] ( unsigned int t ) {
+            for ( std::size_t i = t * n; i < ( t + 1u ) * n; ++i ) a.add ( v[i] );
+        } );
+
+        a.value();
+    } );
+
+    std::cout << name << ": " << ( n * threads ) << " additions on " << threads
+              << " threads; mutex " << locked << " s, ShardedRationalAccumulator " << shard
+              << " s, speedup " << ( locked / shard ) << std::endl;
+
+    return m == a.value();
+}
+
+int main ( int argc, char **argv ) {
+
+    typedef AtomicRational<int32_t> atomic_rational;
+    typedef atomic_rational::rational_type rat;
+
+    const std::size_t count = argc > 1 ? std::strtoul ( argv[1], 0L, 10 ) : 10000000u;
+    const unsigned int threads = argc > 2 ? std::strtoul ( argv[2], 0L, 10 ) :
+                                 std::max ( 1u, std::thread::hardware_concurrency() );
+
+    const std::size_t n = count / threads;
+
+    rat m;
+    std::mutex mx;
+    atomic_rational a;
+
+    // sums of 1/2 and -1/3 stay small
+    const double locked = seconds ( [&]() {
+        run ( threads, [&] ( unsigned int t ) {
+
+            const rat x ( t & 1 ? rat ( -1, 3 ) : rat ( 1, 2 ) );
+
+            for ( std::size_t i = 0u; i < n; ++i ) {
+                std::lock_guard<std::mutex> l ( mx );
+                m += x;
+            }
+        } );
+    } );
+
+    const double atomic = seconds ( [&]() {
+        run ( threads, [&] ( unsigned int t ) {
+
+            const rat x ( t & 1 ? rat ( -1, 3 ) : rat ( 1, 2 ) );
+
+            for ( std::size_t i = 0u; i < n; ++i ) a.fetch_add ( x );
+        } );
+    } );
+
+    std::cout << "Rational<int32_t>: " << ( n * threads ) << " additions on " << threads
+              << " threads; mutex " << locked << " s, AtomicRational " << atomic
+              << " s (lock-free: " << std::boolalpha << a.is_lock_free() << "), speedup "
+              << ( locked / atomic ) << std::endl;
+
+    bool ok = m == a.load();
+
+    std::srand ( 4711 );
+
+    std::vector<Rational<long> > l;
+
+    l.reserve ( count );
+
+    // few distinct denominators keep the sum within long
+    for ( std::size_t i = 0u; i < count; ++i ) {
+        l.push_back ( Rational<long> ( std::rand() % 201 - 100, std::rand() % 12 + 1 ) );
+    }
+
+    ok = sharded<ShardedRationalAccumulator<long> > ( "Rational<long>", l, threads ) && ok;
+
+#ifdef HAVE_GMPXX_H
+    std::vector<gmp_rational> g;
+
+    g.reserve ( count / 10u );
+
+    // runs of equal denominators, as i.e. prices in cents
+    for ( std::size_t i = 0u; i < count / 10u; ++i ) {
+        g.push_back ( gmp_rational ( std::rand() % 20001 - 10000,
+                                     i % 1000u < 900u ? 100 : std::rand() % 1000 + 1 ) );
+    }
+
+    ok = sharded<ShardedRationalAccumulator<mpz_class, GCD_gmp> > ( "gmp_rational", g,
+            threads ) && ok;
+#endif
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
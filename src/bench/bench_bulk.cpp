@@ -0,0 +1,91 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#include "bulk_rational.h"
+
+using namespace Commons::Math;
+
+typedef Rational<long> long_rational;
+
+template<class F>
+static double seconds ( F f ) {
+
+    const std::chrono::steady_clock::time_point &s ( std::chrono::steady_clock::now() );
+
+    f();
+
+    return std::chrono::duration<double> ( std::chrono::steady_clock::now() - s ).count();
+}
+
+static void report ( const char *what, std::size_t bytes, double secs ) {
+    std::cout << what << ": " << ( static_cast<double> ( bytes ) / ( 1024.0 * 1024.0 ) / secs )
+              << " MB/s" << std::endl;
+}
+
+int main ( int argc, char **argv ) {
+
+    const std::size_t count = argc > 1 ? std::strtoul ( argv[1], 0L, 10 ) : 10000000u;
+    const char *path = argc > 2 ? argv[2] : "bench_bulk.txt";
+    const unsigned int threads = std::max ( 1u, std::thread::hardware_concurrency() );
+
+    std::vector<long_rational> v, w;
+
+    v.reserve ( count );
+
+    std::srand ( 4711 );
+
+    for ( std::size_t i = 0u; i < count; ++i ) {
+        v.push_back ( long_rational ( std::rand() - RAND_MAX / 2, std::rand() % 100000 + 1 ) );
+    }
+
+    const double ws = seconds ( [&]() {
+        bulk_write ( path, v.begin(), v.end() );
+    } );
+
+    const std::size_t bytes = MappedFile ( path ).size();
+
+    std::cout << count << " rationals, " << bytes << " bytes" << std::endl;
+
+    report ( "write", bytes, ws );
+
+    w.reserve ( count );
+
+    report ( "read (1 thread)", bytes, seconds ( [&]() {
+        bulk_read ( path, w );
+    } ) );
+
+    const bool ok = v == w;
+
+    w.clear();
+
+    report ( "read (all threads)", bytes, seconds ( [&]() {
+        bulk_read ( path, w, threads );
+    } ) );
+
+    std::remove ( path );
+
+    return ok && v == w ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rational.h"
+
+#ifdef HAVE_GMPXX_H
+#include "gmp_rational.h"
+#endif
+
+using namespace Commons::Math;
+
+template<class F>
+static double seconds ( F f ) {
+
+    const std::chrono::steady_clock::time_point &s ( std::chrono::steady_clock::now() );
+
+    f();
+
+    return std::chrono::duration<double> ( std::chrono::steady_clock::now() - s ).count();
+}
+
+template<class R>
+static bool batch ( const char *name, const std::vector<std::string> &in, unsigned int threads ) {
+
+    std::vector<R> c, b;
+    std::vector<std::pair<std::size_t, std::string> > e;
+
+    c.reserve ( in.size() );
+    b.reserve ( in.size() );
+
+    const double ctor = seconds ( [&]() {
+        for ( const std::string &s : in ) c.push_back ( R ( s.c_str() ) );
+    } );
+
+    const double bat = seconds ( [&]() {
+        eval_batch<R> ( in.begin(), in.end(), std::back_inserter ( b ), std::back_inserter ( e ),
+                        threads );
+    } );
+
+    std::cout << name << ": " << in.size() << " strings; constructor " << ctor << " s, eval_batch"
+              << " on " << threads << " threads " << bat << " s, speedup " << ( ctor / bat )
+              << std::endl;
+
+    return c == b && e.empty();
+}
+
+int main ( int argc, char **argv ) {
+
+    const std::size_t count = argc > 1 ? std::strtoul ( argv[1], 0L, 10 ) : 1000000u;
+    const unsigned int threads = argc > 2 ? std::strtoul ( argv[2], 0L, 10 ) :
+                                 std::max ( 1u, std::thread::hardware_concurrency() );
+
+    std::srand ( 4711 );
+
+    std::vector<std::string> expr, plain;
+
+    expr.reserve ( count );
+    plain.reserve ( count );
+
+    for ( std::size_t i = 0u; i < count; ++i ) {
+
+        char buf[64];
+
+        std::snprintf ( buf, sizeof ( buf ), "(%d/%d + %d) * %d/%d - 1/%d",
+                        std::rand() % 100 - 50, std::rand() % 30 + 1, std::rand() % 10,
+                        std::rand() % 20 - 10, std::rand() % 9 + 1, std::rand() % 7 + 1 );
+        expr.push_back ( buf );
+
+        std::snprintf ( buf, sizeof ( buf ), "%d/%d", std::rand() % 1000 - 500,
+                        std::rand() % 300 + 1 );
+        plain.push_back ( buf );
+    }
+
+    bool ok = batch<Rational<long> > ( "Rational<long> expressions", expr, threads );
+
+    ok = batch<Rational<long> > ( "Rational<long> fractions", plain, threads ) && ok;
+
+#ifdef HAVE_GMPXX_H
+    ok = batch<gmp_rational> ( "gmp_rational expressions", expr, threads ) && ok;
+    ok = batch<gmp_rational> ( "gmp_rational fractions", plain, threads ) && ok;
+#endif
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
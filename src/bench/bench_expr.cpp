@@ -0,0 +1,135 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+
+#include "expr_rational.h"
+
+#ifdef HAVE_GMPXX_H
+#include "gmp_rational.h"
+#endif
+
+using namespace Commons::Math;
+
+template<class F>
+static double seconds ( F f ) {
+
+    const std::chrono::steady_clock::time_point &s ( std::chrono::steady_clock::now() );
+
+    f();
+
+    return std::chrono::duration<double> ( std::chrono::steady_clock::now() - s ).count();
+}
+
+template<class R>
+static bool chains ( const char *name, const std::vector<R> &a, const std::vector<R> &b,
+                     const std::vector<R> &c, const std::vector<R> &d ) {
+
+    typedef RationalPlaceholders<R> P;
+
+    std::vector<R> fs, ns, fp, np;
+
+    fs.reserve ( a.size() );
+    ns.reserve ( a.size() );
+    fp.reserve ( a.size() );
+    np.reserve ( a.size() );
+
+    const double flat_sum = seconds ( [&]() {
+        evaluate ( P::_1 + P::_2 - P::_3 + P::_4 + P::_1 * P::_2 - P::_3 + P::_4 + P::_1 -
+                   P::_2 + P::_3 + P::_4 * P::_4 - P::_1 + P::_2 + P::_3 - P::_4,
+                   std::back_inserter ( fs ), a.begin(), a.end(), b.begin(), c.begin(),
+                   d.begin() );
+    } );
+
+    const double nested_sum = seconds ( [&]() {
+        for ( std::size_t i = 0u; i < a.size(); ++i ) {
+            ns.push_back ( a[i] + b[i] - c[i] + d[i] + a[i] * b[i] - c[i] + d[i] + a[i] -
+                           b[i] + c[i] + d[i] * d[i] - a[i] + b[i] + c[i] - d[i] );
+        }
+    } );
+
+    const double flat_product = seconds ( [&]() {
+        evaluate ( P::_1 * P::_2 * P::_3 * P::_4 * P::_2 * P::_3, std::back_inserter ( fp ),
+                   a.begin(), a.end(), b.begin(), c.begin(), d.begin() );
+    } );
+
+    const double nested_product = seconds ( [&]() {
+        for ( std::size_t i = 0u; i < a.size(); ++i ) {
+            np.push_back ( a[i] * b[i] * c[i] * d[i] * b[i] * c[i] );
+        }
+    } );
+
+    std::cout << name << ": sum of 16 terms nested " << nested_sum << " s, flattened "
+              << flat_sum << " s, speedup " << ( nested_sum / flat_sum )
+              << "; product of 6 factors nested " << nested_product << " s, flattened "
+              << flat_product << " s, speedup " << ( nested_product / flat_product )
+              << std::endl;
+
+    return fs == ns && fp == np;
+}
+
+int main ( int argc, char **argv ) {
+
+    const std::size_t count = argc > 1 ? std::strtoul ( argv[1], 0L, 10 ) : 1000000u;
+
+    std::srand ( 4711 );
+
+    std::vector<Rational<long> > v[4];
+
+    for ( std::size_t j = 0u; j < 4u; ++j ) {
+
+        v[j].reserve ( count );
+
+        for ( std::size_t i = 0u; i < count; ++i ) {
+            v[j].push_back ( Rational<long> ( std::rand() % 2001 - 1000, std::rand() % 30 + 1 ) );
+        }
+    }
+
+    bool ok = chains ( "Rational<long>", v[0], v[1], v[2], v[3] );
+
+#ifdef HAVE_GMPXX_H
+    std::vector<gmp_rational> g[4];
+
+    for ( std::size_t j = 0u; j < 4u; ++j ) {
+
+        g[j].reserve ( count / 10u );
+
+        for ( std::size_t i = 0u; i < count / 10u; ++i ) {
+            g[j].push_back ( gmp_rational ( mpz_class ( v[j][i].numerator() ) *
+                                            v[( j + 1u ) % 4u][i].numerator() *
+                                            v[( j + 2u ) % 4u][i].numerator() + 1,
+                                            mpz_class ( v[j][i].denominator() ) *
+                                            v[( j + 3u ) % 4u][i].denominator() ) );
+        }
+    }
+
+    ok = chains ( "gmp_rational", g[0], g[1], g[2], g[3] ) && ok;
+#endif
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rational.h"
+
+#ifdef HAVE_GMPXX_H
+#include "gmp_rational.h"
+#endif
+
+using namespace Commons::Math;
+
+template<class F>
+static double seconds ( F f ) {
+
+    const std::chrono::steady_clock::time_point &s ( std::chrono::steady_clock::now() );
+
+    f();
+
+    return std::chrono::duration<double> ( std::chrono::steady_clock::now() - s ).count();
+}
+
+// the hasher needed without std::hash
+template<class R>
+struct str_hash {
+    std::size_t operator() ( const R& r ) const {
+        return std::hash<std::string>() ( r.str() );
+    }
+};
+
+// inserts all keys, then looks each of them up, returns the sum of the looked up values
+template<class M, class R>
+static std::size_t fill ( M &m, const std::vector<R> &k ) {
+
+    std::size_t s = 0u;
+
+    for ( std::size_t i = 0u; i < k.size(); ++i ) m[k[i]] += i;
+
+    for ( std::size_t i = 0u; i < k.size(); ++i ) s += m.find ( k[i] )->second;
+
+    return s;
+}
+
+template<class R>
+static bool hash ( const char *name, const std::vector<R> &k ) {
+
+    std::map<R, std::size_t> o;
+    std::unordered_map<R, std::size_t, str_hash<R> > t;
+    std::unordered_map<R, std::size_t> u;
+
+    std::size_t so = 0u, st = 0u, su = 0u;
+
+    const double map = seconds ( [&]() {
+        so = fill ( o, k );
+    } );
+
+    const double str = seconds ( [&]() {
+        st = fill ( t, k );
+    } );
+
+    const double hsh = seconds ( [&]() {
+        su = fill ( u, k );
+    } );
+
+    std::cout << name << ": " << k.size() << " insertions and lookups of " << u.size()
+              << " keys; std::map " << map << " s, unordered_map with str() hash " << str
+              << " s, with std::hash " << hsh << " s, speedup " << ( map / hsh ) << " / "
+              << ( str / hsh ) << std::endl;
+
+    return so == su && st == su;
+}
+
+int main ( int argc, char **argv ) {
+
+    const std::size_t count = argc > 1 ? std::strtoul ( argv[1], 0L, 10 ) : 1000000u;
+
+    std::srand ( 4711 );
+
+    std::vector<Rational<long> > l;
+
+    l.reserve ( count );
+
+    for ( std::size_t i = 0u; i < count; ++i ) {
+        l.push_back ( Rational<long> ( std::rand() % 100001 - 50000, std::rand() % 1000 + 1 ) );
+    }
+
+    bool ok = hash ( "Rational<long>", l );
+
+#ifdef HAVE_GMPXX_H
+    std::vector<gmp_rational> g;
+
+    g.reserve ( count / 4u );
+
+    // keys beyond 64 bits
+    for ( std::size_t i = 0u; i < count / 4u; ++i ) {
+        g.push_back ( gmp_rational ( mpz_class ( std::rand() ) * std::rand() * std::rand(),
+                                     mpz_class ( std::rand() % 1000 + 1 ) ) );
+    }
+
+    ok = hash ( "gmp_rational", g ) && ok;
+#endif
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
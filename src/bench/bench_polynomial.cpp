@@ -0,0 +1,143 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+
+#include "polynomial_rational.h"
+
+#ifdef HAVE_GMPXX_H
+#include "gmp_rational.h"
+#endif
+
+using namespace Commons::Math;
+
+template<class F>
+static double seconds ( F f ) {
+
+    const std::chrono::steady_clock::time_point &s ( std::chrono::steady_clock::now() );
+
+    f();
+
+    return std::chrono::duration<double> ( std::chrono::steady_clock::now() - s ).count();
+}
+
+template<class P>
+static bool horner ( const char *name, const std::vector<typename P::rational_type> &c,
+                     const std::vector<typename P::rational_type> &x ) {
+
+    typedef typename P::rational_type rat;
+
+    const P p ( c.begin(), c.end() );
+
+    std::vector<rat> n, s, b, t;
+
+    n.reserve ( x.size() );
+    s.reserve ( x.size() );
+    b.reserve ( x.size() );
+    t.reserve ( x.size() );
+
+    const double naive = seconds ( [&]() {
+        for ( const rat &v : x ) {
+
+            rat r;
+
+            for ( std::size_t i = c.size(); i-- > 0u; ) r = r * v + c[i];
+
+            n.push_back ( r );
+        }
+    } );
+
+    const double single = seconds ( [&]() {
+        for ( const rat &v : x ) s.push_back ( p ( v ) );
+    } );
+
+    const double batch = seconds ( [&]() {
+        p.evaluate ( x.begin(), x.end(), std::back_inserter ( b ) );
+    } );
+
+    const double threaded = seconds ( [&]() {
+        p.evaluate ( x.begin(), x.end(), std::back_inserter ( t ), 4u );
+    } );
+
+    std::cout << name << ": degree " << p.degree() << " at " << x.size() << " points naive "
+              << naive << " s, single " << single << " s, speedup " << ( naive / single )
+              << "; batch " << batch << " s, speedup " << ( naive / batch ) << "; 4 threads "
+              << threaded << " s, speedup " << ( naive / threaded ) << std::endl;
+
+    return n == s && n == b && n == t;
+}
+
+int main ( int argc, char **argv ) {
+
+    const std::size_t count = argc > 1 ? std::strtoul ( argv[1], 0L, 10 ) : 1000000u;
+
+    std::srand ( 4711 );
+
+    typedef RationalPolynomial<long> long_poly;
+
+    std::vector<long_poly::rational_type> lc, lx, lg;
+
+    for ( long i = 0; i < 5; ++i ) {
+        lc.push_back ( long_poly::rational_type ( std::rand() % 21 - 10, i + 1 ) );
+    }
+
+    lx.reserve ( count );
+    lg.reserve ( count );
+
+    for ( std::size_t i = 0u; i < count; ++i ) {
+        lx.push_back ( long_poly::rational_type ( std::rand() % 61 - 30, std::rand() % 30 + 1 ) );
+        lg.push_back ( long_poly::rational_type ( static_cast<long> ( i % 121u ) - 60, 12 ) );
+    }
+
+    bool ok = horner<long_poly> ( "Rational<long> random", lc, lx );
+
+    ok = horner<long_poly> ( "Rational<long> grid", lc, lg ) && ok;
+
+#ifdef HAVE_GMPXX_H
+    typedef RationalPolynomial<mpz_class, GCD_gmp> gmp_poly;
+
+    std::vector<gmp_rational> gc, gx, gg;
+
+    // the Taylor polynomial of log(1 + x)
+    for ( long i = 0; i < 17; ++i ) gc.push_back ( gmp_rational ( i ? ( i & 1 ? 1 : -1 ) : 0,
+                    i ? i : 1 ) );
+
+    gx.reserve ( count / 10u );
+    gg.reserve ( count / 10u );
+
+    for ( std::size_t i = 0u; i < count / 10u; ++i ) {
+        gx.push_back ( gmp_rational ( std::rand() % 2001 - 1000, std::rand() % 1000 + 1 ) );
+        gg.push_back ( gmp_rational ( static_cast<long> ( i % 2001u ) - 1000, 1000 ) );
+    }
+
+    ok = horner<gmp_poly> ( "gmp_rational random", gc, gx ) && ok;
+    ok = horner<gmp_poly> ( "gmp_rational grid", gc, gg ) && ok;
+#endif
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
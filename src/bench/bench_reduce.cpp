@@ -0,0 +1,114 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+
+#include "rational.h"
+
+#ifdef HAVE_GMPXX_H
+#include "gmp_rational.h"
+#endif
+
+using namespace Commons::Math;
+
+template<class F>
+static double seconds ( F f ) {
+
+    const std::chrono::steady_clock::time_point &s ( std::chrono::steady_clock::now() );
+
+    f();
+
+    return std::chrono::duration<double> ( std::chrono::steady_clock::now() - s ).count();
+}
+
+template<class R>
+static bool reduce ( const char *name, const std::vector<R> &v, unsigned int threads ) {
+
+    R fs, ts, fp, tp;
+
+    const double fold_sum = seconds ( [&]() {
+        fs = std::accumulate ( v.begin(), v.end(), R() );
+    } );
+
+    const double tree_sum = seconds ( [&]() {
+        ts = parallel_sum ( v.begin(), v.end(), threads );
+    } );
+
+    const double fold_product = seconds ( [&]() {
+        fp = std::accumulate ( v.begin(), v.end(), R ( 1, 1 ), std::multiplies<R>() );
+    } );
+
+    const double tree_product = seconds ( [&]() {
+        tp = parallel_product ( v.begin(), v.end(), threads );
+    } );
+
+    std::cout << name << ": " << v.size() << " values on " << threads << " threads; sum fold "
+              << fold_sum << " s, tree " << tree_sum << " s, speedup " << ( fold_sum / tree_sum )
+              << "; product fold " << fold_product << " s, tree " << tree_product
+              << " s, speedup " << ( fold_product / tree_product ) << std::endl;
+
+    return fs == ts && fp == tp;
+}
+
+int main ( int argc, char **argv ) {
+
+    const std::size_t count = argc > 1 ? std::strtoul ( argv[1], 0L, 10 ) : 10000000u;
+    const unsigned int threads = argc > 2 ? std::strtoul ( argv[2], 0L, 10 ) :
+                                 std::max ( 1u, std::thread::hardware_concurrency() );
+
+    std::srand ( 4711 );
+
+    std::vector<Rational<int64_t> > v;
+
+    v.reserve ( count );
+
+    // pairs of inverse factors keep the results within int64_t
+    for ( std::size_t i = 0u; i < count; i += 2u ) {
+
+        const int64_t d = std::rand() % 12 + 1;
+
+        v.push_back ( Rational<int64_t> ( -d - 1, d ) );
+        v.push_back ( Rational<int64_t> ( -d, d + 1 ) );
+    }
+
+    bool ok = reduce ( "Rational<int64_t>", v, threads );
+
+#ifdef HAVE_GMPXX_H
+    std::vector<gmp_rational> g;
+
+    g.reserve ( count / 100u );
+
+    for ( std::size_t i = 0u; i < count / 100u; ++i ) {
+        g.push_back ( gmp_rational ( std::rand() % 2001 - 1000, std::rand() % 1000 + 1 ) );
+    }
+
+    ok = reduce ( "gmp_rational", g, threads ) && ok;
+#endif
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
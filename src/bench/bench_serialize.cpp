@@ -0,0 +1,116 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#include "rational.h"
+
+#ifdef HAVE_GMPXX_H
+#include "gmp_rational.h"
+#endif
+
+using namespace Commons::Math;
+
+template<class F>
+static double seconds ( F f ) {
+
+    const std::chrono::steady_clock::time_point &s ( std::chrono::steady_clock::now() );
+
+    f();
+
+    return std::chrono::duration<double> ( std::chrono::steady_clock::now() - s ).count();
+}
+
+template<class R>
+static bool roundtrip ( const char *name, const std::vector<R> &v ) {
+
+    std::vector<R> w;
+    std::stringstream ts, bs;
+
+    w.reserve ( v.size() );
+
+    const double text = seconds ( [&]() {
+
+        for ( const R &r : v ) ts << r << '\n';
+
+        RationalReader<R> rd ( ts );
+
+        w.assign ( rd.begin(), rd.end() );
+    } );
+
+    const bool tok = v == w;
+
+    w.clear();
+
+    const double bin = seconds ( [&]() {
+
+        RationalBinaryWriter ( bs ).write ( v.begin(), v.end() );
+
+        RationalBinaryReader<R> rd ( bs );
+
+        w.assign ( rd.begin(), rd.end() );
+    } );
+
+    std::cout << name << ": text " << text << " s (" << ts.str().size() << " bytes), binary "
+              << bin << " s (" << bs.str().size() << " bytes), speedup " << ( text / bin )
+              << std::endl;
+
+    return tok && v == w;
+}
+
+int main ( int argc, char **argv ) {
+
+    const std::size_t count = argc > 1 ? std::strtoul ( argv[1], 0L, 10 ) : 10000000u;
+
+    std::srand ( 4711 );
+
+    std::vector<Rational<long> > v;
+
+    v.reserve ( count );
+
+    for ( std::size_t i = 0u; i < count; ++i ) {
+        v.push_back ( Rational<long> ( std::rand() - RAND_MAX / 2, std::rand() % 100000 + 1 ) );
+    }
+
+    bool ok = roundtrip ( "Rational<long>", v );
+
+#ifdef HAVE_GMPXX_H
+    std::vector<gmp_rational> g;
+
+    g.reserve ( count / 10u );
+
+    for ( std::size_t i = 0u; i < count / 10u; ++i ) {
+        g.push_back ( gmp_rational ( mpz_class ( v[i].numerator() ) * v[i + 1].numerator() *
+                                     v[i + 2].numerator(), mpz_class ( v[i].denominator() ) ) );
+    }
+
+    ok = roundtrip ( "gmp_rational", g ) && ok;
+#endif
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
@@ -0,0 +1,646 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * @author Heiko Schäfer <heiko@rangun.de>
+ * @copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * @defgroup atomic Atomic fractions
+ *
+ * The header `atomic_rational.h` provides %Rationals of built-in storage types, which can
+ * be updated concurrently from many threads without a mutex, and sums of any storage type,
+ * which many threads can add to without waiting for each other (needs @em C++11).
+ *
+ * Numerator and denominator are stored as one packed pair in an @c std::atomic. Every
+ * update is a compare-and-swap loop on this pair: the new value gets calculated and reduced
+ * from the observed one @em before the compare-and-swap, which only publishes it. If another
+ * thread came first, the exchange hands back the current pair and the calculation is
+ * repeated on it, no extra load is needed.
+ *
+ * Pairs of up to 64 bits (i.e. of @c int32_t) are lock-free on all common platforms. Wider
+ * storage types aren't supported, as their pairs would need a double-width compare-and-swap,
+ * which isn't lock-free with all compilers and needs to be linked with @c -latomic.
+ *
+ * @b Example: @code{.cpp}
+ * typedef Commons::Math::AtomicRational<int32_t> atomic_rational;
+ *
+ * atomic_rational rate;
+ *
+ * // on many threads
+ * rate.fetch_add ( atomic_rational::rational_type ( 1, 3 ) );@endcode
+ *
+ * A Commons::Math::ShardedRationalAccumulator keeps one partial sum per thread instead,
+ * each on its own cache line, and adds them up only if the value is requested.
+ *
+ * @b Example: @code{.cpp}
+ * Commons::Math::ShardedRationalAccumulator<mpz_class, Commons::Math::GCD_gmp> sum;
+ *
+ * // on many threads
+ * sum.add ( Commons::Math::gmp_rational ( 1, 3 ) );
+ *
+ * // after joining them
+ * const Commons::Math::gmp_rational &s ( sum.value() );@endcode
+ */
+
+#ifndef COMMONS_MATH_ATOMIC_RATIONAL_H
+#define COMMONS_MATH_ATOMIC_RATIONAL_H
+
+#include "rational.h"
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace Commons {
+
+namespace Math {
+
+template<template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD>
+struct _gcd_reduces {
+    static const bool value = true;
+};
+
+template<>
+struct _gcd_reduces<GCD_null> {
+    static const bool value = false;
+};
+
+/**
+ * @ingroup atomic
+ * @brief %Rational with atomic operations
+ *
+ * The interface follows @c std::atomic. As all %Rationals are reduced, equal values have
+ * equal pairs, so the compare-and-swap operations compare by value. Therefore
+ * Commons::Math::GCD_null isn't allowed.
+ *
+ * If an operation throws (i.e. on overflow or division by zero), the value stays unchanged.
+ *
+ * @tparam T built-in storage type, numerator and denominator together fit in 64 bits
+ * @tparam GCD GCD algorithm, except Commons::Math::GCD_null
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ * @tparam Alloc the allocator
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD = GCD_euclid_fast,
+         template<class, typename = T, bool = std::numeric_limits<T>::is_signed>
+         class CHKOP = NO_OPERATOR_CHECK, template<typename> class Alloc = std::allocator>
+class AtomicRational {
+
+    static_assert ( std::is_integral<T>::value,
+                    "only built-in integer types are allowed as storage type" );
+    static_assert ( sizeof ( T ) <= 4u, "numerator and denominator have to fit in 64 bits" );
+    static_assert ( _gcd_reduces<GCD>::value,
+                    "the compare-and-swap needs reduced fractions to compare by value" );
+
+    RATIONAL_NOCOPYASSIGN ( AtomicRational );
+
+public:
+    typedef Rational<T, GCD, CHKOP, Alloc> rational_type; ///< the type of the value
+    typedef typename rational_type::integer_type integer_type; ///< storage type
+
+private:
+    struct _pair {
+        integer_type n;
+        integer_type d;
+    };
+
+    // the compound assignments work in place, saving the temporaries of the binary operators
+    struct _add {
+        void operator() ( rational_type& x, const rational_type& y ) const {
+            x += y;
+        }
+    };
+
+    struct _sub {
+        void operator() ( rational_type& x, const rational_type& y ) const {
+            x -= y;
+        }
+    };
+
+    struct _mul {
+        void operator() ( rational_type& x, const rational_type& y ) const {
+            x *= y;
+        }
+    };
+
+    struct _div {
+        void operator() ( rational_type& x, const rational_type& y ) const {
+            x /= y;
+        }
+    };
+
+public:
+    /**
+     * @brief creates an atomic @em zero
+     */
+    AtomicRational() noexcept : m_v ( _pack ( rational_type() ) ) {}
+
+    /**
+     * @brief creates an atomic %Rational
+     *
+     * @note the initialization isn't atomic
+     *
+     * @param[in] r the initial value
+     */
+    AtomicRational ( const rational_type& r ) noexcept : m_v ( _pack ( r ) ) {}
+
+    /**
+     * @brief checks if the operations are lock-free
+     */
+    bool is_lock_free() const noexcept {
+        return m_v.is_lock_free();
+    }
+
+    /**
+     * @brief reads the value
+     *
+     * @param[in] order the memory order
+     */
+    rational_type load ( std::memory_order order = std::memory_order_seq_cst ) const noexcept {
+        return _unpack ( m_v.load ( order ) );
+    }
+
+    /**
+     * @brief replaces the value
+     *
+     * @param[in] r the new value
+     * @param[in] order the memory order
+     */
+    void store ( const rational_type& r,
+                 std::memory_order order = std::memory_order_seq_cst ) noexcept {
+        m_v.store ( _pack ( r ), order );
+    }
+
+    /**
+     * @brief replaces the value
+     *
+     * @see store()
+     *
+     * @return @c r
+     */
+    rational_type operator= ( const rational_type& r ) noexcept {
+        store ( r );
+        return r;
+    }
+
+    /**
+     * @brief replaces the value
+     *
+     * @param[in] r the new value
+     * @param[in] order the memory order
+     *
+     * @return the previous value
+     */
+    rational_type exchange ( const rational_type& r,
+                             std::memory_order order = std::memory_order_seq_cst ) noexcept {
+        return _unpack ( m_v.exchange ( _pack ( r ), order ) );
+    }
+
+    /**
+     * @brief replaces the value if it equals @c expected
+     *
+     * May fail spuriously, i.e. within a loop.
+     *
+     * @param[in,out] expected the expected value, gets the current value on failure
+     * @param[in] desired the new value
+     * @param[in] success the memory order on success
+     * @param[in] failure the memory order on failure
+     *
+     * @return @c true if the value was replaced
+     */
+    bool compare_exchange_weak ( rational_type& expected, const rational_type& desired,
+                                 std::memory_order success,
+                                 std::memory_order failure ) noexcept {
+
+        _pair e ( _pack ( expected ) );
+
+        if ( m_v.compare_exchange_weak ( e, _pack ( desired ), success, failure ) ) return true;
+
+        expected = _unpack ( e );
+
+        return false;
+    }
+
+    /**
+     * @brief replaces the value if it equals @c expected
+     *
+     * May fail spuriously, i.e. within a loop.
+     *
+     * @param[in,out] expected the expected value, gets the current value on failure
+     * @param[in] desired the new value
+     * @param[in] order the memory order
+     *
+     * @return @c true if the value was replaced
+     */
+    bool compare_exchange_weak ( rational_type& expected, const rational_type& desired,
+                                 std::memory_order order = std::memory_order_seq_cst ) noexcept {
+        return compare_exchange_weak ( expected, desired, order, _failure ( order ) );
+    }
+
+    /**
+     * @brief replaces the value if it equals @c expected
+     *
+     * @param[in,out] expected the expected value, gets the current value on failure
+     * @param[in] desired the new value
+     * @param[in] success the memory order on success
+     * @param[in] failure the memory order on failure
+     *
+     * @return @c true if the value was replaced
+     */
+    bool compare_exchange_strong ( rational_type& expected, const rational_type& desired,
+                                   std::memory_order success,
+                                   std::memory_order failure ) noexcept {
+
+        _pair e ( _pack ( expected ) );
+
+        if ( m_v.compare_exchange_strong ( e, _pack ( desired ), success, failure ) ) return true;
+
+        expected = _unpack ( e );
+
+        return false;
+    }
+
+    /**
+     * @brief replaces the value if it equals @c expected
+     *
+     * @param[in,out] expected the expected value, gets the current value on failure
+     * @param[in] desired the new value
+     * @param[in] order the memory order
+     *
+     * @return @c true if the value was replaced
+     */
+    bool compare_exchange_strong ( rational_type& expected, const rational_type& desired,
+                                   std::memory_order order =
+                                       std::memory_order_seq_cst ) noexcept {
+        return compare_exchange_strong ( expected, desired, order, _failure ( order ) );
+    }
+
+    /**
+     * @brief atomically adds @c r
+     *
+     * @param[in] r the summand
+     * @param[in] order the memory order
+     *
+     * @return the previous value
+     */
+    rational_type fetch_add ( const rational_type& r,
+                              std::memory_order order = std::memory_order_seq_cst ) {
+        _pair d;
+        return _unpack ( _update ( r, _add(), order, d ) );
+    }
+
+    /**
+     * @brief atomically subtracts @c r
+     *
+     * @param[in] r the subtrahend
+     * @param[in] order the memory order
+     *
+     * @return the previous value
+     */
+    rational_type fetch_sub ( const rational_type& r,
+                              std::memory_order order = std::memory_order_seq_cst ) {
+        _pair d;
+        return _unpack ( _update ( r, _sub(), order, d ) );
+    }
+
+    /**
+     * @brief atomically multiplies by @c r
+     *
+     * @param[in] r the factor
+     * @param[in] order the memory order
+     *
+     * @return the previous value
+     */
+    rational_type fetch_mul ( const rational_type& r,
+                              std::memory_order order = std::memory_order_seq_cst ) {
+        _pair d;
+        return _unpack ( _update ( r, _mul(), order, d ) );
+    }
+
+    /**
+     * @brief atomically divides by @c r
+     *
+     * @param[in] r the divisor
+     * @param[in] order the memory order
+     *
+     * @return the previous value
+     */
+    rational_type fetch_div ( const rational_type& r,
+                              std::memory_order order = std::memory_order_seq_cst ) {
+        _pair d;
+        return _unpack ( _update ( r, _div(), order, d ) );
+    }
+
+    /**
+     * @brief atomically adds @c r
+     *
+     * @return the new value
+     */
+    rational_type operator+= ( const rational_type& r ) {
+
+        _pair d;
+
+        _update ( r, _add(), std::memory_order_seq_cst, d );
+
+        return _unpack ( d );
+    }
+
+    /**
+     * @brief atomically subtracts @c r
+     *
+     * @return the new value
+     */
+    rational_type operator-= ( const rational_type& r ) {
+
+        _pair d;
+
+        _update ( r, _sub(), std::memory_order_seq_cst, d );
+
+        return _unpack ( d );
+    }
+
+    /**
+     * @brief atomically multiplies by @c r
+     *
+     * @return the new value
+     */
+    rational_type operator*= ( const rational_type& r ) {
+
+        _pair d;
+
+        _update ( r, _mul(), std::memory_order_seq_cst, d );
+
+        return _unpack ( d );
+    }
+
+    /**
+     * @brief atomically divides by @c r
+     *
+     * @return the new value
+     */
+    rational_type operator/= ( const rational_type& r ) {
+
+        _pair d;
+
+        _update ( r, _div(), std::memory_order_seq_cst, d );
+
+        return _unpack ( d );
+    }
+
+private:
+    static _pair _pack ( const rational_type& r ) noexcept {
+        const _pair p = { r.numerator(), r.denominator() };
+        return p;
+    }
+
+    // the pair is reduced already
+    static rational_type _unpack ( const _pair& p ) noexcept {
+
+        rational_type r;
+
+        r.m_numer = p.n;
+        r.m_denom = p.d;
+
+        return r;
+    }
+
+    static std::memory_order _failure ( std::memory_order order ) noexcept {
+        return order == std::memory_order_acq_rel ? std::memory_order_acquire :
+               ( order == std::memory_order_release ? std::memory_order_relaxed : order );
+    }
+
+    // calculates the reduced new value outside of the exchange, a failed exchange updates
+    // the observed pair, so only the calculation gets repeated
+    template<class Op>
+    _pair _update ( const rational_type& r, Op op, std::memory_order order, _pair& d ) {
+
+        _pair e ( m_v.load ( std::memory_order_relaxed ) );
+
+        do {
+            rational_type x ( _unpack ( e ) );
+            op ( x, r );
+            d = _pack ( x );
+        } while ( !m_v.compare_exchange_weak ( e, d, order, std::memory_order_relaxed ) );
+
+        return e;
+    }
+
+    std::atomic<_pair> m_v;
+};
+
+// built-in storage types get reduced on every addition, the unreduced terms would overflow
+template<class R, bool = tmp::_isClassT<typename R::integer_type>::Yes>
+struct _deferred_sum {
+
+    _deferred_sum() : m_s() {}
+
+    void add ( const R& x ) {
+        m_s += x;
+    }
+
+    R value() const {
+        return m_s;
+    }
+
+private:
+    R m_s;
+};
+
+// big integers add terms unreduced, a denominator dividing the one of the sum costs no gcd
+template<class R>
+struct _deferred_sum<R, true> {
+
+    _deferred_sum() : m_n(), m_d ( R::one_ ), m_pending ( 0u ) {}
+
+    void add ( const R& x ) {
+
+        const typename R::op_multiplies mul = typename R::op_multiplies();
+
+        if ( x.denominator() == m_d ) {
+            m_n = typename R::op_plus() ( m_n, x.numerator() );
+            return;
+        }
+
+        if ( typename R::op_modulus() ( m_d, x.denominator() ) == R::zero_ ) {
+            m_n = typename R::op_plus() ( m_n, mul ( x.numerator(),
+                                          typename R::op_divides() ( m_d, x.denominator() ) ) );
+            return;
+        }
+
+        m_n = typename R::op_plus() ( mul ( m_n, x.denominator() ), mul ( x.numerator(), m_d ) );
+        m_d = mul ( m_d, x.denominator() );
+
+        // keep the terms from growing too much
+        if ( ++m_pending == 16u ) {
+
+            const R r ( m_n, m_d );
+
+            m_n = r.numerator();
+            m_d = r.denominator();
+            m_pending = 0u;
+        }
+    }
+
+    R value() const {
+        return R ( m_n, m_d );
+    }
+
+private:
+    typename R::integer_type m_n;
+    typename R::integer_type m_d;
+    unsigned int m_pending;
+};
+
+/**
+ * @ingroup atomic
+ * @brief Sum, which many threads can add to concurrently
+ *
+ * Every thread adds to its own shard (or, if there are more threads than shards, shares one
+ * with few others), so the threads don't wait for each other. The shards are padded, so that
+ * no two of them share a cache line.
+ *
+ * For class storage types (i.e. big integers) the shards add the terms without reducing
+ * them: if the denominator divides the one of the partial sum, the numerator just gets
+ * scaled and added, otherwise the denominators get multiplied and the partial sum gets
+ * reduced after every @c 16 such terms.
+ *
+ * value() adds the reduced partial sums in a balanced tree (see parallel_sum()).
+ *
+ * @tparam T storage type
+ * @tparam GCD GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ * @tparam Alloc the allocator
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD = GCD_euclid_fast,
+         template<class, typename = T, bool = std::numeric_limits<T>::is_signed>
+         class CHKOP = NO_OPERATOR_CHECK, template<typename> class Alloc = std::allocator>
+class ShardedRationalAccumulator {
+
+    RATIONAL_NOCOPYASSIGN ( ShardedRationalAccumulator );
+
+public:
+    typedef Rational<T, GCD, CHKOP, Alloc> rational_type; ///< the type of the sum
+
+private:
+    // 64 bytes are the cache line size of all common platforms. The padding keeps the members
+    // of neighbouring shards on different lines without relying on over-aligned allocation,
+    // which std::allocator supports only since C++17
+    struct _shard {
+        char pad[64];
+        std::mutex m;
+        _deferred_sum<rational_type> s;
+    };
+
+public:
+    /**
+     * @brief creates a sum of @em zero
+     *
+     * @param[in] shards the amount of partial sums, at least @c 1
+     */
+    explicit ShardedRationalAccumulator ( unsigned int shards =
+            std::thread::hardware_concurrency() ) : m_shards ( std::max ( 1u, shards ) ) {}
+
+    /**
+     * @brief gets the amount of partial sums
+     */
+    std::size_t shards() const {
+        return m_shards.size();
+    }
+
+    /**
+     * @brief adds @c x to the partial sum of the calling thread
+     *
+     * @param[in] x the summand
+     */
+    void add ( const rational_type& x ) {
+
+        _shard &s ( m_shards[_thread_index() % m_shards.size()] );
+        const std::lock_guard<std::mutex> l ( s.m );
+
+        s.s.add ( x );
+    }
+
+    /**
+     * @brief adds @c x to the partial sum of the calling thread
+     *
+     * @see add()
+     */
+    ShardedRationalAccumulator& operator+= ( const rational_type& x ) {
+        add ( x );
+        return *this;
+    }
+
+    /**
+     * @brief gets the sum
+     *
+     * If other threads are still adding, the sum contains an arbitrary subset of their
+     * summands.
+     */
+    rational_type value() {
+
+        std::vector<rational_type, Alloc<rational_type> > p;
+
+        p.reserve ( m_shards.size() );
+
+        for ( _shard &s : m_shards ) {
+            const std::lock_guard<std::mutex> l ( s.m );
+            p.push_back ( s.s.value() );
+        }
+
+        return parallel_sum ( p.begin(), p.end() );
+    }
+
+    /**
+     * @brief resets the sum to @em zero
+     */
+    void clear() {
+
+        for ( _shard &s : m_shards ) {
+            const std::lock_guard<std::mutex> l ( s.m );
+            s.s = _deferred_sum<rational_type>();
+        }
+    }
+
+private:
+    // numbers the threads in the order of their first addition
+    static unsigned int _thread_index() {
+
+        static std::atomic<unsigned int> next ( 0u );
+        static thread_local const unsigned int index ( next++ );
+
+        return index;
+    }
+
+    std::vector<_shard, Alloc<_shard> > m_shards;
+};
+
+}
+
+}
+
+#endif
+
+#endif /* COMMONS_MATH_ATOMIC_RATIONAL_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
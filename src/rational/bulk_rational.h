@@ -0,0 +1,501 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * @author Heiko Schäfer <heiko@rangun.de>
+ * @copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * @defgroup bulk Bulk text I/O
+ *
+ * The header `bulk_rational.h` reads and writes huge amounts of %Rationals
+ * stored as text, one per line.
+ *
+ * Input files are memory-mapped and split into chunks of whole lines, which are
+ * parsed by Commons::Math::from_chars() (or evaluated as @em expression if they
+ * aren't plain fractions), optionally on multiple threads (needs @em C++11).
+ * Output is formatted by Commons::Math::to_chars() into a large buffer, which is
+ * written out only if it is full.
+ *
+ * @b Example: @code{.cpp}
+ * std::vector<Commons::Math::Rational<long> > v;
+ *
+ * Commons::Math::bulk_read ( "in.txt", v, 4 );
+ * Commons::Math::bulk_write ( "out.txt", v.begin(), v.end() );@endcode
+ *
+ * The functions need a @em POSIX system.
+ */
+
+#ifndef COMMONS_MATH_BULK_RATIONAL_H
+#define COMMONS_MATH_BULK_RATIONAL_H
+
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "rational.h"
+
+namespace Commons {
+
+namespace Math {
+
+/**
+ * @ingroup bulk
+ * @brief A read-only memory-mapped file
+ *
+ * If the file cannot be opened or mapped, an @c std::runtime_error is thrown, or if
+ * exceptions are disabled, data() returns @c 0L.
+ */
+class MappedFile {
+
+    RATIONAL_NOCOPYASSIGN ( MappedFile );
+
+public:
+    /**
+     * @brief maps the file @c path
+     *
+     * @param[in] path the path of the file
+     */
+    explicit MappedFile ( const char *path ) : m_data ( 0L ), m_size ( 0u ) {
+
+        const int fd = ::open ( path, O_RDONLY );
+        struct stat st;
+
+        if ( fd != -1 && ::fstat ( fd, &st ) != -1 ) {
+
+            if ( ( m_size = static_cast<std::size_t> ( st.st_size ) ) ) {
+
+                void *m = ::mmap ( 0L, m_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+                if ( m != MAP_FAILED ) {
+#ifdef MADV_SEQUENTIAL
+                    ::madvise ( m, m_size, MADV_SEQUENTIAL );
+#endif
+                    m_data = static_cast<const char *> ( m );
+                } else {
+                    m_size = 0u;
+                }
+
+            } else {
+                m_data = "";
+            }
+        }
+
+        const int err = errno;
+
+        if ( fd != -1 ) ::close ( fd );
+
+        if ( !m_data ) {
+#ifdef __EXCEPTIONS
+            throw std::runtime_error ( std::string ( std::strerror ( err ) ).append ( ": " ).
+                                       append ( path ) );
+#else
+            ( void ) err;
+#endif
+        }
+    }
+
+    ~MappedFile() {
+        if ( m_data && m_size ) ::munmap ( const_cast<char *> ( m_data ), m_size );
+    }
+
+    /**
+     * @brief the begin of the mapped data
+     */
+    const char *data() const {
+        return m_data;
+    }
+
+    /**
+     * @brief the size of the mapped data
+     */
+    std::size_t size() const {
+        return m_size;
+    }
+
+private:
+    const char *m_data;
+    std::size_t m_size;
+};
+
+/**
+ * @ingroup bulk
+ * @brief Writes %Rationals one per line into a file
+ *
+ * The %Rationals are formatted into a buffer of @c bufsize bytes, which is written
+ * to the file descriptor only if it is full, on flush() and on destruction.
+ *
+ * If the file cannot be opened or written to, an @c std::runtime_error is thrown.
+ */
+class RationalWriter {
+
+    RATIONAL_NOCOPYASSIGN ( RationalWriter );
+
+public:
+    /**
+     * @brief creates (or truncates) the file @c path and writes to it
+     *
+     * @param[in] path the path of the file
+     * @param[in] bufsize the size of the output buffer
+     */
+    explicit RationalWriter ( const char *path, std::size_t bufsize = 1u << 20 )
+        : m_fd ( ::open ( path, O_WRONLY | O_CREAT | O_TRUNC, 0666 ) ), m_own ( true ),
+          m_buf ( bufsize < 128u ? 128u : bufsize ), m_pos ( 0u ) {
+#ifdef __EXCEPTIONS
+        if ( m_fd == -1 ) {
+            throw std::runtime_error ( std::string ( std::strerror ( errno ) ).append ( ": " ).
+                                       append ( path ) );
+        }
+#endif
+    }
+
+    /**
+     * @brief writes to an already opened file descriptor
+     *
+     * The file descriptor is not closed by the writer.
+     *
+     * @param[in] fd the file descriptor
+     * @param[in] bufsize the size of the output buffer
+     */
+    explicit RationalWriter ( int fd, std::size_t bufsize = 1u << 20 ) : m_fd ( fd ),
+        m_own ( false ), m_buf ( bufsize < 128u ? 128u : bufsize ), m_pos ( 0u ) {}
+
+    ~RationalWriter() {
+
+#ifdef __EXCEPTIONS
+        try {
+#endif
+            flush();
+#ifdef __EXCEPTIONS
+        } catch ( const std::runtime_error & ) {}
+
+#endif
+        if ( m_own && m_fd != -1 ) ::close ( m_fd );
+    }
+
+    /**
+     * @brief appends @c r and a newline
+     *
+     * @param[in] r the %Rational to write
+     *
+     * @return the writer itself
+     */
+    template<typename T, template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+             template<typename> class Alloc>
+    RationalWriter& write ( const Rational<T, GCD, CHKOP, Alloc>& r ) {
+
+        // keep room for the newline
+        char *e = m_pos < m_buf.size() ? to_chars ( &m_buf[0] + m_pos,
+                  &m_buf[0] + m_buf.size() - 1u, r ) : 0L;
+
+        if ( !e ) {
+
+            flush();
+
+            const std::size_t n = formatted_size ( r ) + 1u;
+
+            if ( n > m_buf.size() ) m_buf.resize ( n );
+
+            e = to_chars ( &m_buf[0], &m_buf[0] + m_buf.size() - 1u, r );
+        }
+
+        *e++ = '\n';
+        m_pos = static_cast<std::size_t> ( e - &m_buf[0] );
+
+        return *this;
+    }
+
+    /**
+     * @brief writes all %Rationals of @c [first, last)
+     *
+     * @tparam IIter input iterator type
+     *
+     * @param[in] first iterator pointing to the first %Rational
+     * @param[in] last iterator pointing past the last %Rational
+     *
+     * @return the writer itself
+     */
+    template<class IIter>
+    RationalWriter& write ( IIter first, IIter last ) {
+
+        while ( first != last ) write ( *first++ );
+
+        return *this;
+    }
+
+    /**
+     * @brief writes the buffered data to the file
+     */
+    void flush() {
+
+        const char *p = &m_buf[0];
+
+        while ( m_pos ) {
+
+            const ssize_t w = ::write ( m_fd, p, m_pos );
+
+            if ( w < 0 ) {
+
+                if ( errno == EINTR ) continue;
+
+                m_pos = 0u;
+#ifdef __EXCEPTIONS
+                throw std::runtime_error ( std::strerror ( errno ) );
+#else
+                break;
+#endif
+            }
+
+            p += w;
+            m_pos -= static_cast<std::size_t> ( w );
+        }
+    }
+
+private:
+    const int m_fd;
+    const bool m_own;
+    std::vector<char> m_buf;
+    std::size_t m_pos;
+};
+
+template<class R>
+struct _bulk_vector_sink {
+
+    typedef std::vector<R> chunk_type;
+
+    template<class A>
+    static void append ( std::vector<R, A>& out, chunk_type& c ) {
+        out.insert ( out.end(), c.begin(), c.end() );
+    }
+
+    static void push ( chunk_type& c, const R& r ) {
+        c.push_back ( r );
+    }
+};
+
+template<class R>
+struct _bulk_column_sink {
+
+    typedef std::pair<std::vector<typename R::integer_type>,
+            std::vector<typename R::integer_type> > chunk_type;
+
+    template<class A>
+    static void append ( std::pair<std::vector<typename R::integer_type, A> *,
+                         std::vector<typename R::integer_type, A> *>& out, chunk_type& c ) {
+        out.first->insert ( out.first->end(), c.first.begin(), c.first.end() );
+        out.second->insert ( out.second->end(), c.second.begin(), c.second.end() );
+    }
+
+    static void push ( chunk_type& c, const R& r ) {
+        c.first.push_back ( r.numerator() );
+        c.second.push_back ( r.denominator() );
+    }
+};
+
+template<class R, class Sink>
+void _bulk_parse_chunk ( const char *first, const char *last,
+                         typename Sink::chunk_type& out ) {
+
+    typename R::eval_state state;
+    R r;
+
+    while ( first != last ) {
+
+        const char *nl = static_cast<const char *> ( std::memchr ( first, '\n',
+                         static_cast<std::size_t> ( last - first ) ) );
+
+        if ( !nl ) nl = last;
+
+        const char *b = first, *e = nl;
+
+        while ( b != e && std::isspace ( static_cast<unsigned char> ( *b ) ) ) ++b;
+
+        while ( e != b && std::isspace ( static_cast<unsigned char> ( * ( e - 1 ) ) ) ) --e;
+
+        if ( b != e ) {
+
+            if ( from_chars ( b, e, r ) != e ) r = R::eval ( b, e, state );
+
+            Sink::push ( out, r );
+        }
+
+        first = nl != last ? nl + 1 : last;
+    }
+}
+
+template<class R, class Sink, class Out>
+void _bulk_parse ( const char *first, const char *last, Out& out, unsigned int threads ) {
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+
+    const std::size_t len = static_cast<std::size_t> ( last - first );
+
+    if ( threads > 1u && len > threads * 4096u ) {
+
+        std::vector<const char *> bounds ( 1u, first );
+
+        for ( unsigned int i = 1u; i < threads; ++i ) {
+
+            const char *p = std::max ( bounds.back(), first + len / threads * i );
+            const char *nl = static_cast<const char *> ( std::memchr ( p, '\n',
+                             static_cast<std::size_t> ( last - p ) ) );
+
+            bounds.push_back ( nl ? nl + 1 : last );
+        }
+
+        bounds.push_back ( last );
+
+        std::vector<typename Sink::chunk_type> chunks ( threads );
+
+        _parallel_run ( threads, [&bounds, &chunks] ( unsigned int i ) {
+            _bulk_parse_chunk<R, Sink> ( bounds[i], bounds[i + 1u], chunks[i] );
+        } );
+
+        for ( typename Sink::chunk_type &c : chunks ) Sink::append ( out, c );
+
+        return;
+    }
+#else
+    ( void ) threads;
+#endif
+
+    typename Sink::chunk_type c;
+
+    _bulk_parse_chunk<R, Sink> ( first, last, c );
+    Sink::append ( out, c );
+}
+
+/**
+ * @ingroup bulk
+ * @brief parses %Rationals stored one per line
+ *
+ * Empty lines are skipped, leading and trailing whitespace is ignored. Lines, which
+ * aren't plain integers or fractions are evaluated as @em expression. The %Rationals
+ * are appended to @c out in the order of the lines.
+ *
+ * @tparam R the Commons::Math::Rational type
+ *
+ * @param[in] first pointer to the begin of the text
+ * @param[in] last pointer to the end of the text
+ * @param[out] out the vector to append to
+ * @param[in] threads number of threads to parse with (needs @em C++11)
+ */
+template<class R, class A>
+void bulk_parse ( const char *first, const char *last, std::vector<R, A>& out,
+                  unsigned int threads = 1u ) {
+    _bulk_parse<R, _bulk_vector_sink<R> > ( first, last, out, threads );
+}
+
+/**
+ * @ingroup bulk
+ * @brief parses %Rationals stored one per line into a numerator and a denominator column
+ *
+ * @see bulk_parse()
+ *
+ * @tparam R the Commons::Math::Rational type
+ *
+ * @param[in] first pointer to the begin of the text
+ * @param[in] last pointer to the end of the text
+ * @param[out] numer the vector to append the numerators to
+ * @param[out] denom the vector to append the denominators to
+ * @param[in] threads number of threads to parse with (needs @em C++11)
+ */
+template<class R, class A>
+void bulk_parse_columns ( const char *first, const char *last,
+                          std::vector<typename R::integer_type, A>& numer,
+                          std::vector<typename R::integer_type, A>& denom,
+                          unsigned int threads = 1u ) {
+
+    std::pair<std::vector<typename R::integer_type, A> *,
+        std::vector<typename R::integer_type, A> *> out ( &numer, &denom );
+
+    _bulk_parse<R, _bulk_column_sink<R> > ( first, last, out, threads );
+}
+
+/**
+ * @ingroup bulk
+ * @brief reads a file of %Rationals stored one per line
+ *
+ * @see bulk_parse()
+ *
+ * @param[in] path the path of the file
+ * @param[out] out the vector to append to
+ * @param[in] threads number of threads to parse with (needs @em C++11)
+ */
+template<class R, class A>
+void bulk_read ( const char *path, std::vector<R, A>& out, unsigned int threads = 1u ) {
+
+    const MappedFile f ( path );
+
+    if ( f.data() ) bulk_parse ( f.data(), f.data() + f.size(), out, threads );
+}
+
+/**
+ * @ingroup bulk
+ * @brief reads a file of %Rationals stored one per line into a numerator and a
+ * denominator column
+ *
+ * @see bulk_parse_columns()
+ *
+ * @tparam R the Commons::Math::Rational type
+ *
+ * @param[in] path the path of the file
+ * @param[out] numer the vector to append the numerators to
+ * @param[out] denom the vector to append the denominators to
+ * @param[in] threads number of threads to parse with (needs @em C++11)
+ */
+template<class R, class A>
+void bulk_read_columns ( const char *path, std::vector<typename R::integer_type, A>& numer,
+                         std::vector<typename R::integer_type, A>& denom,
+                         unsigned int threads = 1u ) {
+
+    const MappedFile f ( path );
+
+    if ( f.data() ) bulk_parse_columns<R> ( f.data(), f.data() + f.size(), numer, denom,
+                                                threads );
+}
+
+/**
+ * @ingroup bulk
+ * @brief writes the %Rationals of @c [first, last) one per line to a file
+ *
+ * @see RationalWriter
+ *
+ * @param[in] path the path of the file
+ * @param[in] first iterator pointing to the first %Rational
+ * @param[in] last iterator pointing past the last %Rational
+ */
+template<class IIter>
+void bulk_write ( const char *path, IIter first, IIter last ) {
+    RationalWriter ( path ).write ( first, last ).flush();
+}
+
+}
+
+}
+
+#endif /* COMMONS_MATH_BULK_RATIONAL_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
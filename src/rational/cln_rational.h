@@ -133,6 +133,80 @@ template<> struct DecomposeBaseTraits<cln::cl_I, true> {
     enum { Base = 10 };
 };
 
+template<> struct HashTraits<cln::cl_I> {
+
+    // CLN's own hash code of the digits, without converting to a string
+    static std::size_t hash ( const cln::cl_I &x ) {
+        return static_cast<std::size_t> ( cln::equal_hashcode ( x ) );
+    }
+};
+
+template<> struct SerializeTraits<cln::cl_I> {
+
+    // a varint of the byte count and the sign, followed by the little endian magnitude
+    static std::size_t size ( const cln::cl_I &x ) {
+
+        const std::size_t n = ( cln::integer_length ( cln::abs ( x ) ) + 7u ) >> 3;
+
+        return SerializeTraits<std::size_t>::size ( n << 1 ) + n;
+    }
+
+    static unsigned char *write ( unsigned char *first, unsigned char *last,
+                                  const cln::cl_I &x ) {
+
+        const cln::cl_I &a ( cln::abs ( x ) );
+        const std::size_t n = ( cln::integer_length ( a ) + 7u ) >> 3;
+
+        if ( ! ( first = SerializeTraits<std::size_t>::write ( first, last,
+                         ( n << 1 ) | cln::minusp ( x ) ) ) ||
+                static_cast<std::size_t> ( last - first ) < n ) return 0L;
+
+        for ( std::size_t i = 0u; i < n; i += 4u ) {
+
+            const uint32_t w = cln::cl_I_to_UL ( cln::ldb ( a, cln::cl_byte ( 32, i << 3 ) ) );
+
+            for ( std::size_t j = 0u; j < 4u && i + j < n; ++j ) {
+                * ( first++ ) = static_cast<unsigned char> ( w >> ( j << 3 ) );
+            }
+        }
+
+        return first;
+    }
+
+    static const unsigned char *read ( const unsigned char *first, const unsigned char *last,
+                                       cln::cl_I &x, bool *more = 0L ) {
+
+        std::size_t h;
+
+        if ( ! ( first = SerializeTraits<std::size_t>::read ( first, last, h, more ) ) ) return 0L;
+
+        if ( static_cast<std::size_t> ( last - first ) < ( h >> 1 ) ) {
+            if ( more ) *more = true;
+            return 0L;
+        }
+
+        const std::size_t n = h >> 1;
+        cln::cl_I a ( 0 );
+
+        for ( std::size_t i = ( n + 3u ) & ~std::size_t ( 3u ); i; ) {
+
+            uint32_t w = 0u;
+
+            i -= 4u;
+
+            for ( std::size_t j = 4u; j--; ) {
+                w = ( w << 8 ) | ( i + j < n ? first[i + j] : 0u );
+            }
+
+            a = cln::ash ( a, 32 ) + cln::UL_to_I ( w );
+        }
+
+        x = h & 1 ? cln::cl_I ( -a ) : a;
+
+        return first + n;
+    }
+};
+
 template<> struct _type_round_helper<cln::cl_I> {
     cln::cl_I operator() ( const cln::cl_I &tr ) const {
         return tr;
@@ -29,7 +29,24 @@
  *
  * @b Caveats: With @em C++03 it is @b not possible to store expressions, but
  *     only to use them directly where expressions are expected as parameters.\n
- *     With @em C++11 you can use the keyword @c auto to store expressions
+ *     With @em C++11 you can use the keyword @c auto to store expressions. A stored
+ *     expression refers to the %Rational @em lvalues it was built from, which therefore must
+ *     outlive it, while temporary operands and subexpressions are moved into it.
+ *
+ * Operands given as %Rational @em lvalues are captured by reference, thus building an
+ * expression does not copy any (big integer) constant.
+ *
+ * Chains of additions and subtractions (for signed storage types) as well as chains of
+ * multiplications are evaluated as a whole: the terms are accumulated over their least common
+ * denominator and the result gets reduced only once, the factors get cancelled crosswise
+ * against the running product like in Rational::operator*=(). For bounded storage types a sum
+ * chain may overflow where the evaluation term by term wouldn't, as its denominator grows to
+ * the least common multiple of all the terms' denominators.
+ *
+ * Expressions of literals only (created by mk_rat_lit()) are folded into a single literal
+ * when they are built. The products @c x*x and the sums @c x+x of a variable or placeholder
+ * with itself are rewritten to a square and a doubling without any gcd calculation, and
+ * @c inv(inv(x)) is rewritten to @c x.
  *
  * @b Example: \n To approximate the integral @f$\int_a^b \! \frac{x}{1+x}@f$
  * by evaluating the expression @f$\frac{x}{1+x}@f$ for a specified number of
@@ -69,6 +86,8 @@
 #ifndef COMMONS_MATH_EXPR_RATIONAL_H
 #define COMMONS_MATH_EXPR_RATIONAL_H
 
+#include <iterator>
+
 #include "rational.h"
 
 namespace Commons {
@@ -103,25 +122,54 @@ template<class ExprT> struct RationalExpressionTraits {
 
 template<class T>
 struct RationalExprTypeTraits {
-    typedef const T type;
+    typedef T type;
+    typedef T &reference;
+    typedef const T &const_reference;
 };
 
+template<class R, class E> struct _rat_expr_sum;
+template<class R, class E> struct _rat_expr_product;
+struct _rat_expr_access;
+
+template<class R>
+struct _rat_expr_args {
+    const R *v[4];
+    R s[4];
+};
+
+template<class R> RATIONAL_CONSTEXPR
+const R &_rat_expr_arg ( const R &v, std::size_t ) RATIONAL_NOEXCEPT {
+    return v;
+}
+
+template<class R> RATIONAL_CONSTEXPR
+const R &_rat_expr_arg ( const _rat_expr_args<R> &a, std::size_t n ) RATIONAL_NOEXCEPT {
+    return *a.v[n];
+}
+
 template<class T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
 struct RationalVariable {
 
     typedef Rational<T, GCD, CHKOP> result_type;
 
-    RATIONAL_CONSTEXPR const result_type &operator() ( const Rational<T, GCD, CHKOP> &v ) const
-    RATIONAL_NOEXCEPT {
-        return v;
+    template<class Arg>
+    RATIONAL_CONSTEXPR const result_type &operator() ( const Arg &v ) const RATIONAL_NOEXCEPT {
+        return _rat_expr_arg ( v, 0u );
     }
 };
 
 template<class T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
-struct RationalExprTypeTraits<RationalVariable<T, GCD, CHKOP> > {
-    typedef const RationalVariable<T, GCD, CHKOP> &type;
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         std::size_t N>
+struct RationalPlaceholder {
+
+    typedef Rational<T, GCD, CHKOP> result_type;
+
+    template<class Arg>
+    RATIONAL_CONSTEXPR const result_type &operator() ( const Arg &v ) const RATIONAL_NOEXCEPT {
+        return _rat_expr_arg ( v, N - 1u );
+    }
 };
 
 template<class T, template<typename, bool, template<class, typename, bool> class,
@@ -142,13 +190,48 @@ struct RationalConstant {
         : c_ ( std::move ( o.c_ ) ) {}
 #endif
 
-    RATIONAL_CONSTEXPR const result_type &
-    operator() ( const Rational<T, GCD, CHKOP> & ) const RATIONAL_NOEXCEPT {
+    template<class Arg>
+    RATIONAL_CONSTEXPR const result_type &operator() ( const Arg & ) const RATIONAL_NOEXCEPT {
         return c_;
     }
 
 private:
-    const typename RationalExprTypeTraits<Rational<T, GCD, CHKOP> >::type c_;
+    typename RationalExprTypeTraits<Rational<T, GCD, CHKOP> >::type c_;
+};
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+struct RationalReference {
+
+    typedef Rational<T, GCD, CHKOP> result_type;
+
+    RATIONAL_CONSTEXPR explicit RationalReference ( const Rational<T, GCD, CHKOP> &c ) : c_ ( c ) {}
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    explicit RationalReference ( Rational<T, GCD, CHKOP> && ) = delete;
+#endif
+
+    template<class Arg>
+    RATIONAL_CONSTEXPR const result_type &operator() ( const Arg & ) const RATIONAL_NOEXCEPT {
+        return c_;
+    }
+
+private:
+    const Rational<T, GCD, CHKOP> &c_;
+};
+
+template<class OP, class E>
+struct _rat_expr_chain {
+    static const bool value = false;
+};
+
+template<class OP, bool Chain>
+struct _rat_expr_eval {
+
+    template<class L, class H, class Arg>
+    inline static typename OP::result_type eval ( const L &l, const H &h, const Arg &d ) {
+        return OP() ( l ( d ), h ( d ) );
+    }
 };
 
 template<class T, class L, class H, class OP, template<typename, bool,
@@ -167,18 +250,28 @@ struct RationalBinaryExpression {
 #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
     RATIONAL_CONSTEXPR RationalBinaryExpression ( L &&l, H &&h );
 
+    RATIONAL_CONSTEXPR RationalBinaryExpression ( L &&l, const H &h )
+        : l_ ( std::move ( l ) ), h_ ( h ) {}
+
+    RATIONAL_CONSTEXPR RationalBinaryExpression ( const L &l, H &&h )
+        : l_ ( l ), h_ ( std::move ( h ) ) {}
+
     RATIONAL_CONSTEXPR RationalBinaryExpression ( RationalBinaryExpression &&o )
         : l_ ( std::move ( o.l_ ) ), h_ ( std::move ( o.h_ ) ) {}
 #endif
 
     ~RationalBinaryExpression();
 
-    RATIONAL_CONSTEXPR result_type operator() ( const Rational<T, GCD, CHKOP> &d ) const;
+    template<class Arg>
+    RATIONAL_CONSTEXPR result_type operator() ( const Arg &d ) const;
 
 private:
-    const typename RationalExprTypeTraits<typename
+    template<class, class> friend struct _rat_expr_sum;
+    template<class, class> friend struct _rat_expr_product;
+
+    typename RationalExprTypeTraits<typename
     RationalExpressionTraits<L>::literal_type>::type l_;
-    const typename RationalExprTypeTraits<typename
+    typename RationalExprTypeTraits<typename
     RationalExpressionTraits<H>::literal_type>::type h_;
 };
 
@@ -203,11 +296,12 @@ RationalBinaryExpression<T, L, H, OP, GCD, CHKOP>::~RationalBinaryExpression() {
 
 template<class T, class L, class H, class OP, template<typename, bool,
          template<class, typename, bool> class, template<typename> class> class GCD,
-         template<class, typename, bool> class CHKOP>
+         template<class, typename, bool> class CHKOP> template<class Arg>
 RATIONAL_CONSTEXPR typename RationalBinaryExpression<T, L, H, OP, GCD, CHKOP>::result_type
-RationalBinaryExpression<T, L, H, OP, GCD, CHKOP>::operator()
-( const Rational<T, GCD, CHKOP> &d ) const {
-    return OP() ( l_ ( d ), h_ ( d ) );
+RationalBinaryExpression<T, L, H, OP, GCD, CHKOP>::operator() ( const Arg &d ) const {
+    return _rat_expr_eval<OP, _rat_expr_chain<OP, typename
+           RationalExpressionTraits<L>::literal_type>::value || _rat_expr_chain<OP, typename
+           RationalExpressionTraits<H>::literal_type>::value>::eval ( l_, h_, d );
 }
 
 template<class T, class L, class OP, template<typename, bool,
@@ -232,12 +326,15 @@ struct RationalUnaryExpression {
 
     ~RationalUnaryExpression() {}
 
-    RATIONAL_CONSTEXPR result_type operator() ( const Rational<T, GCD, CHKOP> &d ) const {
+    template<class Arg>
+    RATIONAL_CONSTEXPR result_type operator() ( const Arg &d ) const {
         return OP() ( l_ ( d ) );
     }
 
 private:
-    const typename RationalExprTypeTraits<typename
+    friend struct _rat_expr_access;
+
+    typename RationalExprTypeTraits<typename
     RationalExpressionTraits<L>::literal_type>::type l_;
 };
 
@@ -253,12 +350,17 @@ struct RationalExpression {
     RATIONAL_CONSTEXPR explicit RationalExpression ( E &&e ) : expr_ ( std::move ( e ) ) {}
 #endif
 
-    RATIONAL_CONSTEXPR result_type operator() ( const Rational<T, GCD, CHKOP> &d ) const {
+    template<class Arg>
+    RATIONAL_CONSTEXPR result_type operator() ( const Arg &d ) const {
         return expr_ ( d );
     }
 
 private:
-    const typename RationalExprTypeTraits<E>::type expr_;
+    template<class, class> friend struct _rat_expr_sum;
+    template<class, class> friend struct _rat_expr_product;
+    friend struct _rat_expr_access;
+
+    typename RationalExprTypeTraits<E>::type expr_;
 };
 
 template<class T, class E, template<typename, bool, template<class, typename, bool> class,
@@ -271,6 +373,8 @@ template<class T, class E, template<typename, bool,
          template<class, typename, bool> class CHKOP>
 struct RationalExprTypeTraits<RationalExpression<T, E, GCD, CHKOP> > {
     typedef const RationalExpression<T, E, GCD, CHKOP> &type;
+    typedef type reference;
+    typedef type const_reference;
 };
 
 template<class T, template<typename, bool, template<class, typename, bool> class,
@@ -281,6 +385,325 @@ struct RationalExpressionTraits<Rational<T, GCD, CHKOP> > {
     typedef RationalExpression<T, RationalVariable<T, GCD, CHKOP>, GCD, CHKOP> variable_type;
 };
 
+template<class T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+void _rat_expr_sum_term ( const Rational<T, GCD, CHKOP> &v, T &n, T &q, bool neg ) {
+
+    typedef Rational<T, GCD, CHKOP> rat;
+
+    if ( q == v.denominator() ) {
+
+        if ( neg ) {
+            n = typename rat::op_minus() ( n, v.numerator() );
+        } else {
+            n = typename rat::op_plus() ( n, v.numerator() );
+        }
+
+        return;
+    }
+
+    const T g ( GCD<T, std::numeric_limits<T>::is_signed, CHKOP, TYPE_CONVERT>()
+                ( q, v.denominator() ) );
+    const T a ( g == rat::one_ ? v.denominator() :
+                T ( typename rat::op_divides() ( v.denominator(), g ) ) );
+    const T b ( typename rat::op_multiplies() ( v.numerator(), g == rat::one_ ? q :
+                T ( typename rat::op_divides() ( q, g ) ) ) );
+
+    if ( neg ) {
+        n = typename rat::op_minus() ( typename rat::op_multiplies() ( n, a ), b );
+    } else {
+        n = typename rat::op_plus() ( typename rat::op_multiplies() ( n, a ), b );
+    }
+
+    q = typename rat::op_multiplies() ( q, a );
+}
+
+template<class R, class E>
+struct _rat_expr_sum {
+
+    static const bool chain = false;
+
+    template<class Arg> inline static void add ( const E &e, const Arg &d,
+            typename R::integer_type &n, typename R::integer_type &q, bool neg ) {
+        _rat_expr_sum_term ( static_cast<const R &> ( e ( d ) ), n, q, neg );
+    }
+};
+
+template<class R, class T, class E, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP>
+struct _rat_expr_sum<R, RationalExpression<T, E, GCD, CHKOP> > {
+
+    static const bool chain = _rat_expr_sum<R, E>::chain;
+
+    template<class Arg> inline static void add ( const RationalExpression<T, E, GCD, CHKOP> &e,
+            const Arg &d, typename R::integer_type &n, typename R::integer_type &q, bool neg ) {
+        _rat_expr_sum<R, E>::add ( e.expr_, d, n, q, neg );
+    }
+};
+
+template<class T, class L, class H, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP>
+struct _rat_expr_sum<Rational<T, GCD, CHKOP>, RationalBinaryExpression<T, L, H,
+        std::plus<Rational<T, GCD, CHKOP> >, GCD, CHKOP> > {
+
+    static const bool chain = true;
+
+    template<class Arg> inline static void add ( const RationalBinaryExpression<T, L, H,
+            std::plus<Rational<T, GCD, CHKOP> >, GCD, CHKOP> &e, const Arg &d, T &n, T &q,
+            bool neg ) {
+        _rat_expr_sum<Rational<T, GCD, CHKOP>, typename
+        RationalExpressionTraits<L>::literal_type>::add ( e.l_, d, n, q, neg );
+        _rat_expr_sum<Rational<T, GCD, CHKOP>, typename
+        RationalExpressionTraits<H>::literal_type>::add ( e.h_, d, n, q, neg );
+    }
+};
+
+template<class T, class L, class H, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP>
+struct _rat_expr_sum<Rational<T, GCD, CHKOP>, RationalBinaryExpression<T, L, H,
+        std::minus<Rational<T, GCD, CHKOP> >, GCD, CHKOP> > {
+
+    static const bool chain = true;
+
+    template<class Arg> inline static void add ( const RationalBinaryExpression<T, L, H,
+            std::minus<Rational<T, GCD, CHKOP> >, GCD, CHKOP> &e, const Arg &d, T &n, T &q,
+            bool neg ) {
+        _rat_expr_sum<Rational<T, GCD, CHKOP>, typename
+        RationalExpressionTraits<L>::literal_type>::add ( e.l_, d, n, q, neg );
+        _rat_expr_sum<Rational<T, GCD, CHKOP>, typename
+        RationalExpressionTraits<H>::literal_type>::add ( e.h_, d, n, q, !neg );
+    }
+};
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+void _rat_expr_product_term ( const Rational<T, GCD, CHKOP> &v, T &n, T &q ) {
+
+    typedef Rational<T, GCD, CHKOP> rat;
+
+    // n/q stays reduced, so the product doesn't grow beyond its value
+    const T g1 ( GCD<T, std::numeric_limits<T>::is_signed, CHKOP, TYPE_CONVERT>()
+                 ( v.numerator(), q ) );
+    const T g2 ( GCD<T, std::numeric_limits<T>::is_signed, CHKOP, TYPE_CONVERT>()
+                 ( n, v.denominator() ) );
+
+    if ( g1 == rat::one_ && g2 == rat::one_ ) {
+        n = typename rat::op_multiplies() ( n, v.numerator() );
+        q = typename rat::op_multiplies() ( q, v.denominator() );
+    } else {
+        n = typename rat::op_multiplies() ( typename rat::op_divides() ( n, g2 ),
+                                            typename rat::op_divides() ( v.numerator(), g1 ) );
+        q = typename rat::op_multiplies() ( typename rat::op_divides() ( q, g1 ),
+                                            typename rat::op_divides() ( v.denominator(), g2 ) );
+    }
+}
+
+template<class R, class E>
+struct _rat_expr_product {
+
+    static const bool chain = false;
+
+    template<class Arg> inline static void mul ( const E &e, const Arg &d,
+            typename R::integer_type &n, typename R::integer_type &q ) {
+        _rat_expr_product_term ( static_cast<const R &> ( e ( d ) ), n, q );
+    }
+};
+
+template<class R, class T, class E, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP>
+struct _rat_expr_product<R, RationalExpression<T, E, GCD, CHKOP> > {
+
+    static const bool chain = _rat_expr_product<R, E>::chain;
+
+    template<class Arg> inline static void mul ( const RationalExpression<T, E, GCD, CHKOP> &e,
+            const Arg &d, typename R::integer_type &n, typename R::integer_type &q ) {
+        _rat_expr_product<R, E>::mul ( e.expr_, d, n, q );
+    }
+};
+
+template<class T, class L, class H, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP>
+struct _rat_expr_product<Rational<T, GCD, CHKOP>, RationalBinaryExpression<T, L, H,
+        std::multiplies<Rational<T, GCD, CHKOP> >, GCD, CHKOP> > {
+
+    static const bool chain = true;
+
+    template<class Arg> inline static void mul ( const RationalBinaryExpression<T, L, H,
+            std::multiplies<Rational<T, GCD, CHKOP> >, GCD, CHKOP> &e, const Arg &d, T &n,
+            T &q ) {
+        _rat_expr_product<Rational<T, GCD, CHKOP>, typename
+        RationalExpressionTraits<L>::literal_type>::mul ( e.l_, d, n, q );
+        _rat_expr_product<Rational<T, GCD, CHKOP>, typename
+        RationalExpressionTraits<H>::literal_type>::mul ( e.h_, d, n, q );
+    }
+};
+
+template<class T, class E, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+struct _rat_expr_chain<std::plus<Rational<T, GCD, CHKOP> >, E> {
+    static const bool value = std::numeric_limits<T>::is_signed &&
+                              _rat_expr_sum<Rational<T, GCD, CHKOP>, E>::chain;
+};
+
+template<class T, class E, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+struct _rat_expr_chain<std::minus<Rational<T, GCD, CHKOP> >, E> {
+    static const bool value = std::numeric_limits<T>::is_signed &&
+                              _rat_expr_sum<Rational<T, GCD, CHKOP>, E>::chain;
+};
+
+template<class T, class E, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+struct _rat_expr_chain<std::multiplies<Rational<T, GCD, CHKOP> >, E> {
+    static const bool value = _rat_expr_product<Rational<T, GCD, CHKOP>, E>::chain;
+};
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+struct _rat_expr_eval<std::plus<Rational<T, GCD, CHKOP> >, true> {
+
+    template<class L, class H, class Arg>
+    static Rational<T, GCD, CHKOP> eval ( const L &l, const H &h, const Arg &d ) {
+
+        T n ( Rational<T, GCD, CHKOP>::zero_ ), q ( Rational<T, GCD, CHKOP>::one_ );
+
+        _rat_expr_sum<Rational<T, GCD, CHKOP>, L>::add ( l, d, n, q, false );
+        _rat_expr_sum<Rational<T, GCD, CHKOP>, H>::add ( h, d, n, q, false );
+
+        return Rational<T, GCD, CHKOP> ( n, q );
+    }
+};
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+struct _rat_expr_eval<std::minus<Rational<T, GCD, CHKOP> >, true> {
+
+    template<class L, class H, class Arg>
+    static Rational<T, GCD, CHKOP> eval ( const L &l, const H &h, const Arg &d ) {
+
+        T n ( Rational<T, GCD, CHKOP>::zero_ ), q ( Rational<T, GCD, CHKOP>::one_ );
+
+        _rat_expr_sum<Rational<T, GCD, CHKOP>, L>::add ( l, d, n, q, false );
+        _rat_expr_sum<Rational<T, GCD, CHKOP>, H>::add ( h, d, n, q, true );
+
+        return Rational<T, GCD, CHKOP> ( n, q );
+    }
+};
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+struct _rat_expr_eval<std::multiplies<Rational<T, GCD, CHKOP> >, true> {
+
+    template<class L, class H, class Arg>
+    static Rational<T, GCD, CHKOP> eval ( const L &l, const H &h, const Arg &d ) {
+
+        T n ( Rational<T, GCD, CHKOP>::one_ ), q ( Rational<T, GCD, CHKOP>::one_ );
+
+        _rat_expr_product<Rational<T, GCD, CHKOP>, L>::mul ( l, d, n, q );
+        _rat_expr_product<Rational<T, GCD, CHKOP>, H>::mul ( h, d, n, q );
+
+        return Rational<T, GCD, CHKOP> ( n, q );
+    }
+};
+
+struct _rat_expr_access {
+
+    template<class T, class E, template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+    inline static typename RationalExprTypeTraits<E>::reference
+    expr ( RationalExpression<T, E, GCD, CHKOP> &e ) RATIONAL_NOEXCEPT {
+        return e.expr_;
+    }
+
+    template<class T, class E, template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+    inline static typename RationalExprTypeTraits<E>::const_reference
+    expr ( const RationalExpression<T, E, GCD, CHKOP> &e ) RATIONAL_NOEXCEPT {
+        return e.expr_;
+    }
+
+    template<class T, class L, class OP, template<typename, bool,
+             template<class, typename, bool> class, template<typename> class> class GCD,
+             template<class, typename, bool> class CHKOP>
+    inline static typename RationalExprTypeTraits<typename
+    RationalExpressionTraits<L>::literal_type>::reference
+    operand ( RationalUnaryExpression<T, L, OP, GCD, CHKOP> &e ) RATIONAL_NOEXCEPT {
+        return e.l_;
+    }
+
+    template<class T, class L, class OP, template<typename, bool,
+             template<class, typename, bool> class, template<typename> class> class GCD,
+             template<class, typename, bool> class CHKOP>
+    inline static typename RationalExprTypeTraits<typename
+    RationalExpressionTraits<L>::literal_type>::const_reference
+    operand ( const RationalUnaryExpression<T, L, OP, GCD, CHKOP> &e ) RATIONAL_NOEXCEPT {
+        return e.l_;
+    }
+};
+
+/**
+ * @ingroup expr
+ * @brief Indexed placeholder variables for expressions
+ *
+ * The placeholders @c _1 to @c _4 stand for the values of the first to the fourth range given
+ * to evaluate(). Evaluated by eval_rat_expr(), all of them get the same value.
+ *
+ * @b Example: \n to calculate @f$ \frac{1}{2}x + \frac{1}{3}y @f$ for the columns @c x and
+ * @c y: @code{.cpp}
+ * typedef Commons::Math::RationalPlaceholders<Commons::Math::gmp_rational> P;
+ *
+ * Commons::Math::evaluate ( Commons::Math::gmp_rational ( 1, 2 ) * P::_1 +
+ *                           Commons::Math::gmp_rational ( 1, 3 ) * P::_2,
+ *                           std::back_inserter ( z ), x.begin(), x.end(), y.begin() );@endcode
+ *
+ * @see Commons::Math::evaluate()
+ *
+ * @tparam R the Commons::Math::Rational type
+ */
+template<class R> struct RationalPlaceholders;
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+struct RationalPlaceholders<Rational<T, GCD, CHKOP> > {
+
+    /**
+     * @brief the type of the placeholder of the @c N-th argument
+     */
+    template<std::size_t N> struct arg {
+        typedef RationalExpression<T, RationalPlaceholder<T, GCD, CHKOP, N>, GCD, CHKOP> type;
+    };
+
+    static const typename arg<1u>::type _1; ///< the first argument
+    static const typename arg<2u>::type _2; ///< the second argument
+    static const typename arg<3u>::type _3; ///< the third argument
+    static const typename arg<4u>::type _4; ///< the fourth argument
+};
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+const typename RationalPlaceholders<Rational<T, GCD, CHKOP> >::template arg<1u>::type
+RationalPlaceholders<Rational<T, GCD, CHKOP> >::_1 ( ( RationalPlaceholder<T, GCD, CHKOP, 1u>() ) );
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+const typename RationalPlaceholders<Rational<T, GCD, CHKOP> >::template arg<2u>::type
+RationalPlaceholders<Rational<T, GCD, CHKOP> >::_2 ( ( RationalPlaceholder<T, GCD, CHKOP, 2u>() ) );
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+const typename RationalPlaceholders<Rational<T, GCD, CHKOP> >::template arg<3u>::type
+RationalPlaceholders<Rational<T, GCD, CHKOP> >::_3 ( ( RationalPlaceholder<T, GCD, CHKOP, 3u>() ) );
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+const typename RationalPlaceholders<Rational<T, GCD, CHKOP> >::template arg<4u>::type
+RationalPlaceholders<Rational<T, GCD, CHKOP> >::_4 ( ( RationalPlaceholder<T, GCD, CHKOP, 4u>() ) );
+
 /**
  * @ingroup expr
  * @brief make a literal for use in expressions
@@ -304,6 +727,20 @@ mk_rat_lit ( const Rational<T, GCD, CHKOP> &r ) {
            ( ( RationalConstant<T, GCD, CHKOP> ( r ) ) );
 }
 
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+/**
+ * @ingroup expr
+ * @overload
+ */
+template<class T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR RationalExpression<T, RationalConstant<T, GCD, CHKOP>, GCD, CHKOP>
+mk_rat_lit ( Rational<T, GCD, CHKOP> &&r ) {
+    return RationalExpression<T, RationalConstant<T, GCD, CHKOP>, GCD, CHKOP>
+           ( ( RationalConstant<T, GCD, CHKOP> ( std::move ( r ) ) ) );
+}
+#endif
+
 /**
  * @ingroup expr
  * @brief make a variable from a prototype
@@ -370,97 +807,366 @@ RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP> eval_rat_expr ( const Rational<T, GCD
            ( r ).operator() ( val );
 }
 
-template<class T> struct _unaryPlus {
-
-    typedef T result_type;
+struct _rat_expr_nocol {};
 
-    RATIONAL_CONSTEXPR result_type operator() ( const T &d ) const RATIONAL_NOEXCEPT {
-        return d;
-    }
+template<class IIter, class Ret, bool = std::numeric_limits<IIter>::is_specialized>
+struct _rat_expr_iter {
+    typedef Ret type;
 };
 
-template<class T> struct _unaryAbs {
+template<class IIter, class Ret>
+struct _rat_expr_iter<IIter, Ret, true> {};
 
-    typedef T result_type;
+template<class R, class Ref>
+struct _rat_expr_ref {
 
-    RATIONAL_CONSTEXPR result_type operator() ( const T &d ) const {
-        return d.abs();
+    // *i isn't a R lvalue (i.e. a column of integers or a proxy), so it gets copied
+    template<class IIter>
+    inline static const R *bind ( R &s, const IIter &i ) {
+        return & ( s = static_cast<R> ( *i ) );
     }
 };
 
-template<class T> struct _unaryInv {
-
-    typedef T result_type;
+template<class R>
+struct _rat_expr_ref<R, R &> {
 
-    RATIONAL_CONSTEXPR result_type operator() ( const T &d ) const {
-        return d.inverse();
+    template<class IIter>
+    inline static const R *bind ( R &, const IIter &i ) {
+        return & ( *i );
     }
 };
 
-template<class T> struct _unarySqrt {
-
-    typedef T result_type;
+template<class R>
+struct _rat_expr_ref<R, const R &> {
 
-    RATIONAL_CONSTEXPR result_type operator() ( const T &d ) const {
-        return d.sqrt();
+    template<class IIter>
+    inline static const R *bind ( R &, const IIter &i ) {
+        return & ( *i );
     }
 };
 
+template<class R, class IIter>
+inline void _rat_expr_bind ( _rat_expr_args<R> &a, std::size_t n, const IIter &i ) {
+    a.v[n] = _rat_expr_ref<R, typename std::iterator_traits<IIter>::reference>::bind ( a.s[n],
+             i );
 }
 
+template<class R>
+inline void _rat_expr_bind ( _rat_expr_args<R> &a, std::size_t n, const _rat_expr_nocol & ) {
+    a.v[n] = a.v[0];
 }
 
-template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
-RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
-                   Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
-                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
-                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
-                   operator+ ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
-const Commons::Math::Rational<B, GCD, CHKOP> &b ) {
-    typedef Commons::Math::RationalBinaryExpression<T,
-            Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
-            Commons::Math::RationalConstant<B, GCD, CHKOP>,
-            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
-    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT ( a,
-            Commons::Math::RationalConstant<B, GCD, CHKOP> ( b ) ) );
+template<class IIter>
+inline void _rat_expr_advance ( IIter &i, std::size_t n ) {
+    std::advance ( i, n );
 }
 
-template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
-template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
-RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
-                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
-                   Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
-                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
-                   operator+ ( const Commons::Math::Rational<A, GCD, CHKOP> &a,
-const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
-    typedef Commons::Math::RationalBinaryExpression<T,
-            Commons::Math::RationalConstant<A, GCD, CHKOP>,
-            Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
-            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
-    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
-                Commons::Math::RationalConstant<A, GCD, CHKOP> ( a ), b ) );
-}
+inline void _rat_expr_advance ( _rat_expr_nocol &, std::size_t ) {}
 
-template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
-template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
-RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
-                   Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
-                   Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
-                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
-                   operator+ ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
-const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
-    typedef Commons::Math::RationalBinaryExpression<T,
-            Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
-            Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
-            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
-    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT ( a, b ) );
+template<class ExprT, class OIter, class I1, class I2, class I3, class I4>
+OIter _rat_evaluate ( const ExprT &expr, OIter out, I1 first, I1 last, I2 i2, I3 i3, I4 i4 ) {
+
+    _rat_expr_args<typename ExprT::result_type> a;
+
+    for ( ; first != last; ++first ) {
+
+        _rat_expr_bind ( a, 0u, first );
+        _rat_expr_bind ( a, 1u, i2 );
+        _rat_expr_bind ( a, 2u, i3 );
+        _rat_expr_bind ( a, 3u, i4 );
+
+        * ( out++ ) = expr ( a );
+
+        _rat_expr_advance ( i2, 1u );
+        _rat_expr_advance ( i3, 1u );
+        _rat_expr_advance ( i4, 1u );
+    }
+
+    return out;
 }
 
-template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
-template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
-RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
-                   Commons::Math::Rational<T, GCD, CHKOP>,
+template<class ExprT, class OIter, class I1, class I2, class I3, class I4>
+OIter _rat_evaluate ( const ExprT &expr, OIter out, I1 first, I1 last, I2 i2, I3 i3, I4 i4,
+                      unsigned int threads ) {
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    typedef typename ExprT::result_type rat;
+
+    const std::size_t n = threads > 1u ? std::distance ( first, last ) : 0u;
+
+    if ( n > threads ) {
+
+        const std::size_t chunk = ( n + threads - 1u ) / threads;
+
+        std::vector<std::vector<rat> > parts ( threads );
+        std::vector<I1> b1 ( 1u, first );
+        std::vector<I2> b2 ( 1u, i2 );
+        std::vector<I3> b3 ( 1u, i3 );
+        std::vector<I4> b4 ( 1u, i4 );
+
+        for ( std::size_t b = chunk; b < n; b += chunk ) {
+
+            _rat_expr_advance ( first, chunk );
+            _rat_expr_advance ( i2, chunk );
+            _rat_expr_advance ( i3, chunk );
+            _rat_expr_advance ( i4, chunk );
+
+            b1.push_back ( first );
+            b2.push_back ( i2 );
+            b3.push_back ( i3 );
+            b4.push_back ( i4 );
+        }
+
+        b1.push_back ( last );
+
+        const unsigned int k = static_cast<unsigned int> ( b2.size() );
+
+        _parallel_run ( k, [&expr, &parts, &b1, &b2, &b3, &b4, chunk] ( unsigned int i ) {
+            parts[i].reserve ( chunk );
+            _rat_evaluate ( expr, std::back_inserter ( parts[i] ), b1[i], b1[i + 1u], b2[i], b3[i],
+                            b4[i] );
+        } );
+
+        for ( const std::vector<rat> &p : parts ) out = std::copy ( p.begin(), p.end(), out );
+
+        return out;
+    }
+#else
+    ( void ) threads;
+#endif
+
+    return _rat_evaluate ( expr, out, first, last, i2, i3, i4 );
+}
+
+/**
+ * @ingroup expr
+ * @brief evaluates an expression element-wise over a range
+ *
+ * The expression gets evaluated for every value of the range, which is assigned to all
+ * variables and placeholders of the expression.
+ *
+ * If @c threads is greater than @c 1 and C++11 is available, the range gets split into
+ * @c threads chunks, which are evaluated in parallel and written in order. In this case
+ * forward iterators are needed.
+ *
+ * @see Commons::Math::RationalPlaceholders
+ *
+ * @tparam ExprT the expression template type
+ * @tparam OIter the output iterator type
+ * @tparam IIter1 the input iterator type
+ *
+ * @param[in] expr the expression to evaluate
+ * @param[out] out iterator to output the results to
+ * @param[in] first1 iterator pointing to the first value of @c _1
+ * @param[in] last1 iterator pointing past the last value of @c _1
+ * @param[in] threads the maximum amount of threads to use
+ *
+ * @return iterator pointing to the end of @c out
+ */
+template<class ExprT, class OIter, class IIter1>
+OIter evaluate ( const ExprT &expr, OIter out, IIter1 first1, IIter1 last1,
+                 unsigned int threads = 1u ) {
+    return _rat_evaluate ( expr, out, first1, last1, _rat_expr_nocol(), _rat_expr_nocol(),
+                           _rat_expr_nocol(), threads );
+}
+
+/**
+ * @ingroup expr
+ * @brief evaluates an expression element-wise over two ranges
+ *
+ * @see evaluate(const ExprT &, OIter, IIter1, IIter1, unsigned int)
+ *
+ * @param[in] expr the expression to evaluate
+ * @param[out] out iterator to output the results to
+ * @param[in] first1 iterator pointing to the first value of @c _1
+ * @param[in] last1 iterator pointing past the last value of @c _1
+ * @param[in] first2 iterator pointing to the first value of @c _2
+ * @param[in] threads the maximum amount of threads to use
+ *
+ * @return iterator pointing to the end of @c out
+ */
+template<class ExprT, class OIter, class IIter1, class IIter2>
+typename _rat_expr_iter<IIter2, OIter>::type
+evaluate ( const ExprT &expr, OIter out, IIter1 first1, IIter1 last1, IIter2 first2,
+           unsigned int threads = 1u ) {
+    return _rat_evaluate ( expr, out, first1, last1, first2, _rat_expr_nocol(),
+                           _rat_expr_nocol(), threads );
+}
+
+/**
+ * @ingroup expr
+ * @brief evaluates an expression element-wise over three ranges
+ *
+ * @see evaluate(const ExprT &, OIter, IIter1, IIter1, unsigned int)
+ *
+ * @param[in] expr the expression to evaluate
+ * @param[out] out iterator to output the results to
+ * @param[in] first1 iterator pointing to the first value of @c _1
+ * @param[in] last1 iterator pointing past the last value of @c _1
+ * @param[in] first2 iterator pointing to the first value of @c _2
+ * @param[in] first3 iterator pointing to the first value of @c _3
+ * @param[in] threads the maximum amount of threads to use
+ *
+ * @return iterator pointing to the end of @c out
+ */
+template<class ExprT, class OIter, class IIter1, class IIter2, class IIter3>
+typename _rat_expr_iter<IIter3, OIter>::type
+evaluate ( const ExprT &expr, OIter out, IIter1 first1, IIter1 last1, IIter2 first2,
+           IIter3 first3, unsigned int threads = 1u ) {
+    return _rat_evaluate ( expr, out, first1, last1, first2, first3, _rat_expr_nocol(),
+                           threads );
+}
+
+/**
+ * @ingroup expr
+ * @brief evaluates an expression element-wise over four ranges
+ *
+ * @see evaluate(const ExprT &, OIter, IIter1, IIter1, unsigned int)
+ *
+ * @param[in] expr the expression to evaluate
+ * @param[out] out iterator to output the results to
+ * @param[in] first1 iterator pointing to the first value of @c _1
+ * @param[in] last1 iterator pointing past the last value of @c _1
+ * @param[in] first2 iterator pointing to the first value of @c _2
+ * @param[in] first3 iterator pointing to the first value of @c _3
+ * @param[in] first4 iterator pointing to the first value of @c _4
+ * @param[in] threads the maximum amount of threads to use
+ *
+ * @return iterator pointing to the end of @c out
+ */
+template<class ExprT, class OIter, class IIter1, class IIter2, class IIter3, class IIter4>
+typename _rat_expr_iter<IIter4, OIter>::type
+evaluate ( const ExprT &expr, OIter out, IIter1 first1, IIter1 last1, IIter2 first2,
+           IIter3 first3, IIter4 first4, unsigned int threads = 1u ) {
+    return _rat_evaluate ( expr, out, first1, last1, first2, first3, first4, threads );
+}
+
+template<class T> struct _unaryPlus {
+
+    typedef T result_type;
+
+    RATIONAL_CONSTEXPR result_type operator() ( const T &d ) const RATIONAL_NOEXCEPT {
+        return d;
+    }
+};
+
+template<class T> struct _unaryAbs {
+
+    typedef T result_type;
+
+    RATIONAL_CONSTEXPR result_type operator() ( const T &d ) const {
+        return d.abs();
+    }
+};
+
+template<class T> struct _unaryInv {
+
+    typedef T result_type;
+
+    RATIONAL_CONSTEXPR result_type operator() ( const T &d ) const {
+        return d.inverse();
+    }
+};
+
+template<class T> struct _unarySqrt {
+
+    typedef T result_type;
+
+    RATIONAL_CONSTEXPR result_type operator() ( const T &d ) const {
+        return d.sqrt();
+    }
+};
+
+template<class T> struct _unarySquare {
+
+    typedef T result_type;
+
+    result_type operator() ( const T &d ) const {
+
+        // the square of a reduced fraction is reduced
+        result_type r;
+
+        r.m_numer = typename T::op_multiplies() ( d.m_numer, d.m_numer );
+        r.m_denom = typename T::op_multiplies() ( d.m_denom, d.m_denom );
+
+        return r;
+    }
+};
+
+template<class T> struct _unaryTwice {
+
+    typedef T result_type;
+
+    result_type operator() ( const T &d ) const {
+
+        // twice a reduced fraction is reduced after halving an even denominator
+        result_type r ( d );
+
+        if ( ( d.m_denom & 1 ) == T::zero_ ) {
+            r.m_denom = d.m_denom >> 1;
+        } else {
+            r.m_numer = typename T::op_plus() ( d.m_numer, d.m_numer );
+        }
+
+        return r;
+    }
+};
+
+}
+
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+                   Commons::Math::RationalReference<B, GCD, CHKOP>,
+                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+                   operator+ ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
+const Commons::Math::Rational<B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+            Commons::Math::RationalReference<B, GCD, CHKOP>,
+            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT ( a,
+            Commons::Math::RationalReference<B, GCD, CHKOP> ( b ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalReference<A, GCD, CHKOP>,
+                   Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+                   operator+ ( const Commons::Math::Rational<A, GCD, CHKOP> &a,
+const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalReference<A, GCD, CHKOP>,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalReference<A, GCD, CHKOP> ( a ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+                   Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+                   operator+ ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
+const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT ( a, b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::Rational<T, GCD, CHKOP>,
                    Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
                    std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
 operator+ ( const A &a, const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
@@ -489,32 +1195,32 @@ template<class T, class A, class B, template<typename, bool, template<class, typ
 template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
 RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
                    Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
-                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
+                   Commons::Math::RationalReference<B, GCD, CHKOP>,
                    std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
                    operator- ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
 const Commons::Math::Rational<B, GCD, CHKOP> &b ) {
     typedef Commons::Math::RationalBinaryExpression<T,
             Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
-            Commons::Math::RationalConstant<B, GCD, CHKOP>,
+            Commons::Math::RationalReference<B, GCD, CHKOP>,
             std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
     return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT ( a,
-            Commons::Math::RationalConstant<B, GCD, CHKOP> ( b ) ) );
+            Commons::Math::RationalReference<B, GCD, CHKOP> ( b ) ) );
 }
 
 template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
 template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
 RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
-                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
+                   Commons::Math::RationalReference<A, GCD, CHKOP>,
                    Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
                    std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
                    operator- ( const Commons::Math::Rational<A, GCD, CHKOP> &a,
 const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
     typedef Commons::Math::RationalBinaryExpression<T,
-            Commons::Math::RationalConstant<A, GCD, CHKOP>,
+            Commons::Math::RationalReference<A, GCD, CHKOP>,
             Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
             std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
     return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
-                Commons::Math::RationalConstant<A, GCD, CHKOP> ( a ), b ) );
+                Commons::Math::RationalReference<A, GCD, CHKOP> ( a ), b ) );
 }
 
 template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
@@ -564,34 +1270,34 @@ template<class T, class A, class B, template<typename, bool, template<class, typ
 template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
 RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
                    Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
-                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
+                   Commons::Math::RationalReference<B, GCD, CHKOP>,
                    std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD,
                    CHKOP>
                    operator* ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
 const Commons::Math::Rational<B, GCD, CHKOP> &b ) {
     typedef Commons::Math::RationalBinaryExpression<T,
             Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
-            Commons::Math::RationalConstant<B, GCD, CHKOP>,
+            Commons::Math::RationalReference<B, GCD, CHKOP>,
             std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
     return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT ( a,
-            Commons::Math::RationalConstant<B, GCD, CHKOP> ( b ) ) );
+            Commons::Math::RationalReference<B, GCD, CHKOP> ( b ) ) );
 }
 
 template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
 template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
 RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
-                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
+                   Commons::Math::RationalReference<A, GCD, CHKOP>,
                    Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
                    std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD,
                    CHKOP>
                    operator* ( const Commons::Math::Rational<A, GCD, CHKOP> &a,
 const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
     typedef Commons::Math::RationalBinaryExpression<T,
-            Commons::Math::RationalConstant<A, GCD, CHKOP>,
+            Commons::Math::RationalReference<A, GCD, CHKOP>,
             Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
             std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
     return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
-                Commons::Math::RationalConstant<A, GCD, CHKOP> ( a ), b ) );
+                Commons::Math::RationalReference<A, GCD, CHKOP> ( a ), b ) );
 }
 
 template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
@@ -644,32 +1350,32 @@ template<class T, class A, class B, template<typename, bool, template<class, typ
 template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
 RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
                    Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
-                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
+                   Commons::Math::RationalReference<B, GCD, CHKOP>,
                    std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
                    operator/ ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
 const Commons::Math::Rational<B, GCD, CHKOP> &b ) {
     typedef Commons::Math::RationalBinaryExpression<T,
             Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
-            Commons::Math::RationalConstant<B, GCD, CHKOP>,
+            Commons::Math::RationalReference<B, GCD, CHKOP>,
             std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
     return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT ( a,
-            Commons::Math::RationalConstant<B, GCD, CHKOP> ( b ) ) );
+            Commons::Math::RationalReference<B, GCD, CHKOP> ( b ) ) );
 }
 
 template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
 template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
 RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
-                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
+                   Commons::Math::RationalReference<A, GCD, CHKOP>,
                    Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
                    std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
                    operator/ ( const Commons::Math::Rational<A, GCD, CHKOP> &a,
 const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
     typedef Commons::Math::RationalBinaryExpression<T,
-            Commons::Math::RationalConstant<A, GCD, CHKOP>,
+            Commons::Math::RationalReference<A, GCD, CHKOP>,
             Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
             std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
     return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
-                Commons::Math::RationalConstant<A, GCD, CHKOP> ( a ), b ) );
+                Commons::Math::RationalReference<A, GCD, CHKOP> ( a ), b ) );
 }
 
 template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
@@ -719,32 +1425,32 @@ template<class T, class A, class B, template<typename, bool, template<class, typ
 template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
 RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
                    Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
-                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
+                   Commons::Math::RationalReference<B, GCD, CHKOP>,
                    std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
                    operator% ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
 const Commons::Math::Rational<B, GCD, CHKOP> &b ) {
     typedef Commons::Math::RationalBinaryExpression<T,
             Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
-            Commons::Math::RationalConstant<B, GCD, CHKOP>,
+            Commons::Math::RationalReference<B, GCD, CHKOP>,
             std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
     return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT ( a,
-            Commons::Math::RationalConstant<B, GCD, CHKOP> ( b ) ) );
+            Commons::Math::RationalReference<B, GCD, CHKOP> ( b ) ) );
 }
 
 template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
 template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
 RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
-                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
+                   Commons::Math::RationalReference<A, GCD, CHKOP>,
                    Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
                    std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
                    operator% ( const Commons::Math::Rational<A, GCD, CHKOP> &a,
 const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
     typedef Commons::Math::RationalBinaryExpression<T,
-            Commons::Math::RationalConstant<A, GCD, CHKOP>,
+            Commons::Math::RationalReference<A, GCD, CHKOP>,
             Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
             std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
     return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
-                Commons::Math::RationalConstant<A, GCD, CHKOP> ( a ), b ) );
+                Commons::Math::RationalReference<A, GCD, CHKOP> ( a ), b ) );
 }
 
 template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
@@ -949,6 +1655,1330 @@ GCD, CHKOP> sqrt ( const Commons::Math::Rational<A, GCD, CHKOP> &a ) {
                 Commons::Math::RationalConstant<A, GCD, CHKOP> ( a ) ) );
 }
 
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+// temporary operands are moved into the expression, lvalues are referenced
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalReference<B, GCD, CHKOP>,
+                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator+ ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const Commons::Math::Rational<B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalReference<B, GCD, CHKOP>,
+            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                Commons::Math::RationalReference<B, GCD, CHKOP> ( b ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
+                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator+ ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            Commons::Math::Rational<B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalConstant<B, GCD, CHKOP>,
+            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                Commons::Math::RationalConstant<B, GCD, CHKOP> ( std::move ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
+                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator+ ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
+            Commons::Math::Rational<B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+            Commons::Math::RationalConstant<B, GCD, CHKOP>,
+            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, Commons::Math::RationalConstant<B, GCD, CHKOP> ( std::move ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalReference<A, GCD, CHKOP>,
+                   B,
+                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator+ ( const Commons::Math::Rational<A, GCD, CHKOP> &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalReference<A, GCD, CHKOP>,
+            B,
+            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalReference<A, GCD, CHKOP> ( a ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
+                   B,
+                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator+ ( Commons::Math::Rational<A, GCD, CHKOP> &&a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalConstant<A, GCD, CHKOP>,
+            B,
+            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalConstant<A, GCD, CHKOP> ( std::move ( a ) ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
+                   Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator+ ( Commons::Math::Rational<A, GCD, CHKOP> &&a,
+            const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalConstant<A, GCD, CHKOP>,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalConstant<A, GCD, CHKOP> ( std::move ( a ) ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator+ ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+                   B,
+                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator+ ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+            B,
+            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   B,
+                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator+ ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            B,
+            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::Rational<T, GCD, CHKOP>,
+                   B,
+                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator+ ( const A &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::Rational<T, GCD, CHKOP>,
+            B,
+            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::Rational<T, GCD, CHKOP>,
+                   std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator+ ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const B &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::Rational<T, GCD, CHKOP>,
+            std::plus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalReference<B, GCD, CHKOP>,
+                   std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator- ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const Commons::Math::Rational<B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalReference<B, GCD, CHKOP>,
+            std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                Commons::Math::RationalReference<B, GCD, CHKOP> ( b ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
+                   std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator- ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            Commons::Math::Rational<B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalConstant<B, GCD, CHKOP>,
+            std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                Commons::Math::RationalConstant<B, GCD, CHKOP> ( std::move ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
+                   std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator- ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
+            Commons::Math::Rational<B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+            Commons::Math::RationalConstant<B, GCD, CHKOP>,
+            std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, Commons::Math::RationalConstant<B, GCD, CHKOP> ( std::move ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalReference<A, GCD, CHKOP>,
+                   B,
+                   std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator- ( const Commons::Math::Rational<A, GCD, CHKOP> &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalReference<A, GCD, CHKOP>,
+            B,
+            std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalReference<A, GCD, CHKOP> ( a ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
+                   B,
+                   std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator- ( Commons::Math::Rational<A, GCD, CHKOP> &&a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalConstant<A, GCD, CHKOP>,
+            B,
+            std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalConstant<A, GCD, CHKOP> ( std::move ( a ) ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
+                   Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+                   std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator- ( Commons::Math::Rational<A, GCD, CHKOP> &&a,
+            const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalConstant<A, GCD, CHKOP>,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+            std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalConstant<A, GCD, CHKOP> ( std::move ( a ) ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+                   std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator- ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+            std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+                   B,
+                   std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator- ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+            B,
+            std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   B,
+                   std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator- ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            B,
+            std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::Rational<T, GCD, CHKOP>,
+                   B,
+                   std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator- ( const A &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::Rational<T, GCD, CHKOP>,
+            B,
+            std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::Rational<T, GCD, CHKOP>,
+                   std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator- ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const B &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::Rational<T, GCD, CHKOP>,
+            std::minus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalReference<B, GCD, CHKOP>,
+                   std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD,
+                   CHKOP>
+operator* ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const Commons::Math::Rational<B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalReference<B, GCD, CHKOP>,
+            std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                Commons::Math::RationalReference<B, GCD, CHKOP> ( b ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
+                   std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD,
+                   CHKOP>
+operator* ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            Commons::Math::Rational<B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalConstant<B, GCD, CHKOP>,
+            std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                Commons::Math::RationalConstant<B, GCD, CHKOP> ( std::move ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
+                   std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD,
+                   CHKOP>
+operator* ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
+            Commons::Math::Rational<B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+            Commons::Math::RationalConstant<B, GCD, CHKOP>,
+            std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, Commons::Math::RationalConstant<B, GCD, CHKOP> ( std::move ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalReference<A, GCD, CHKOP>,
+                   B,
+                   std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD,
+                   CHKOP>
+operator* ( const Commons::Math::Rational<A, GCD, CHKOP> &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalReference<A, GCD, CHKOP>,
+            B,
+            std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalReference<A, GCD, CHKOP> ( a ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
+                   B,
+                   std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD,
+                   CHKOP>
+operator* ( Commons::Math::Rational<A, GCD, CHKOP> &&a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalConstant<A, GCD, CHKOP>,
+            B,
+            std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalConstant<A, GCD, CHKOP> ( std::move ( a ) ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
+                   Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+                   std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD,
+                   CHKOP>
+operator* ( Commons::Math::Rational<A, GCD, CHKOP> &&a,
+            const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalConstant<A, GCD, CHKOP>,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+            std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalConstant<A, GCD, CHKOP> ( std::move ( a ) ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+                   std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD,
+                   CHKOP>
+operator* ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+            std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+                   B,
+                   std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD,
+                   CHKOP>
+operator* ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+            B,
+            std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   B,
+                   std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD,
+                   CHKOP>
+operator* ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            B,
+            std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::Rational<T, GCD, CHKOP>,
+                   B,
+                   std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD,
+                   CHKOP>
+operator* ( const A &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::Rational<T, GCD, CHKOP>,
+            B,
+            std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::Rational<T, GCD, CHKOP>,
+                   std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD,
+                   CHKOP>
+operator* ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const B &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::Rational<T, GCD, CHKOP>,
+            std::multiplies<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalReference<B, GCD, CHKOP>,
+                   std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator/ ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const Commons::Math::Rational<B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalReference<B, GCD, CHKOP>,
+            std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                Commons::Math::RationalReference<B, GCD, CHKOP> ( b ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
+                   std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator/ ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            Commons::Math::Rational<B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalConstant<B, GCD, CHKOP>,
+            std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                Commons::Math::RationalConstant<B, GCD, CHKOP> ( std::move ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
+                   std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator/ ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
+            Commons::Math::Rational<B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+            Commons::Math::RationalConstant<B, GCD, CHKOP>,
+            std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, Commons::Math::RationalConstant<B, GCD, CHKOP> ( std::move ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalReference<A, GCD, CHKOP>,
+                   B,
+                   std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator/ ( const Commons::Math::Rational<A, GCD, CHKOP> &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalReference<A, GCD, CHKOP>,
+            B,
+            std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalReference<A, GCD, CHKOP> ( a ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
+                   B,
+                   std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator/ ( Commons::Math::Rational<A, GCD, CHKOP> &&a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalConstant<A, GCD, CHKOP>,
+            B,
+            std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalConstant<A, GCD, CHKOP> ( std::move ( a ) ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
+                   Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+                   std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator/ ( Commons::Math::Rational<A, GCD, CHKOP> &&a,
+            const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalConstant<A, GCD, CHKOP>,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+            std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalConstant<A, GCD, CHKOP> ( std::move ( a ) ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+                   std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator/ ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+            std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+                   B,
+                   std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator/ ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+            B,
+            std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   B,
+                   std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator/ ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            B,
+            std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::Rational<T, GCD, CHKOP>,
+                   B,
+                   std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator/ ( const A &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::Rational<T, GCD, CHKOP>,
+            B,
+            std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::Rational<T, GCD, CHKOP>,
+                   std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator/ ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const B &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::Rational<T, GCD, CHKOP>,
+            std::divides<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalReference<B, GCD, CHKOP>,
+                   std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator% ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const Commons::Math::Rational<B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalReference<B, GCD, CHKOP>,
+            std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                Commons::Math::RationalReference<B, GCD, CHKOP> ( b ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
+                   std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator% ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            Commons::Math::Rational<B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalConstant<B, GCD, CHKOP>,
+            std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                Commons::Math::RationalConstant<B, GCD, CHKOP> ( std::move ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+                   Commons::Math::RationalConstant<B, GCD, CHKOP>,
+                   std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator% ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
+            Commons::Math::Rational<B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+            Commons::Math::RationalConstant<B, GCD, CHKOP>,
+            std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, Commons::Math::RationalConstant<B, GCD, CHKOP> ( std::move ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalReference<A, GCD, CHKOP>,
+                   B,
+                   std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator% ( const Commons::Math::Rational<A, GCD, CHKOP> &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalReference<A, GCD, CHKOP>,
+            B,
+            std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalReference<A, GCD, CHKOP> ( a ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
+                   B,
+                   std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator% ( Commons::Math::Rational<A, GCD, CHKOP> &&a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalConstant<A, GCD, CHKOP>,
+            B,
+            std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalConstant<A, GCD, CHKOP> ( std::move ( a ) ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalConstant<A, GCD, CHKOP>,
+                   Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+                   std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator% ( Commons::Math::Rational<A, GCD, CHKOP> &&a,
+            const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalConstant<A, GCD, CHKOP>,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+            std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                Commons::Math::RationalConstant<A, GCD, CHKOP> ( std::move ( a ) ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+                   std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator% ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const Commons::Math::RationalExpression<T, B, GCD, CHKOP> &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP>,
+            std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ), b ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+                   B,
+                   std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator% ( const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+            B,
+            std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   B,
+                   std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator% ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            B,
+            std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ),
+                std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   Commons::Math::Rational<T, GCD, CHKOP>,
+                   B,
+                   std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator% ( const A &a,
+            Commons::Math::RationalExpression<T, B, GCD, CHKOP> &&b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            Commons::Math::Rational<T, GCD, CHKOP>,
+            B,
+            std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                a, std::move ( Commons::Math::_rat_expr_access::expr ( b ) ) ) );
+}
+
+template<class T, class A, class B, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalBinaryExpression<T,
+                   A,
+                   Commons::Math::Rational<T, GCD, CHKOP>,
+                   std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator% ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a,
+            const B &b ) {
+    typedef Commons::Math::RationalBinaryExpression<T,
+            A,
+            Commons::Math::Rational<T, GCD, CHKOP>,
+            std::modulus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ), b ) );
+}
+
+template<class T, class A, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalUnaryExpression<T, A,
+                   std::negate<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>, GCD, CHKOP>
+operator- ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a ) {
+    typedef Commons::Math::RationalUnaryExpression<T, A,
+            std::negate<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ) ) );
+}
+
+template<class T, class A, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalUnaryExpression<T, A,
+                   Commons::Math::_unaryPlus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>,
+                   GCD, CHKOP>
+operator+ ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a ) {
+    typedef Commons::Math::RationalUnaryExpression<T, A,
+            Commons::Math::_unaryPlus<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ) ) );
+}
+
+template<class T, class A, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalUnaryExpression<T, A,
+                   Commons::Math::_unaryAbs<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>,
+                   GCD, CHKOP>
+abs ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a ) {
+    typedef Commons::Math::RationalUnaryExpression<T, A,
+            Commons::Math::_unaryAbs<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ) ) );
+}
+
+template<class T, class A, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalUnaryExpression<T, A,
+                   Commons::Math::_unaryInv<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>,
+                   GCD, CHKOP>
+inv ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a ) {
+    typedef Commons::Math::RationalUnaryExpression<T, A,
+            Commons::Math::_unaryInv<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ) ) );
+}
+
+template<class T, class A, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalUnaryExpression<T, A,
+                   Commons::Math::_unarySqrt<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>,
+                   GCD, CHKOP>
+sqrt ( Commons::Math::RationalExpression<T, A, GCD, CHKOP> &&a ) {
+    typedef Commons::Math::RationalUnaryExpression<T, A,
+            Commons::Math::_unarySqrt<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT (
+                std::move ( Commons::Math::_rat_expr_access::expr ( a ) ) ) );
+}
+
+#endif
+
+// expressions of literals only are folded into a literal at construction
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator+ ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> a,
+            Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( Commons::Math::eval_rat_expr ( a ) +
+                                       Commons::Math::eval_rat_expr ( b ) );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator+ ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> a,
+            Commons::Math::Rational<T, GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( Commons::Math::eval_rat_expr ( a ) + b );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator+ ( Commons::Math::Rational<T, GCD, CHKOP> a,
+            Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( a + Commons::Math::eval_rat_expr ( b ) );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator- ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> a,
+            Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( Commons::Math::eval_rat_expr ( a ) -
+                                       Commons::Math::eval_rat_expr ( b ) );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator- ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> a,
+            Commons::Math::Rational<T, GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( Commons::Math::eval_rat_expr ( a ) - b );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator- ( Commons::Math::Rational<T, GCD, CHKOP> a,
+            Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( a - Commons::Math::eval_rat_expr ( b ) );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator* ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> a,
+            Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( Commons::Math::eval_rat_expr ( a ) *
+                                       Commons::Math::eval_rat_expr ( b ) );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator* ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> a,
+            Commons::Math::Rational<T, GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( Commons::Math::eval_rat_expr ( a ) * b );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator* ( Commons::Math::Rational<T, GCD, CHKOP> a,
+            Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( a * Commons::Math::eval_rat_expr ( b ) );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator/ ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> a,
+            Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( Commons::Math::eval_rat_expr ( a ) /
+                                       Commons::Math::eval_rat_expr ( b ) );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator/ ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> a,
+            Commons::Math::Rational<T, GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( Commons::Math::eval_rat_expr ( a ) / b );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator/ ( Commons::Math::Rational<T, GCD, CHKOP> a,
+            Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( a / Commons::Math::eval_rat_expr ( b ) );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator% ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> a,
+            Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( Commons::Math::eval_rat_expr ( a ) %
+                                       Commons::Math::eval_rat_expr ( b ) );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator% ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> a,
+            Commons::Math::Rational<T, GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( Commons::Math::eval_rat_expr ( a ) % b );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator% ( Commons::Math::Rational<T, GCD, CHKOP> a,
+            Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> b ) {
+    return Commons::Math::mk_rat_lit ( a % Commons::Math::eval_rat_expr ( b ) );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator- ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> a ) {
+    return Commons::Math::mk_rat_lit ( -Commons::Math::eval_rat_expr ( a ) );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+operator+ ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>,
+            GCD, CHKOP> a ) {
+    return Commons::Math::mk_rat_lit ( Commons::Math::eval_rat_expr ( a ) );
+}
+
+/**
+ * @ingroup expr
+ * @overload
+ */
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+abs ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>, GCD,
+      CHKOP> a ) {
+    return Commons::Math::mk_rat_lit ( Commons::Math::eval_rat_expr ( a ).abs() );
+}
+
+/**
+ * @ingroup expr
+ * @overload
+ */
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+inv ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>, GCD,
+      CHKOP> a ) {
+    return Commons::Math::mk_rat_lit ( Commons::Math::eval_rat_expr ( a ).inverse() );
+}
+
+/**
+ * @ingroup expr
+ * @overload
+ */
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR typename Commons::Math::RationalExpressionTraits<Commons::Math::Rational<T,
+                   GCD, CHKOP> >::expr_type
+sqrt ( Commons::Math::RationalExpression<T, Commons::Math::RationalConstant<T, GCD, CHKOP>, GCD,
+       CHKOP> a ) {
+    return Commons::Math::mk_rat_lit ( Commons::Math::eval_rat_expr ( a ).sqrt() );
+}
+
+// x * x is rewritten to the square of x
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalUnaryExpression<T,
+                   Commons::Math::RationalVariable<T, GCD, CHKOP>,
+                   Commons::Math::_unarySquare<Commons::Math::Rational<T, GCD, CHKOP> >,
+                   GCD, CHKOP>, GCD, CHKOP>
+operator* ( Commons::Math::RationalExpression<T, Commons::Math::RationalVariable<T, GCD, CHKOP>,
+            GCD, CHKOP>,
+            Commons::Math::RationalExpression<T, Commons::Math::RationalVariable<T, GCD, CHKOP>,
+            GCD, CHKOP> ) {
+    typedef Commons::Math::RationalVariable<T, GCD, CHKOP> X;
+    typedef Commons::Math::RationalUnaryExpression<T, X,
+            Commons::Math::_unarySquare<Commons::Math::Rational<T, GCD, CHKOP> >,
+            GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT ( ( X() ) ) );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP, std::size_t N>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalUnaryExpression<T,
+                   Commons::Math::RationalPlaceholder<T, GCD, CHKOP, N>,
+                   Commons::Math::_unarySquare<Commons::Math::Rational<T, GCD, CHKOP> >,
+                   GCD, CHKOP>, GCD, CHKOP>
+operator* ( Commons::Math::RationalExpression<T,
+            Commons::Math::RationalPlaceholder<T, GCD, CHKOP, N>, GCD, CHKOP>,
+            Commons::Math::RationalExpression<T,
+            Commons::Math::RationalPlaceholder<T, GCD, CHKOP, N>, GCD, CHKOP> ) {
+    typedef Commons::Math::RationalPlaceholder<T, GCD, CHKOP, N> X;
+    typedef Commons::Math::RationalUnaryExpression<T, X,
+            Commons::Math::_unarySquare<Commons::Math::Rational<T, GCD, CHKOP> >,
+            GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT ( ( X() ) ) );
+}
+
+// x + x is rewritten to twice x
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalUnaryExpression<T,
+                   Commons::Math::RationalVariable<T, GCD, CHKOP>,
+                   Commons::Math::_unaryTwice<Commons::Math::Rational<T, GCD, CHKOP> >,
+                   GCD, CHKOP>, GCD, CHKOP>
+operator+ ( Commons::Math::RationalExpression<T, Commons::Math::RationalVariable<T, GCD, CHKOP>,
+            GCD, CHKOP>,
+            Commons::Math::RationalExpression<T, Commons::Math::RationalVariable<T, GCD, CHKOP>,
+            GCD, CHKOP> ) {
+    typedef Commons::Math::RationalVariable<T, GCD, CHKOP> X;
+    typedef Commons::Math::RationalUnaryExpression<T, X,
+            Commons::Math::_unaryTwice<Commons::Math::Rational<T, GCD, CHKOP> >,
+            GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT ( ( X() ) ) );
+}
+
+template<class T, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP, std::size_t N>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, Commons::Math::RationalUnaryExpression<T,
+                   Commons::Math::RationalPlaceholder<T, GCD, CHKOP, N>,
+                   Commons::Math::_unaryTwice<Commons::Math::Rational<T, GCD, CHKOP> >,
+                   GCD, CHKOP>, GCD, CHKOP>
+operator+ ( Commons::Math::RationalExpression<T,
+            Commons::Math::RationalPlaceholder<T, GCD, CHKOP, N>, GCD, CHKOP>,
+            Commons::Math::RationalExpression<T,
+            Commons::Math::RationalPlaceholder<T, GCD, CHKOP, N>, GCD, CHKOP> ) {
+    typedef Commons::Math::RationalPlaceholder<T, GCD, CHKOP, N> X;
+    typedef Commons::Math::RationalUnaryExpression<T, X,
+            Commons::Math::_unaryTwice<Commons::Math::Rational<T, GCD, CHKOP> >,
+            GCD, CHKOP> ExprT;
+    return Commons::Math::RationalExpression<T, ExprT, GCD, CHKOP> ( ExprT ( ( X() ) ) );
+}
+
+/**
+ * @ingroup expr
+ * @brief inverts an inverted expression
+ *
+ * The double inversion is removed, i.e. @c inv(inv(x)) evaluates to @c x
+ * (even if @c x evaluates to zero).
+ */
+template<class T, class A, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &
+inv ( const Commons::Math::RationalExpression<T, Commons::Math::RationalUnaryExpression<T,
+      Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+      Commons::Math::_unaryInv<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>,
+      GCD, CHKOP> &a ) {
+    using Commons::Math::_rat_expr_access;
+    return _rat_expr_access::operand ( _rat_expr_access::expr ( a ) );
+}
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+/**
+ * @ingroup expr
+ * @overload
+ *
+ * The operand refers to an expression living outside the temporary, thus it can be
+ * returned by reference.
+ */
+template<class T, class A, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR const Commons::Math::RationalExpression<T, A, GCD, CHKOP> &
+inv ( Commons::Math::RationalExpression<T, Commons::Math::RationalUnaryExpression<T,
+      Commons::Math::RationalExpression<T, A, GCD, CHKOP>,
+      Commons::Math::_unaryInv<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>,
+      GCD, CHKOP> &&a ) {
+    using Commons::Math::_rat_expr_access;
+    return _rat_expr_access::operand ( _rat_expr_access::expr ( a ) );
+}
+
+/**
+ * @ingroup expr
+ * @overload
+ *
+ * The operand is owned by the temporary and gets moved out of it.
+ */
+template<class T, class A, template<typename, bool, template<class, typename, bool> class,
+template<typename> class> class GCD, template<class, typename, bool> class CHKOP>
+RATIONAL_CONSTEXPR Commons::Math::RationalExpression<T, A, GCD, CHKOP>
+inv ( Commons::Math::RationalExpression<T, Commons::Math::RationalUnaryExpression<T, A,
+      Commons::Math::_unaryInv<Commons::Math::Rational<T, GCD, CHKOP> >, GCD, CHKOP>,
+      GCD, CHKOP> &&a ) {
+    using Commons::Math::_rat_expr_access;
+    return Commons::Math::RationalExpression<T, A, GCD, CHKOP>
+           ( std::move ( _rat_expr_access::operand ( _rat_expr_access::expr ( a ) ) ) );
+}
+#endif
+
 #endif /* COMMONS_MATH_EXPR_RATIONAL_H */
 
-// kate: indent-mode cstyle; indent-width 4; replace-tabs on; 
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
@@ -176,6 +176,286 @@ template<> struct DecomposeBaseTraits<mpz_class, true> {
     enum { Base = 10 };
 };
 
+template<> struct ToCharsTraits<mpz_class> {
+
+    static std::size_t size ( const mpz_class &x ) {
+        return size ( x, 10 );
+    }
+
+    static char *convert ( char *first, char *last, const mpz_class &x ) {
+        return convert ( first, last, x, 10 );
+    }
+
+    static std::size_t size ( const mpz_class &x, int base ) {
+        // mpz_sizeinbase may overestimate by one, plus sign and the terminating NUL
+        return _is_radix ( base ) ? mpz_sizeinbase ( x.get_mpz_t(), base ) + 2u : 0u;
+    }
+
+    static char *convert ( char *first, char *last, const mpz_class &x, int base ) {
+
+        // mpz_get_str returns NULL for other bases
+        if ( !_is_radix ( base ) ) return 0L;
+
+        // the digits and sign take n - 1 or n chars, so mpz_get_str puts its NUL at one of
+        // these two positions, which get restored afterwards
+        const std::size_t n = mpz_sizeinbase ( x.get_mpz_t(), base ) +
+                              ( mpz_sgn ( x.get_mpz_t() ) < 0 );
+
+        if ( static_cast<std::size_t> ( last - first ) <= n ) return 0L;
+
+        const char keep[2] = { first[n - 1u], first[n] };
+        char *e = first + std::strlen ( mpz_get_str ( first, base, x.get_mpz_t() ) );
+
+        *e = keep[e - first - ( n - 1u )];
+
+        return e;
+    }
+};
+
+template<> struct RadixExpandTraits<mpz_class> {
+
+    // calculates chunks of k digits by one division through base^k and leaves the
+    // conversion of each chunk to GMP's subquadratic radix conversion
+    static char *expand ( char *first, char *last, mpz_class r, const mpz_class &d, int base,
+                          std::size_t n ) {
+
+        if ( !_is_radix ( base ) || static_cast<std::size_t> ( last - first ) < n ) return 0L;
+
+        const std::size_t k = std::max<std::size_t> ( mpz_sizeinbase ( d.get_mpz_t(), base ),
+                              64u );
+
+        mpz_class pw, q;
+        std::string buf;
+
+        mpz_ui_pow_ui ( pw.get_mpz_t(), static_cast<unsigned long> ( base ), k );
+
+        while ( n ) {
+
+            const std::size_t c = std::min ( n, k );
+
+            if ( c != k ) mpz_ui_pow_ui ( pw.get_mpz_t(), static_cast<unsigned long> ( base ), c );
+
+            r *= pw;
+            mpz_tdiv_qr ( q.get_mpz_t(), r.get_mpz_t(), r.get_mpz_t(), d.get_mpz_t() );
+
+            buf.resize ( mpz_sizeinbase ( q.get_mpz_t(), base ) + 2u );
+
+            const std::size_t len = std::strlen ( mpz_get_str ( &buf[0], base, q.get_mpz_t() ) );
+
+            std::fill ( first, first + ( c - len ), '0' );
+            first = std::copy ( buf.begin(), buf.begin() + len, first + ( c - len ) );
+
+            n -= c;
+        }
+
+        return first;
+    }
+};
+
+template<> struct RadixPowerTraits<mpz_class> {
+
+    static std::size_t digits ( const mpz_class &x, int base ) {
+
+        if ( !mpz_sgn ( x.get_mpz_t() ) ) return 0u;
+
+        // mpz_sizeinbase may overestimate by one
+        const std::size_t n = mpz_sizeinbase ( x.get_mpz_t(), base );
+
+        return ( base & ( base - 1 ) ) && n > 1u && x < pow ( base, n - 1u ) ? n - 1u : n;
+    }
+
+    static mpz_class pow ( int base, std::size_t n ) {
+
+        mpz_class r;
+
+        mpz_ui_pow_ui ( r.get_mpz_t(), static_cast<unsigned long> ( base ), n );
+
+        return r;
+    }
+};
+
+template<> struct ContinuedFractionTraits<mpz_class> {
+
+    // Lehmer's algorithm: the quotients are calculated from the leading bits as long as
+    // both bounds of the true quotient agree (Knuth, TAOCP Vol. 2, 4.5.2, Algorithm L),
+    // and then applied as 2x2 matrix to the full numbers in one go
+    template<class OIter>
+    static OIter expand ( mpz_class u, mpz_class v, OIter out, bool neg ) {
+
+        const std::size_t bits = static_cast<std::size_t> ( std::numeric_limits<long>::digits - 1 );
+
+        mpz_class s, t;
+
+        while ( mpz_sgn ( v.get_mpz_t() ) ) {
+
+            const std::size_t n = std::max ( mpz_sizeinbase ( u.get_mpz_t(), 2 ),
+                                             mpz_sizeinbase ( v.get_mpz_t(), 2 ) );
+
+            if ( n <= bits ) return word ( mpz_get_si ( u.get_mpz_t() ),
+                                               mpz_get_si ( v.get_mpz_t() ), out, neg );
+
+            long A = 1, B = 0, C = 0, D = 1;
+            bool steps = false;
+
+            mpz_tdiv_q_2exp ( t.get_mpz_t(), u.get_mpz_t(), n - bits );
+            long uh = mpz_get_si ( t.get_mpz_t() );
+            mpz_tdiv_q_2exp ( t.get_mpz_t(), v.get_mpz_t(), n - bits );
+            long vh = mpz_get_si ( t.get_mpz_t() );
+
+            while ( vh + C && vh + D ) {
+
+                const long q = ( uh + A ) / ( vh + C );
+
+                if ( q != ( uh + B ) / ( vh + D ) ) break;
+
+                long x = A - q * C;
+                A = C;
+                C = x;
+                x = B - q * D;
+                B = D;
+                D = x;
+                x = uh - q * vh;
+                uh = vh;
+                vh = x;
+
+                * ( out++ ) = mpz_class ( neg ? -q : q );
+                steps = true;
+            }
+
+            if ( !steps ) {
+
+                mpz_tdiv_qr ( s.get_mpz_t(), t.get_mpz_t(), u.get_mpz_t(), v.get_mpz_t() );
+
+                if ( neg ) mpz_neg ( s.get_mpz_t(), s.get_mpz_t() );
+
+                * ( out++ ) = s;
+
+                u.swap ( v );
+                v.swap ( t );
+
+            } else {
+
+                mpz_mul_si ( s.get_mpz_t(), u.get_mpz_t(), A );
+                mpz_mul_si ( t.get_mpz_t(), v.get_mpz_t(), B );
+                mpz_add ( s.get_mpz_t(), s.get_mpz_t(), t.get_mpz_t() );
+                mpz_mul_si ( t.get_mpz_t(), u.get_mpz_t(), C );
+                mpz_mul_si ( u.get_mpz_t(), v.get_mpz_t(), D );
+                mpz_add ( v.get_mpz_t(), t.get_mpz_t(), u.get_mpz_t() );
+
+                u.swap ( s );
+            }
+        }
+
+        return out;
+    }
+
+private:
+    template<class OIter>
+    static OIter word ( long u, long v, OIter out, bool neg ) {
+
+        do {
+
+            const long q = u / v, r = u % v;
+
+            * ( out++ ) = mpz_class ( neg ? -q : q );
+
+            u = v;
+            v = r;
+
+        } while ( v );
+
+        return out;
+    }
+};
+
+template<> struct FromCharsTraits<mpz_class> {
+
+    static const char *convert ( const char *first, const char *last, mpz_class &x ) {
+
+        const char *e = first;
+
+        while ( e != last && *e >= '0' && *e <= '9' ) ++e;
+
+        if ( e == first ) return 0L;
+
+        const std::size_t len = static_cast<std::size_t> ( e - first );
+
+        if ( len < 64u ) {
+
+            char buf[64];
+
+            *std::copy ( first, e, buf ) = 0;
+            mpz_set_str ( x.get_mpz_t(), buf, 10 );
+
+        } else {
+            mpz_set_str ( x.get_mpz_t(), std::string ( first, e ).c_str(), 10 );
+        }
+
+        return e;
+    }
+};
+
+template<> struct SerializeTraits<mpz_class> {
+
+    // a varint of the byte count and the sign, followed by the little endian magnitude
+    static std::size_t size ( const mpz_class &x ) {
+
+        const std::size_t n = ( mpz_sizeinbase ( x.get_mpz_t(), 2 ) + 7u ) >> 3;
+
+        return SerializeTraits<std::size_t>::size ( n << 1 ) + n;
+    }
+
+    static unsigned char *write ( unsigned char *first, unsigned char *last,
+                                  const mpz_class &x ) {
+
+        const std::size_t n = mpz_sgn ( x.get_mpz_t() ) ?
+                              ( mpz_sizeinbase ( x.get_mpz_t(), 2 ) + 7u ) >> 3 : 0u;
+
+        if ( ! ( first = SerializeTraits<std::size_t>::write ( first, last,
+                         ( n << 1 ) | ( mpz_sgn ( x.get_mpz_t() ) < 0 ) ) ) ||
+                static_cast<std::size_t> ( last - first ) < n ) return 0L;
+
+        if ( n ) mpz_export ( first, 0L, -1, 1, 0, 0, x.get_mpz_t() );
+
+        return first + n;
+    }
+
+    static const unsigned char *read ( const unsigned char *first, const unsigned char *last,
+                                       mpz_class &x, bool *more = 0L ) {
+
+        std::size_t h;
+
+        if ( ! ( first = SerializeTraits<std::size_t>::read ( first, last, h, more ) ) ) return 0L;
+
+        if ( static_cast<std::size_t> ( last - first ) < ( h >> 1 ) ) {
+            if ( more ) *more = true;
+            return 0L;
+        }
+
+        mpz_import ( x.get_mpz_t(), h >> 1, -1, 1, 0, 0, first );
+
+        if ( h & 1 ) mpz_neg ( x.get_mpz_t(), x.get_mpz_t() );
+
+        return first + ( h >> 1 );
+    }
+};
+
+template<> struct HashTraits<mpz_class> {
+
+    // the sign and the limbs of the magnitude, without converting to a string
+    static std::size_t hash ( const mpz_class &x ) {
+
+        const mpz_srcptr z = x.get_mpz_t();
+        std::size_t h = static_cast<std::size_t> ( mpz_sgn ( z ) );
+
+        for ( std::size_t i = 0u, n = mpz_size ( z ); i < n; ++i ) {
+            h = _hash_combine ( h, HashTraits<mp_limb_t>::hash ( mpz_getlimbn ( z, i ) ) );
+        }
+
+        return h;
+    }
+};
+
 template<> struct _type_round_helper<mpz_class> {
     mpz_class operator() ( const mpz_class &tr ) const {
         return tr;
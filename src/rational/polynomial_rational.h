@@ -0,0 +1,316 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * @author Heiko Schäfer <heiko@rangun.de>
+ * @copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * @defgroup polynomial Polynomials
+ *
+ * The header `polynomial_rational.h` provides polynomials with %Rational coefficients, which
+ * are evaluated in integer arithmetic.
+ *
+ * The coefficients @f$ c_i @f$ are scaled once to the integers @f$ a_i = L c_i @f$, where
+ * @f$ L @f$ is the least common multiple of their denominators. For @f$ x = \frac{n}{d} @f$
+ * the value @f$ P(x) = \frac{\sum_{i=0}^k a_i n^i d^{k-i}}{L d^k} @f$ is calculated by
+ * Horner's scheme on the numerator, so the result gets reduced only once per evaluation.
+ *
+ * @b Example: @code{.cpp}
+ * typedef Commons::Math::RationalPolynomial<long> poly;
+ *
+ * // 1/2 - 2/3x + 3/4x^2
+ * const poly::rational_type c[] = { poly::rational_type ( 1, 2 ),
+ *                                   poly::rational_type ( -2, 3 ),
+ *                                   poly::rational_type ( 3, 4 ) };
+ * const poly p ( c, c + 3 );
+ *
+ * // 17/48
+ * const poly::rational_type &y ( p ( poly::rational_type ( 1, 2 ) ) );@endcode
+ */
+
+#ifndef COMMONS_MATH_POLYNOMIAL_RATIONAL_H
+#define COMMONS_MATH_POLYNOMIAL_RATIONAL_H
+
+#include <iterator>
+#include <vector>
+#include <map>
+
+#include "rational.h"
+
+namespace Commons {
+
+namespace Math {
+
+/**
+ * @ingroup polynomial
+ * @brief Polynomial with %Rational coefficients
+ *
+ * Large batches aren't evaluated by a subproduct tree, as without fast polynomial
+ * multiplication such a multipoint evaluation doesn't beat evaluate()'s cached Horner scheme.
+ *
+ * @tparam T storage type
+ * @tparam GCD GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ * @tparam Alloc the allocator
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD = GCD_euclid_fast,
+         template<class, typename = T, bool = std::numeric_limits<T>::is_signed>
+         class CHKOP = NO_OPERATOR_CHECK, template<typename> class Alloc = std::allocator>
+class RationalPolynomial {
+
+public:
+    typedef Rational<T, GCD, CHKOP, Alloc> rational_type; ///< the type of the coefficients
+    typedef typename rational_type::integer_type integer_type; ///< storage type
+
+private:
+    typedef std::vector<integer_type, Alloc<integer_type> > coeff_type;
+
+    // the coefficients scaled for a denominator d and the scaled denominator L d^k
+    struct _scaled {
+        coeff_type b;
+        integer_type q;
+    };
+
+    typedef std::map<integer_type, _scaled, std::less<integer_type>,
+            Alloc<std::pair<const integer_type, _scaled> > > cache_type;
+
+public:
+    /**
+     * @brief creates the zero polynomial
+     */
+    RationalPolynomial() : m_a(), m_l ( rational_type::one_ ) {}
+
+    /**
+     * @brief creates a polynomial from its coefficients
+     *
+     * The coefficients are given in ascending order of the powers, i.e. beginning with the
+     * constant term.
+     *
+     * @tparam IIter input iterator type of the coefficients
+     *
+     * @param[in] first iterator pointing to the constant coefficient
+     * @param[in] last iterator pointing past the leading coefficient
+     */
+    template<class IIter>
+    RationalPolynomial ( IIter first, IIter last ) : m_a(), m_l ( rational_type::one_ ) {
+
+        const std::vector<rational_type, Alloc<rational_type> > c ( first, last );
+        typename std::vector<rational_type, Alloc<rational_type> >::size_type k = c.size();
+
+        while ( k && c[k - 1u].numerator() == rational_type::zero_ ) --k;
+
+        for ( std::size_t i = 0u; i < k; ++i ) {
+            m_l = _lcm<integer_type, GCD, CHKOP, Alloc,
+            std::numeric_limits<integer_type>::is_signed>() ( m_l, c[i].denominator() );
+        }
+
+        m_a.reserve ( k );
+
+        for ( std::size_t i = 0u; i < k; ++i ) {
+            m_a.push_back ( typename rational_type::op_multiplies() ( c[i].numerator(),
+                            typename rational_type::op_divides() ( m_l, c[i].denominator() ) ) );
+        }
+    }
+
+    /**
+     * @brief gets the degree
+     *
+     * @note the zero polynomial has degree @c 0 as well
+     */
+    std::size_t degree() const {
+        return m_a.empty() ? 0u : m_a.size() - 1u;
+    }
+
+    /**
+     * @brief gets the coefficient of the @c i-th power
+     *
+     * @param[in] i the power
+     */
+    rational_type coefficient ( std::size_t i ) const {
+        return i < m_a.size() ? rational_type ( m_a[i], m_l ) : rational_type();
+    }
+
+    /**
+     * @brief evaluates the polynomial
+     *
+     * @param[in] x the point to evaluate at
+     *
+     * @return @f$ P(x) @f$
+     */
+    rational_type operator() ( const rational_type& x ) const {
+
+        if ( m_a.empty() ) return rational_type();
+
+        const typename rational_type::op_plus add = typename rational_type::op_plus();
+        const typename rational_type::op_multiplies mul = typename rational_type::op_multiplies();
+
+        typename coeff_type::const_reverse_iterator i ( m_a.rbegin() );
+        integer_type s ( *i );
+
+        if ( x.denominator() == rational_type::one_ ) {
+
+            while ( ++i != m_a.rend() ) s = add ( mul ( s, x.numerator() ), *i );
+
+            return rational_type ( s, m_l );
+        }
+
+        integer_type p ( rational_type::one_ );
+
+        while ( ++i != m_a.rend() ) {
+            p = mul ( p, x.denominator() );
+            s = add ( mul ( s, x.numerator() ), mul ( *i, p ) );
+        }
+
+        return rational_type ( s, mul ( m_l, p ) );
+    }
+
+    /**
+     * @brief evaluates the polynomial at many points
+     *
+     * For class storage types (i.e. big integers) points sharing a denominator @f$ d @f$ (as
+     * grid points do) are evaluated at once: the coefficients get scaled to @f$ a_i d^{k-i} @f$
+     * when the denominator occurs the second time, after which every further point needs only
+     * one multiplication and addition per coefficient.
+     *
+     * If @c threads is greater than @c 1 and C++11 is available, the range gets split into
+     * @c threads chunks, which are evaluated in parallel and written in order. In this case
+     * forward iterators are needed.
+     *
+     * @tparam IIter the input iterator type
+     * @tparam OIter the output iterator type
+     *
+     * @param[in] first iterator pointing to the first point
+     * @param[in] last iterator pointing past the last point
+     * @param[out] out iterator to output the values to
+     * @param[in] threads the maximum amount of threads to use
+     *
+     * @return iterator pointing to the end of @c out
+     */
+    template<class IIter, class OIter>
+    OIter evaluate ( IIter first, IIter last, OIter out, unsigned int threads = 1u ) const {
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+        const std::size_t n = threads > 1u ? std::distance ( first, last ) : 0u;
+
+        if ( n > threads ) {
+
+            const std::size_t chunk = ( n + threads - 1u ) / threads;
+
+            std::vector<std::vector<rational_type> > parts ( threads );
+            std::vector<IIter> bounds ( 1u, first );
+
+            for ( std::size_t b = chunk; b < n; b += chunk ) {
+                std::advance ( first, chunk );
+                bounds.push_back ( first );
+            }
+
+            bounds.push_back ( last );
+
+            const unsigned int k = static_cast<unsigned int> ( bounds.size() - 1u );
+
+            _parallel_run ( k, [this, &parts, &bounds, chunk] ( unsigned int i ) {
+                parts[i].reserve ( chunk );
+                _evaluate ( bounds[i], bounds[i + 1u], std::back_inserter ( parts[i] ) );
+            } );
+
+            for ( const std::vector<rational_type> &p : parts ) {
+                out = std::copy ( p.begin(), p.end(), out );
+            }
+
+            return out;
+        }
+#else
+        ( void ) threads;
+#endif
+
+        return _evaluate ( first, last, out );
+    }
+
+private:
+    template<class IIter, class OIter>
+    OIter _evaluate ( IIter first, IIter last, OIter out ) const {
+
+        const typename rational_type::op_plus add = typename rational_type::op_plus();
+        const typename rational_type::op_multiplies mul = typename rational_type::op_multiplies();
+
+        cache_type cache;
+
+        for ( ; first != last; ++first ) {
+
+            const rational_type &x ( *first );
+
+            // for built-in storage types the scaling is cheaper than looking it up
+            if ( !tmp::_isClassT<integer_type>::Yes || m_a.empty() ||
+                    x.denominator() == rational_type::one_ ) {
+                * ( out++ ) = ( *this ) ( x );
+                continue;
+            }
+
+            // too many distinct denominators won't pay off
+            if ( cache.size() == 1024u ) cache.clear();
+
+            const std::pair<typename cache_type::iterator, bool> &c ( cache.insert (
+                        std::make_pair ( x.denominator(), _scaled() ) ) );
+
+            // evaluate the first occurrence of a denominator directly
+            if ( c.second ) {
+                * ( out++ ) = ( *this ) ( x );
+                continue;
+            }
+
+            _scaled &sc ( c.first->second );
+
+            if ( sc.b.empty() ) {
+
+                integer_type p ( rational_type::one_ );
+
+                sc.b.resize ( m_a.size() );
+
+                for ( std::size_t i = m_a.size(); i-- > 0u; ) {
+                    sc.b[i] = mul ( m_a[i], p );
+                    if ( i ) p = mul ( p, x.denominator() );
+                }
+
+                sc.q = mul ( m_l, p );
+            }
+
+            typename coeff_type::const_reverse_iterator i ( sc.b.rbegin() );
+            integer_type s ( *i );
+
+            while ( ++i != sc.b.rend() ) s = add ( mul ( s, x.numerator() ), *i );
+
+            * ( out++ ) = rational_type ( s, sc.q );
+        }
+
+        return out;
+    }
+
+    coeff_type m_a;
+    integer_type m_l;
+};
+
+}
+
+}
+
+#endif /* COMMONS_MATH_POLYNOMIAL_RATIONAL_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
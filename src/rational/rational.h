@@ -62,6 +62,7 @@
 #include <algorithm>
 #include <sstream>
 #include <cstdlib>
+#include <cstddef>
 #include <cstring>
 #include <string>
 #include <limits>
@@ -69,8 +70,14 @@
 #include <stack>
 #include <cmath>
 
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
 #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
 #include <type_traits>
+#include <exception>
+#include <thread>
 #include <array>
 #include <list>
 #endif
@@ -175,6 +182,9 @@ template<typename, template<typename, bool, template<class, typename, bool> clas
          template<typename> class> class, template<class, typename, bool> class,
          template<typename> class> struct _psq;
 
+template<class> struct _unarySquare;
+template<class> struct _unaryTwice;
+
 /**
  * @ingroup main
  * @brief Type coversion policy class
@@ -567,3031 +577,6109 @@ template<typename T> struct _type_round_helper {
     }
 };
 
-template<typename Container, bool ExplicitEnd>
-struct ContainerTraits;
+inline bool _is_radix ( int base ) {
+    return base >= 2 && base <= 62;
+}
 
-template<typename Container>
-struct ContainerTraits<Container, true> {
+inline char _radix_digit ( int d, int base ) {
+    return ( base > 36 ? "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz" :
+             "0123456789abcdefghijklmnopqrstuvwxyz" ) [d];
+}
 
-    typedef std::insert_iterator<Container> iterator;
+template<typename T, bool IsClass>
+struct _to_chars_impl;
 
-    RATIONAL_CONSTEXPR static iterator make_iterator ( Container& c ) {
-        return iterator ( c, c.end() );
-    }
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic push
+template<typename T>
+struct _to_chars_impl<T, false> {
 
-    static void clear ( Container& c ) {
-        c.clear();
-    }
-};
+    static std::size_t size ( T x ) {
 
-template<typename Container>
-struct ContainerTraits<Container, false> {
+        std::size_t n = x < T() ? 2u : 1u;
 
-    typedef std::back_insert_iterator<Container> iterator;
+        while ( ( x /= 10 ) != T() ) ++n;
 
-    RATIONAL_CONSTEXPR static iterator make_iterator ( Container& c ) {
-        return iterator ( c );
+        return n;
     }
 
-    static void clear ( Container& c ) {
-        c.clear();
-    }
-};
+    static char *convert ( char *first, char *last, T x ) {
+#if __cplusplus >= 201703L
+        const std::to_chars_result &r ( std::to_chars ( first, last, x ) );
+        return r.ec == std::errc() ? r.ptr : 0L;
+#else
+        char buf[std::numeric_limits<T>::digits10 + 2];
+        char *p = buf + sizeof ( buf );
 
-#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
-template<typename Container> class back_emplace_iterator :
-    public std::iterator<std::output_iterator_tag, void, void, void, void> {
-public:
-    typedef Container container_type;
+        const bool neg = x < T();
 
-    explicit back_emplace_iterator ( Container& c ) : c_ ( &c ) {}
+        do {
 
-    back_emplace_iterator& operator= ( const typename Container::value_type& value ) {
-        c_->emplace_back ( value );
-        return *this;
-    }
+            const T d ( x % 10 );
 
-    back_emplace_iterator& operator= ( typename Container::value_type &&value ) {
-        c_->emplace_back ( std::move ( value ) );
-        return *this;
-    }
+            * ( --p ) = static_cast<char> ( '0' + ( d < T() ? -d : d ) );
+            x /= 10;
 
-    back_emplace_iterator& operator*() {
-        return *this;
-    }
+        } while ( x != T() );
 
-    back_emplace_iterator& operator++() {
-        return *this;
+        if ( neg ) * ( --p ) = '-';
+
+        if ( static_cast<std::size_t> ( last - first ) <
+                static_cast<std::size_t> ( buf + sizeof ( buf ) - p ) ) return 0L;
+
+        return std::copy ( p, buf + sizeof ( buf ), first );
+#endif
     }
 
-    back_emplace_iterator operator++ ( int ) {
-        return *this;
+    static std::size_t size ( T, int base ) {
+        return base == 10 ? std::numeric_limits<T>::digits10 + 2u
+               : std::numeric_limits<T>::digits + 2u;
     }
 
-protected:
-    Container *c_;
-};
+    static char *convert ( char *first, char *last, T x, int base ) {
 
-template<typename T, typename A> struct ContainerTraits<std::list<T, A>, false> {
+        if ( !_is_radix ( base ) ) return 0L;
 
-    typedef back_emplace_iterator<std::list<T, A> > iterator;
+        if ( base == 10 ) return convert ( first, last, x );
 
-    RATIONAL_CONSTEXPR static iterator make_iterator ( std::list<T, A>& c ) {
-        return iterator ( c );
-    }
+        char buf[std::numeric_limits<T>::digits + 2];
+        char *p = buf + sizeof ( buf );
 
-    static void clear ( std::list<T, A>& c ) {
-        c.clear();
-    }
-};
+        const bool neg = x < T();
+        const T d ( static_cast<T> ( x % base ) );
 
-template<typename T, typename A> struct ContainerTraits<std::deque<T, A>, false> {
+        * ( --p ) = _radix_digit ( static_cast<int> ( d < T() ? -d : d ), base );
 
-    typedef back_emplace_iterator<std::deque<T, A> > iterator;
+        if ( ( x = static_cast<T> ( x / base ) ) < T() ) x = static_cast<T> ( -x );
 
-    RATIONAL_CONSTEXPR static iterator make_iterator ( std::deque<T, A>& c ) {
-        return iterator ( c );
-    }
+        if ( ! ( base & ( base - 1 ) ) ) {
 
-    static void clear ( std::deque<T, A>& c ) {
-        c.clear();
-    }
-};
+            int shift = 0;
 
-template<typename T, typename A> struct ContainerTraits<std::vector<T, A>, false> {
+            while ( ( 1 << shift ) != base ) ++shift;
 
-    typedef back_emplace_iterator<std::vector<T, A> > iterator;
+            for ( ; x != T(); x = static_cast<T> ( x >> shift ) ) {
+                * ( --p ) = _radix_digit ( static_cast<int> ( x & ( base - 1 ) ), base );
+            }
 
-    RATIONAL_CONSTEXPR static iterator make_iterator ( std::vector<T, A>& c ) {
-        return iterator ( c );
-    }
+        } else {
 
-    static void clear ( std::vector<T, A>& c ) {
-        c.clear();
-    }
-};
+            for ( ; x != T(); x = static_cast<T> ( x / base ) ) {
+                * ( --p ) = _radix_digit ( static_cast<int> ( x % base ), base );
+            }
+        }
 
-#ifdef __EXCEPTIONS
-template<typename T, std::size_t N> class array_at_iterator :
-    public std::iterator<std::output_iterator_tag, void, void, void, void> {
+        if ( neg ) * ( --p ) = '-';
 
-public:
-    explicit array_at_iterator ( std::array<T, N>& c ) : c_ ( &c ), pos_ ( 0 ) {}
+        if ( static_cast<std::size_t> ( last - first ) <
+                static_cast<std::size_t> ( buf + sizeof ( buf ) - p ) ) return 0L;
 
-    array_at_iterator& operator= ( const typename std::array<T, N>::value_type& value ) {
-        c_->at ( pos_ ) = value;
-        return *this;
+        return std::copy ( p, buf + sizeof ( buf ), first );
     }
+};
+#pragma GCC diagnostic pop
 
-    array_at_iterator& operator= ( typename std::array<T, N>::value_type &&value ) {
-        c_->at ( pos_ ) = std::move ( value );
-        return *this;
-    }
+template<typename T>
+struct _to_chars_impl<T, true> {
 
-    array_at_iterator& operator*() {
-        return *this;
+    static std::size_t size ( const T& x ) {
+        std::ostringstream os;
+        os << x;
+        return os.str().size();
     }
 
-    array_at_iterator& operator++() {
-        ++pos_;
-        return *this;
+    static char *convert ( char *first, char *last, const T& x ) {
+
+        std::ostringstream os;
+        os << x;
+
+        const std::string& s ( os.str() );
+
+        if ( static_cast<std::size_t> ( last - first ) < s.size() ) return 0L;
+
+        return std::copy ( s.begin(), s.end(), first );
     }
 
-    array_at_iterator operator++ ( int ) {
-        array_at_iterator tmp ( *this );
-        ++pos_;
-        return tmp;
+    static std::size_t size ( const T& x, int base ) {
+        return base == 10 ? size ( x ) : size ( x ) << 2;
     }
 
-protected:
-    std::array<T, N> *c_;
-    typename std::array<T, N>::size_type pos_;
-};
-#endif
+    static char *convert ( char *first, char *last, const T& x, int base ) {
 
-template<typename T, std::size_t N> struct ContainerTraits<std::array<T, N>, true> {
+        if ( !_is_radix ( base ) ) return 0L;
 
-#ifdef __EXCEPTIONS
-    typedef array_at_iterator<T, N> iterator;
-#else
-    typedef typename std::array<T, N>::iterator iterator;
-#endif
+        if ( base == 10 ) return convert ( first, last, x );
 
-    RATIONAL_CONSTEXPR static iterator make_iterator ( std::array<T, N>& c ) {
-#ifdef __EXCEPTIONS
-        return iterator ( c );
-#else
-        return c.begin();
-#endif
-    }
+        const T zero = T(), b ( base );
+        std::string s;
 
-    static void clear ( std::array<T, N>& c ) {
-        c.fill ( typename std::array<T, N>::value_type() );
+        T v ( x < zero ? T ( zero - x ) : x );
+
+        do {
+
+            const T q ( v / b );
+            const T r ( v - q * b );
+
+            int d = 0;
+
+            while ( T ( d ) != r ) ++d;
+
+            s.push_back ( _radix_digit ( d, base ) );
+            v = q;
+
+        } while ( v != zero );
+
+        if ( x < zero ) s.push_back ( '-' );
+
+        if ( static_cast<std::size_t> ( last - first ) < s.size() ) return 0L;
+
+        return std::copy ( s.rbegin(), s.rend(), first );
     }
 };
-#endif
 
-template<typename Container> class ContainerPolicy {
-    typedef ContainerTraits<Container, tmp::_hasPushBack<Container>::No> traits;
+template<typename T>
+struct _radix_expand {
 
-public:
-    typedef typename traits::iterator iterator;
+    static char *expand ( char *first, char *last, T r, const T& d, int base, std::size_t n ) {
 
-    static iterator make_iterator ( Container& c ) {
-        return traits::make_iterator ( c );
-    }
+        if ( !_is_radix ( base ) || static_cast<std::size_t> ( last - first ) < n ) return 0L;
 
-    static void clear ( Container& c ) {
-        traits::clear ( c );
+        const T b ( base );
+        const bool unbounded = std::numeric_limits<T>::is_specialized &&
+                               !std::numeric_limits<T>::is_bounded;
+        const bool fast = unbounded || ( !tmp::_isClassT<T>::Yes &&
+                                         std::numeric_limits<T>::is_bounded );
+
+        for ( ; n; --n ) {
+
+            int q = 0;
+
+            if ( fast && ( unbounded || !( std::numeric_limits<T>::max() / b < r ) ) ) {
+
+                const T t ( r * b );
+                const T u ( t / d );
+
+                r = t - u * d;
+
+                while ( T ( q ) != u ) ++q;
+
+            } else {
+
+                // r * base mod d without overflowing or dividing
+                T acc = T();
+
+                for ( int i = 0; i < base; ++i ) {
+
+                    const T gap ( d - r );
+
+                    if ( acc < gap ) {
+                        acc += r;
+                    } else {
+                        acc -= gap;
+                        ++q;
+                    }
+                }
+
+                r = acc;
+            }
+
+            * ( first++ ) = _radix_digit ( q, base );
+        }
+
+        return first;
     }
 };
 
 /**
  * @ingroup main
- * @brief %Rational (fraction) template class
+ * @brief Traits struct to write a storage type as characters
  *
- * @note All %Rational objects are reduced (see @ref gcd)
+ * Built-in integer types are written without any stream involved (using
+ * @c std::to_chars if available), class types fall back to their @c operator<<.
  *
- * @tparam T storage type
- * @tparam GCD GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ * Specialize it to speed up Commons::Math::to_chars() and Rational::str() for
+ * custom storage types. A specialization has to provide
+ * * @c size(x) returning the amount of chars @c convert() needs at most for @c x
+ * * @c convert(first, last, x) writing @c x to @c [first, last) and returning the pointer
+ *   past the last char written, or @c 0L if the range is too small
+ *
+ * and for the output in other bases than @c 10 the overloads @c size(x, base) and
+ * @c convert(first, last, x, base), where @c convert() returns @c 0L for bases outside
+ * @c 2 and @c 62.
+ *
+ * @tparam T the storage type
  */
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD = GCD_euclid_fast,
-         template<class, typename = T, bool = std::numeric_limits<T>::is_signed>
-         class CHKOP = NO_OPERATOR_CHECK, template<typename> class Alloc = std::allocator>
-class Rational {
+template<typename T>
+struct ToCharsTraits : _to_chars_impl<T, tmp::_isClassT<T>::Yes> {};
 
-#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
-    static_assert ( std::is_integral<T>::value || std::numeric_limits<T>::is_integer,
-                    "only integer types are allowed as storage type" );
-#endif
+/**
+ * @ingroup main
+ * @brief Traits struct to expand a proper fraction into digits of a positional numeral system
+ *
+ * The default implementation calculates one digit per step. Specialize it for storage
+ * types supporting fast big divisions (i.e. @c mpz_class) to calculate many digits at once.
+ *
+ * A specialization has to provide @c expand(first, last, r, d, base, n) writing the first
+ * @c n digits of @f$ \frac{r}{d} @f$ (@f$ 0 \leq r < d @f$) in base @c base to
+ * @c [first, last) and returning the pointer past the last digit, or @c 0L if the range
+ * is too small or @c base is outside @c 2 and @c 62.
+ *
+ * @see Commons::Math::to_chars_fixed()
+ *
+ * @tparam T the storage type
+ */
+template<typename T>
+struct RadixExpandTraits : _radix_expand<T> {};
 
-    friend struct _swapSign<T, GCD, CHKOP, Alloc, std::numeric_limits<T>::is_signed>;
-    friend struct _mod<T, GCD, CHKOP, Alloc, std::numeric_limits<T>::is_signed>;
-    template<typename, template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class, template<class, typename, bool> class,
-             template<typename> class, typename, bool, template<typename> class,
-             template<typename> class> friend struct _approxFract;
-public:
-    typedef typename RationalTraits<T>::integer_type integer_type; ///< storage type
+template<typename T>
+struct _radix_power {
 
-#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
-    template<class Op, typename CT = T,
-             bool IS = std::numeric_limits<CT>::is_signed> using chkop = CHKOP<Op, CT, IS>;
-    template<typename GT = T, bool IS = std::numeric_limits<GT>::is_signed,
-             template<class, typename = GT, bool = IS> class CO = chkop,
-             template<typename> class CV = TYPE_CONVERT> using gcd = GCD<GT, IS, CO, CV>;
-    template<typename AT = T> using alloc = Alloc<AT>;
-#endif
+    static std::size_t digits ( T x, int base ) {
 
-    /**
-     * @brief type of the return value of mod()
-     *
-     * This type is based on @c std::pair, where @c first is the integral value and @c second the
-     * fractional part
-     */
-    typedef typename _mod<integer_type, GCD, CHKOP, Alloc,
-            std::numeric_limits<integer_type>::is_signed>::pair_type mod_type;
+        const T b ( base );
+        std::size_t n = 0u;
 
-    /**
-     * @brief addition (@c a @b + @c b) operator
-     */
-    typedef CHKOP<std::plus<T> > op_plus;
+        for ( ; x != T(); x = x / b ) ++n;
 
-    /**
-     * @brief subtraction (@c a @b - @c b) operator
-     */
-    typedef CHKOP<std::minus<T> > op_minus;
+        return n;
+    }
 
-    /**
-     * @brief subtraction (@c a @b - @c b) operator
-     */
-    typedef CHKOP<std::negate<T> > op_negate;
+    static T pow ( int base, std::size_t n ) {
 
-    /**
-     * @brief multiplication (@c a @b * @c b) operator
-     */
-    typedef CHKOP<std::multiplies<T> > op_multiplies;
+        T r ( 1 ), b ( base );
 
-    /**
-     * @brief division (@c a @b / @c b) operator
-     */
-    typedef CHKOP<std::divides<T> > op_divides;
+        // never squares beyond the result to not overflow bounded types needlessly
+        while ( true ) {
 
-    /**
-     * @brief modulus (@c a @b % @c b) operator
-     */
-    typedef CHKOP<std::modulus<T> > op_modulus;
+            if ( n & 1u ) r = r * b;
 
-    /**
-     * @brief creates a default (null) %Rational
-     *
-     * Creates a fraction @f$ \frac{0}{1} @f$
-     */
-    RATIONAL_CONSTEXPR Rational() : m_numer (), m_denom ( one_ ) {}
+            if ( ! ( n >>= 1 ) ) break;
 
-    /**
-     * @brief creates a %Rational
-     *
-     * Creates a copy of @c numer and divides it by @c denom
-     *
-     * @note to achieve a continued faction like \f$\frac{1}{\frac{1}{2}}\f$ you must explicitely
-     * cast the @em numerator, i.e.
-     * @code const Rational<rational_type> x ( Rational<rational_type> ( 1 ),
-     *   Rational<rational_type> ( 1,2 )); @endcode
-     *
-     * @tparam U1 GCD algorithm of the numerator
-     * @tparam V1 operator checker of the numerator
-     *
-     * @tparam U2 GCD algorithm of the denominator
-     * @tparam V2 operator checker of the denominator
-     *
-     * @param[in] numer the numerator
-     * @param[in] denom the denominator
-     */
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U1,
-             template<class, typename, bool> class V1, template<typename> class Alloc1,
-             template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U2,
-             template<class, typename, bool> class V2, template<typename> class Alloc2>
-    Rational ( const Rational<integer_type, U1, V1, Alloc1>& numer,
-               const Rational<integer_type, U2, V2, Alloc2>& denom ) :
-        m_numer ( numer.numerator() ), m_denom ( numer.denominator() ) {
-        *this *= denom.inverse();
+            b = b * b;
+        }
+
+        return r;
     }
+};
 
-    /**
-     * @brief creates a %Rational
-     *
-     * Creates a fraction @f$ \frac{numer}{denom} @f$
-     *
-     * @param[in] numer the numerator
-     * @param[in] denom the denominator
-     */
-    Rational ( const integer_type& numer, const integer_type& denom );
+/**
+ * @ingroup main
+ * @brief Traits struct for exact integer powers and digit counts in a base
+ *
+ * The default implementation counts digits by repeated division and calculates powers
+ * by squaring. Specialize it for storage types with faster means (i.e. @c mpz_class).
+ *
+ * A specialization has to provide
+ * * @c digits(x, base) returning the amount of digits of @c x @f$ \geq 0 @f$ in base
+ *   @c base, where @c 0 has no digits
+ * * @c pow(base, n) returning @f$ base^n @f$
+ *
+ * @see Commons::Math::Rational::Rational(const rf_info&)
+ *
+ * @tparam T the storage type
+ */
+template<typename T>
+struct RadixPowerTraits : _radix_power<T> {};
 
-    /**
-     * @brief creates a inproper (mixed) %Rational
-     *
-     * Creates a fraction @f$ whole + \frac{numer}{denom} @f$
-     *
-     * @param[in] whole whole number part
-     * @param[in] numer the numerator
-     * @param[in] denom the denominator
-     */
-    Rational ( const integer_type& whole, const integer_type& numer,
-               const integer_type& denom ) : m_numer (), m_denom ( one_ ) {
-        *this += Rational ( numer, denom ) += Rational ( whole );
-    }
+template<typename T>
+struct _cf_expand {
 
-    /**
-     * @brief creates an approximated %Rational
-     *
-     * @b Example: \n @c Commons::Math::Rational<uint64_t>( std::sqrt( 2.0l ) )
-     * to get @f$ \sqrt{2} \approx \frac{6333631924}{4478554083} @f$
-     *
-     * @see Commons::Math::EPSILON to control the quality of the approximation
-     *
-     * @tparam NumberType type of the number to approximate
-     *
-     * @param[in] number the number to create an approximated %Rational of
-     */
-    template<typename NumberType>
-    Rational ( const NumberType& number );
+    template<class OIter>
+    static OIter expand ( T u, T v, OIter out, bool neg ) {
 
-    /**
-     * @brief creates a %Rational approximated by an expression
-     *
-     * If @c expr is not @c null and not empty then it is parsed and evaluated as
-     * @c long @c double expression and approximated to a fraction.
-     *
-     * The @em expression can be a simple infix arithmetic expression containing
-     *
-     * * addition (@c +); also @em unary
-     * * subtraction (@c -); also @em unary
-     * * multiplication (@c *)
-     * * division (@c /)
-     * * modulus (@c %)
-     * * parenthesises
-     *
-     * Numbers can be integers or floats in non-scientific notation. Allowed are spaces, tabs
-     * and newlines around numbers, parenthesises and operators.
-     *
-     * The expression gets evaluated into a sequence of Commons::Math::Rational terms. Floats
-     * are approximated using @c ExpressionEvalTraits<integer_type> as float number type.\n
-     * @c ExpressionEvalTraits<integer_type> corresponds to @c long @c double if not specialized
-     *
-     * In case of errors an @c std::runtime_exception is thrown if exceptions are enabled,
-     * else the result is undefined.
-     *
-     * @b Example: \n @code{.cpp}
-     * Rational<long> x ( "(11/2) * +(4.25+3.75)" );@endcode produces the fraction
-     * @f$x = \frac{44}{1}@f$
-     *
-     * @see Rational(const NumberType& number)
-     * @see ExpressionEvalTraits
-     *
-     * @param[in] expr the expression to evaluate and approximate
-     */
-    Rational ( const char *expr ) : m_numer(), m_denom ( one_ ) {
-        *this = RATIONAL_MOVE ( eval ( expr ) );
-    }
+        do {
 
-    ~Rational();
+            const T q ( u / v );
+            const T r ( u - q * v );
 
-    /**
-     * @brief assigns from a @c NumberType
-     *
-     * The @c number is approximated to a %Rational, then it gets assigned
-     *
-     * @see Rational(const NumberType& number)
-     * @see Commons::Math::EPSILON
-     *
-     * @tparam NumberType type of the number to approximate
-     *
-     * @param[in] number the number to assign
-     */
-    template<typename NumberType>
-    Rational& operator= ( const NumberType& number ) {
-        return ( *this = RATIONAL_MOVE ( Rational ( number ) ) );
-    }
+            * ( out++ ) = neg ? T ( -q ) : q;
 
-#ifndef __clang__
-    operator void() const RATIONAL_NOEXCEPT {}
-#endif
+            u = v;
+            v = r;
 
-    /**
-     * @brief convert to @c NumberType
-     *
-     * @tparam NumberType type of the number to approximate
-     *
-     * @return the number value of the %Rational
-     */
-    template<typename NumberType>
-    RATIONAL_CONSTEXPR operator NumberType() const {
-        return typename RationalTraits<integer_type>::type_convert ( m_numer ).
-               template convert<NumberType>() /
-        typename RationalTraits<integer_type>::type_convert ( m_denom ).
-        template convert<NumberType>();
-    }
+        } while ( v != T() );
 
-    /**
-     * @brief gets the numerator
-     *
-     * @return the numerator
-     */
-    RATIONAL_CONSTEXPR integer_type numerator() const RATIONAL_NOEXCEPT {
-        return m_numer;
+        return out;
     }
+};
 
-    /**
-     * @brief gets the denominator
-     *
-     * @return the denominator
-     */
-    RATIONAL_CONSTEXPR integer_type denominator() const RATIONAL_NOEXCEPT {
-        return m_denom;
-    }
+/**
+ * @ingroup main
+ * @brief Traits struct to extract the partial quotients of a continued fraction
+ *
+ * The default implementation runs the euclidean algorithm on numerator and denominator
+ * directly. Specialize it for storage types where a step on the full numbers is expensive
+ * (i.e. @c mpz_class, where several quotients are calculated from the leading words at once).
+ *
+ * A specialization has to provide @c expand(u, v, out, neg) writing the partial quotients
+ * of @f$ \frac{u}{v} @f$ (@f$ u \geq 0 @f$, @f$ v > 0 @f$) to @c out, each negated if
+ * @c neg is @c true, and returning @c out.
+ *
+ * @see Commons::Math::seq()
+ *
+ * @tparam T the storage type
+ */
+template<typename T>
+struct ContinuedFractionTraits : _cf_expand<T> {};
 
-    /**
-     * @brief checks if @c m describes an integer @f$\neq 0@f$
-     *
-     * @see Commons::Math::Rational::mod()
-     *
-     * @param[in] m a mod_type
-     *
-     * @return @c true if @c describes an integer @f$\neq 0@f$, @c false otherwise
-     */
-    static bool isInteger ( const mod_type& m ) {
-        return std::not_equal_to<typename mod_type::first_type>() ( m.first, zero_ ) &&
-               m.second.numerator() == zero_;
-    }
+template<typename T, bool IsClass>
+struct _from_chars_impl;
 
-    /**
-     * @copybrief
-     * @overload
-     */
-    bool isInteger () const {
-        return isInteger ( mod() );
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic push
+template<typename T>
+struct _from_chars_impl<T, false> {
+
+    static const char *convert ( const char *first, const char *last, T& x ) {
+
+        if ( first == last || *first < '0' || *first > '9' ) return 0L;
+
+#if __cplusplus >= 201703L
+        const std::from_chars_result &r ( std::from_chars ( first, last, x ) );
+        return r.ec == std::errc() ? r.ptr : 0L;
+#else
+        T v = T();
+
+        for ( ; first != last && *first >= '0' && *first <= '9'; ++first ) {
+
+            const T d ( static_cast<T> ( *first - '0' ) );
+
+            if ( v > ( std::numeric_limits<T>::max() - d ) / 10 ) return 0L;
+
+            v = static_cast<T> ( v * 10 + d );
+        }
+
+        x = v;
+
+        return first;
+#endif
     }
+};
+#pragma GCC diagnostic pop
 
-    /**
-     * @brief Structure holding a description of a repeating fraction
-     *
-     * @see Commons::Math::Rational::decompose()
-     * @see Commons::Math::Rational::rf()
-     */
-    typedef struct _rf_info {
+template<typename T>
+struct _from_chars_impl<T, true> {
 
-        typedef typename DecomposeBaseTraits<integer_type,
-                std::numeric_limits<integer_type>::is_signed>::digit_type digit_type;
+    static const char *convert ( const char *first, const char *last, T& x ) {
 
-        RATIONAL_NOCOPYASSIGN ( _rf_info );
+        const char *e = first;
+
+        while ( e != last && *e >= '0' && *e <= '9' ) ++e;
+
+        if ( e == first ) return 0L;
+
+        x = TYPE_CONVERT<const char *> ( first, e ).template convert<T>();
+
+        return e;
+    }
+};
+
+/**
+ * @ingroup main
+ * @brief Traits struct to read a storage type from decimal characters
+ *
+ * The counterpart of Commons::Math::ToCharsTraits. Built-in integer types are read without
+ * any stream involved, class types fall back to their @c operator>>.
+ *
+ * A specialization has to provide @c convert(first, last, x) reading the unsigned decimal
+ * digits at the begin of @c [first, last) into @c x and returning the pointer past the last
+ * digit read, or @c 0L if there is no digit or the value does not fit into @c T.
+ *
+ * @tparam T the storage type
+ */
+template<typename T>
+struct FromCharsTraits : _from_chars_impl<T, tmp::_isClassT<T>::Yes> {};
+
+template<typename T, bool IsClass>
+struct _serialize_impl;
 
 #pragma GCC diagnostic ignored "-Wtype-limits"
 #pragma GCC diagnostic push
-        _rf_info ( const integer_type& r, std::size_t lz = 0u,
-                   const integer_type& p = integer_type(),  std::size_t plz = 0u ) :
-            reptend ( r ), leading_zeros ( lz ), pre ( p ), pre_leading_zeros ( plz ),
-            negative ( r < zero_ || p < zero_ ) {}
-#pragma GCC diagnostic pop
+template<typename T>
+struct _serialize_impl<T, false> {
 
-        _rf_info() : reptend(), leading_zeros ( 0u ), pre(), pre_leading_zeros ( 0u ),
-            negative ( false ) {}
+    // zig-zag encoding: the first byte holds the sign and the lowest 6 bits of x or ~x
+    static std::size_t size ( T x ) {
 
-        integer_type reptend; ///< the repeating part as integer_type
-        std::size_t leading_zeros; ///< the amount of zeros at the beginning of @c reptend
-        integer_type pre; ///< the digits before @c reptend as integer_type
-        std::size_t pre_leading_zeros; ///< the amount of zeros at the beginning of @c pre
+        std::size_t n = 1u;
 
-        bool negative; ///< @c true if the decimal is negative, @c false otherwise
+        for ( x = static_cast<T> ( ( x < T() ? ~x : x ) >> 6 ); x != T(); x >>= 7 ) ++n;
 
-    } rf_info;
+        return n;
+    }
 
-    /**
-     * @ingroup main
-     * @brief Constructs a fraction from a repeating decimal
-     *
-     * @see Commons::Math::Rational::decompose()
-     *
-     * The fraction is calculated by the formula: \n \n
-     * @f$ \frac{\displaystyle{\mathrm{pre}} + \frac{\displaystyle{\mathrm{reptend}}}{\begin{cases}
-     * \displaystyle{1} & \displaystyle{\text{if } \mathrm{x} = 0} \\
-     * \displaystyle{10^{\displaystyle{\lceil\log_{10}(|\mathrm{reptend}| + 1)\rceil +
-     * \mathrm{leading\_zeros}}} - 1} & \displaystyle{\text{if } \mathrm{x} \neq 0}
-     * \end{cases}}}{\displaystyle{10}^{\displaystyle{\displaystyle{\lceil\log_{10}(|\mathrm{pre}|
-     * + 1)\rceil + \mathrm{pre\_leading\_zeros}}}}} @f$
-     *
-     * @remarks
-     * * to get an intuitive result @c reptend and @c pre should be positive numbers
-     * * the resulting fraction will be within @f$ 0 \leq x \leq 1@f$, where @f$ x @f$ is the
-     * decimal value of the fraction
-     *
-     * @b Examples: \n
-     * * to construct a fraction representing
-     *   @f$\frac{13717421}{111111111} = 0.\overline{123456789}@f$ you'll need to write: @code{.cpp}
-     * Commons::Math::Rational<long> frac =
-     *      Commons::Math::Rational<long>(Commons::Math::rf_info(123456789));@endcode
-     * * to construct a fraction representing
-     *   @f$\frac{667}{6000} = 0.1111\overline{66}@f$ you'll need to write: @code{.cpp}
-     * Commons::Math::Rational<long> frac =
-     *      Commons::Math::Rational<long>(Commons::Math::rf_info(6, 0, 1111));@endcode
-     *
-     * @param[in] info a repeating decimal description
-     */
-    Rational ( const rf_info& info );
+    static unsigned char *write ( unsigned char *first, unsigned char *last, T x ) {
 
-    /**
-     * @brief Splits a fraction in it's whole and repetitive part
-     *
-     * @tparam PreC container type to store pre digit sequences
-     * @tparam RepC container type to store reptend digit sequences
-     *
-     * @param[out] rf_info rf_info structure to store the result
-     * @param[out] pre_digits Container to store the pre-digits
-     * @param[out] reptend_digits Container to store the reptend-digits
-     * @param[in] digitsOnly omit calculation of @c rf_info.pre and @c rf_info.reptend
-     * @param[in] base the base, defaults to integer_type (10) as a decimal base
-     *
-     * @return the whole part of the fraction
-     */
-    template<class PreC, class RepC>
-    integer_type decompose ( rf_info& rf_info, PreC& pre_digits, RepC& reptend_digits,
-                             bool digitsOnly ) const;
-    /**
-     * @overload
-     */
-    template<class PreC, class RepC>
-    integer_type decompose ( rf_info& rf_info, PreC& pre_digits, RepC& reptend_digits ) const {
-        return decompose ( rf_info, pre_digits, reptend_digits, false );
-    }
+        const bool neg = x < T();
+        T m = neg ? static_cast<T> ( ~x ) : x;
 
-    template<typename IIter>
-    static Rational eval ( IIter first, IIter last );
+        if ( first == last ) return 0L;
 
-    Rational eval ( const char *expr ) const;
+        unsigned char b = static_cast<unsigned char> ( ( ( m & 0x3f ) << 1 ) | neg );
 
-    /**
-     * @brief extract the integral and fractional part
-     *
-     * each part has the same sign as the Rational
-     *
-     * @see mod_type
-     *
-     * @return a @c mod_type containing the integral and fractional part
-     */
-    RATIONAL_CONSTEXPR mod_type mod() const;
+        for ( m = static_cast<T> ( m >> 6 ); m != T(); m = static_cast<T> ( m >> 7 ) ) {
 
-    /**
-     * @brief gets the absolute %Rational
-     *
-     * Returns for @em signed types
-     * @c ( this->numerator() < T() ? -(*this) : (*this) )
-     * and for @em unsigned types @c (*this)
-     *
-     * @return a copy of the absolute %Rational
-     */
-    RATIONAL_CONSTEXPR Rational abs() const {
-        return _abs<integer_type, GCD, CHKOP, Alloc,
-               std::numeric_limits<integer_type>::is_signed>() ( *this );
-    }
+            * ( first++ ) = static_cast<unsigned char> ( b | 0x80 );
 
-    /**
-     * @brief gets the a new %Rational raised to the power of @c exp
-     *
-     * If overflows can get ruled out (i.e. with use of Commons::Math::gmp_rational),
-     * you can speed up the calculation by initializing a %Rational with
-     * Commons::Math::GCD_null and initializing the resulting power in a %Rational
-     * with the desired GCD: @code{.cpp}
-     * const Commons::Math::gmp_rational r(3, 4);
-     *
-     * typedef Commons::Math::Rational<Commons::Math::gmp_rational::integer_type,
-     *         Commons::Math::GCD_null, Commons::Math::NO_OPERATOR_CHECK> gmp_nogcd_rational;
-     *
-     * const gmp_nogcd_rational& nr(gmp_nogcd_rational(r.numerator(), r.denominator()).pow(256));
-     *
-     * std::cout << Commons::Math::gmp_rational(nr.numerator(), nr.denominator())
-     *           << std::endl;@endcode
-     *
-     * @warning negative values or zero can cause undefined behaviour if compiled
-     * without exceptions
-     *
-     * @param[in] exp the exponent to raise this %Rational
-     * @return a copy of the absolute %Rational raised to the power of @c exp
-     */
-    Rational pow ( const integer_type& exp ) const {
-        return _pow<integer_type, GCD, CHKOP, Alloc,
-               std::numeric_limits<integer_type>::is_signed>() ( *this, exp );
+            if ( first == last ) return 0L;
+
+            b = static_cast<unsigned char> ( m & 0x7f );
+        }
+
+        * ( first++ ) = b;
+
+        return first;
     }
 
-    /**
-     * @brief gets the square root as a new %Rational
-     *
-     * @return a square root copy of %Rational
-     */
-    Rational sqrt() const;
+    static const unsigned char *read ( const unsigned char *first, const unsigned char *last,
+                                       T& x, bool *more = 0L ) {
 
-    /**
-     * @brief inverts the %Rational
-     *
-     * @b Example: \n @f$ \frac{-5}{12} @f$ will become to @f$ \frac{-12}{5} @f$
-     *
-     * @return the inverted %Rational
-     */
-    Rational& invert();
+        if ( more ) *more = first == last;
 
-    /**
-     * @brief gets a copy of the inverted %Rational
-     *
-     * @see invert()
-     *
-     * @return a copy of the inverted %Rational
-     */
-    RATIONAL_CONSTEXPR Rational inverse() const;
+        if ( first == last ) return 0L;
 
-    /**
-     * @brief add and assign a %Rational
-     *
-     * @param[in] other the %Rational to add and assign
-     *
-     * @return the %Rational
-     */
-    Rational& operator+= ( const Rational& other ) {
-        return knuth_addSub<op_plus> ( other );
-    }
+        const bool neg = *first & 1;
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend Rational& operator+= ( Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( x += Rational ( y.numerator(), y.denominator() ) );
-    }
+        if ( neg && !std::numeric_limits<T>::is_signed ) return 0L;
 
-    /**
-     * @brief add a %Rational
-     *
-     * @param[in] other the %Rational to add
-     *
-     * @return a new %Rational
-     */
-    RATIONAL_CONSTEXPR Rational operator+ ( const Rational& other ) const;
+        T m = static_cast<T> ( ( *first >> 1 ) & 0x3f );
+        int shift = 6;
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend Rational operator+ ( const Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( Rational ( x ) += Rational ( y.numerator(), y.denominator() ) );
-    }
+        while ( * ( first++ ) & 0x80 ) {
 
-    /**
-     * @brief get a copy of the %Rational
-     *
-     * @return a copy of %Rational
-     */
-    RATIONAL_CONSTEXPR Rational operator+() const {
-        return Rational ( *this );
-    }
+            if ( first == last ) {
+                if ( more ) *more = true;
+                return 0L;
+            }
 
-    /**
-     * @brief pre-increment a %Rational
-     *
-     * the result will be
-     * @f$ \frac{numerator + denominator}{denominator} \Rightarrow numerator + 1@f$
-     *
-     * @return the incremented %Rational
-     */
-    Rational& operator++() {
-        m_numer = RATIONAL_MOVE ( op_plus() ( m_numer, m_denom ) );
-        return reduce();
-    }
+            const unsigned int g = *first & 0x7fu;
 
-    /**
-     * @brief post-increment a %Rational
-     *
-     * @see operator++()
-     *
-     * @return a copy of %Rational
-     */
-    Rational operator++ ( int ) {
-        Rational tmp ( *this );
-        ++*this;
-        return tmp;
-    }
+            if ( g && ( shift >= std::numeric_limits<T>::digits ||
+                        ( std::numeric_limits<T>::digits - shift < 7 &&
+                          g >> ( std::numeric_limits<T>::digits - shift ) ) ) ) return 0L;
 
-    /**
-     * @brief subtract and assign a %Rational
-     *
-     * @param[in] other the %Rational to subtract and assign
-     *
-     * @return the %Rational
-     */
-    Rational& operator-= ( const Rational& other ) {
-        return knuth_addSub<op_minus> ( other );
-    }
+            if ( shift < std::numeric_limits<T>::digits ) {
+                m = static_cast<T> ( m | ( T ( g ) << shift ) );
+            }
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend Rational& operator-= ( Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( x -= Rational ( y.numerator(), y.denominator() ) );
-    }
+            shift += 7;
+        }
 
-    /**
-     * @brief subtract a %Rational
-     *
-     * @param[in] other the %Rational to subtract
-     *
-     * @return a new %Rational
-     */
-    RATIONAL_CONSTEXPR Rational operator- ( const Rational& other ) const {
-        return ( Rational ( *this ) -= other );
-    }
+        x = neg ? static_cast<T> ( ~m ) : m;
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend Rational operator- ( const Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( Rational ( x ) -= Rational ( y.numerator(), y.denominator() ) );
+        return first;
     }
+};
+#pragma GCC diagnostic pop
 
-    /**
-     * @brief get a negated copy of the %Rational
-     *
-     * @return a negated copy of %Rational
-     */
-    Rational operator-() const {
-        Rational tmp ( *this );
-        tmp.m_numer = RATIONAL_MOVE ( op_negate() ( tmp.m_numer ) );
-        return tmp;
+template<typename T>
+struct _serialize_impl<T, true> {
+
+    // length and sign prefixed decimal digits
+    static std::size_t size ( const T& x ) {
+        const std::size_t n = ToCharsTraits<T>::size ( x );
+        return _serialize_impl<std::size_t, false>::size ( n << 1 ) + n;
     }
 
-    /**
-      * @brief pre-decrement a %Rational
-      *
-      * the result will be
-      * @f$ \frac{numerator - denominator}{denominator} \Rightarrow numerator - 1@f$
-      *
-      * @return the incremented %Rational
-      */
-    Rational& operator--() {
-        m_numer = RATIONAL_MOVE ( op_minus() ( m_numer, m_denom ) );
-        return reduce();
-    }
+    static unsigned char *write ( unsigned char *first, unsigned char *last, const T& x ) {
 
-    /**
-     * @brief post-decrement a %Rational
-     *
-     * @see operator--()
-     *
-     * @return a copy of %Rational
-     */
-    Rational operator-- ( int ) {
-        Rational tmp ( *this );
-        --*this;
-        return tmp;
-    }
+        std::vector<char> buf ( ToCharsTraits<T>::size ( x ) );
 
-    /**
-     * @brief multiply and assign a %Rational
-     *
-     * @param[in] other the %Rational to multiply and assign
-     *
-     * @return the %Rational
-     */
-    Rational& operator*= ( const Rational& other );
+        const char *b = &buf[0];
+        const char *e = ToCharsTraits<T>::convert ( &buf[0], &buf[0] + buf.size(), x );
+        const bool neg = e && b != e && *b == '-';
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend Rational& operator*= ( Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( x *= Rational ( y.numerator(), y.denominator() ) );
+        if ( !e ) return 0L;
+
+        if ( neg ) ++b;
+
+        const std::size_t n = static_cast<std::size_t> ( e - b );
+
+        if ( ! ( first = _serialize_impl<std::size_t, false>::write ( first, last,
+                         ( n << 1 ) | neg ) ) || static_cast<std::size_t> ( last - first ) < n ) {
+            return 0L;
+        }
+
+        return std::copy ( b, e, first );
     }
 
-    /**
-     * @brief multiply a %Rational
-     *
-     * @param[in] other the %Rational to multiply
-     *
-     * @return a new %Rational
-     */
-    RATIONAL_CONSTEXPR Rational operator* ( const Rational& other ) const;
+    static const unsigned char *read ( const unsigned char *first, const unsigned char *last,
+                                       T& x, bool *more = 0L ) {
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend Rational operator* ( const Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( Rational ( x ) *= Rational ( y.numerator(), y.denominator() ) );
+        std::size_t h;
+
+        if ( ! ( first = _serialize_impl<std::size_t, false>::read ( first, last, h, more ) ) ) {
+            return 0L;
+        }
+
+        if ( static_cast<std::size_t> ( last - first ) < ( h >> 1 ) ) {
+            if ( more ) *more = true;
+            return 0L;
+        }
+
+        const std::vector<char> buf ( first, first + ( h >> 1 ) );
+
+        if ( buf.empty() || FromCharsTraits<T>::convert ( &buf[0], &buf[0] + buf.size(), x ) !=
+                &buf[0] + buf.size() ) return 0L;
+
+        if ( h & 1 ) x = -x;
+
+        return first + ( h >> 1 );
     }
+};
 
-    /**
-     * @brief divide and assign a %Rational
-     *
-     * @param[in] other the %Rational to divide and assign
-     *
-     * @return the %Rational
-     */
-    Rational& operator/= ( const Rational& other ) {
-        return ( *this *= other.inverse() );
+/**
+ * @ingroup main
+ * @brief Traits struct to serialize a storage type into a compact binary format
+ *
+ * Built-in integer types are written as zig-zag encoded variable length integers,
+ * other class types as length prefixed decimal digits. The format doesn't depend on
+ * the endianess or word size of the machine.
+ *
+ * A specialization has to provide
+ * * @c size(x) returning the amount of bytes @c write() needs at most for @c x
+ * * @c write(first, last, x) writing @c x to @c [first, last) and returning the pointer
+ *   past the last byte written, or @c 0L if the range is too small
+ * * @c read(first, last, x, more) reading @c x from @c [first, last) and returning the
+ *   pointer past the last byte read, or @c 0L if the range is too small or contains garbage.
+ *   If @c more isn't @c 0L, it is set to @c true if the range ends within @c x, and to
+ *   @c false otherwise
+ *
+ * @see Commons::Math::serialize()
+ *
+ * @tparam T the storage type
+ */
+template<typename T>
+struct SerializeTraits : _serialize_impl<T, tmp::_isClassT<T>::Yes> {};
+
+inline std::size_t _hash_combine ( std::size_t h, std::size_t v ) {
+    return h ^ ( v + static_cast<std::size_t> ( 0x9e3779b9u ) + ( h << 6 ) + ( h >> 2 ) );
+}
+
+template<typename T, bool IsClass>
+struct _hash_impl;
+
+template<typename T>
+struct _hash_impl<T, false> {
+
+    // the value itself, types wider than std::size_t folded
+    static std::size_t hash ( const T& x ) {
+
+        const std::size_t w = sizeof ( std::size_t );
+        std::size_t h = static_cast<std::size_t> ( x );
+
+        for ( std::size_t i = w; i < sizeof ( T ); i += w ) {
+            h = _hash_combine ( h, static_cast<std::size_t> ( x >> ( i << 3 ) ) );
+        }
+
+        return h;
     }
+};
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend Rational& operator/= ( Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( x /= Rational ( y.numerator(), y.denominator() ) );
+template<typename T>
+struct _hash_impl<T, true> {
+
+    // FNV-1a of the decimal digits
+    static std::size_t hash ( const T& x ) {
+
+        std::vector<char> buf ( ToCharsTraits<T>::size ( x ) );
+
+        const char *e = ToCharsTraits<T>::convert ( &buf[0], &buf[0] + buf.size(), x );
+        std::size_t h = static_cast<std::size_t> ( 2166136261u );
+
+        for ( const char *i = &buf[0]; i != e; ++i ) {
+            h = ( h ^ static_cast<unsigned char> ( *i ) ) * static_cast<std::size_t> ( 16777619u );
+        }
+
+        return h;
     }
+};
 
-    /**
-     * @brief divide a %Rational
-     *
-     * @param[in] other the %Rational to divide
-     *
-     * @return a new %Rational
-     */
-    RATIONAL_CONSTEXPR Rational operator/ ( const Rational& other ) const {
-        return ( Rational ( *this ) /= other );
+/**
+ * @ingroup main
+ * @brief Traits struct to hash a storage type
+ *
+ * Built-in integer types are hashed by their value, other class types by their decimal
+ * digits. Specialize it for storage types, which give access to their representation
+ * (i.e. @c mpz_class, which is hashed limb-wise).
+ *
+ * A specialization has to provide @c hash(x) returning the @c std::size_t hash of @c x,
+ * equal for equal values.
+ *
+ * @see std::hash<Commons::Math::Rational>
+ *
+ * @tparam T the storage type
+ */
+template<typename T>
+struct HashTraits : _hash_impl<T, tmp::_isClassT<T>::Yes> {};
+
+// the fraction has to be reduced
+template<class R>
+std::size_t _rational_hash ( const R& r ) {
+    return _hash_combine ( HashTraits<typename R::integer_type>::hash ( r.numerator() ),
+                           HashTraits<typename R::integer_type>::hash ( r.denominator() ) );
+}
+
+inline int _rational_delimiter_index() {
+    static const int idx = std::ios_base::xalloc();
+    return idx;
+}
+
+struct _rational_delimiter {
+    char d;
+};
+
+/**
+ * @ingroup main
+ * @brief stream manipulator to set the record delimiter of a Rational extraction
+ *
+ * By default a record ends at whitespace, unless the expression obviously continues
+ * (i.e. at an operator or inside braces). With a delimiter set, a record ends at
+ * @c d or at the end of the line, and blanks are part of the expression.
+ *
+ * @code
+ * std::istringstream is ( "1/2 + 1, 3/4" );
+ * Commons::Math::Rational<long> a, b;
+ * is >> Commons::Math::rational_delimiter ( ',' ) >> a >> b; // a == 1 1/2, b == 3/4
+ * @endcode
+ *
+ * @param[in] d the delimiter, @c 0 restores the default
+ */
+inline _rational_delimiter rational_delimiter ( char d ) {
+    const _rational_delimiter r = { d };
+    return r;
+}
+
+inline std::istream& operator>> ( std::istream& i, _rational_delimiter d ) {
+    i.iword ( _rational_delimiter_index() ) = d.d;
+    return i;
+}
+
+template<class> class RationalReader;
+template<class> class RationalDigits;
+template<class> class RationalConvergents;
+template<class> class FareySequence;
+template<typename, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class, template<class, typename, bool> class,
+         template<typename> class> class AtomicRational;
+
+template<typename Container>
+inline void _container_reserve ( Container&, std::size_t ) {}
+
+template<typename T, typename A>
+inline void _container_reserve ( std::vector<T, A>& c, std::size_t n ) {
+    c.reserve ( c.size() + n );
+}
+
+template<typename Container, bool ExplicitEnd>
+struct ContainerTraits;
+
+template<typename Container>
+struct ContainerTraits<Container, true> {
+
+    typedef std::insert_iterator<Container> iterator;
+
+    RATIONAL_CONSTEXPR static iterator make_iterator ( Container& c ) {
+        return iterator ( c, c.end() );
     }
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend Rational operator/ ( const Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( Rational ( x ) /= Rational ( y.numerator(), y.denominator() ) );
+    static void clear ( Container& c ) {
+        c.clear();
     }
+};
 
-    /**
-     * @brief modulo and assign a %Rational
-     *
-     * @param[in] other the %Rational to modulo and assign
-     *
-     * @return the %Rational
-     */
-    Rational& operator%= ( const Rational& other );
+template<typename Container>
+struct ContainerTraits<Container, false> {
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend Rational& operator%= ( Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( x %= Rational ( y.numerator(), y.denominator() ) );
+    typedef std::back_insert_iterator<Container> iterator;
+
+    RATIONAL_CONSTEXPR static iterator make_iterator ( Container& c ) {
+        return iterator ( c );
     }
 
-    /**
-     * @brief modulo a %Rational
-     *
-     * @param[in] other the %Rational to modulo
-     *
-     * @return a new %Rational
-     */
-    RATIONAL_CONSTEXPR Rational operator% ( const Rational& other ) const {
-        return ( Rational ( *this ) %= other );
+    static void clear ( Container& c ) {
+        c.clear();
     }
+};
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend Rational operator% ( const Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( Rational ( x ) %= Rational ( y.numerator(), y.denominator() ) );
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+template<typename Container> class back_emplace_iterator :
+    public std::iterator<std::output_iterator_tag, void, void, void, void> {
+public:
+    typedef Container container_type;
+
+    explicit back_emplace_iterator ( Container& c ) : c_ ( &c ) {}
+
+    back_emplace_iterator& operator= ( const typename Container::value_type& value ) {
+        c_->emplace_back ( value );
+        return *this;
     }
 
-    /**
-     * @brief test on equality
-     *
-     * @param[in] other the %Rational to test to
-     *
-     * @return @c true if equal, @c false otherwise
-     */
-    RATIONAL_CONSTEXPR bool operator== ( const Rational& other ) const {
-        return ! ( ( *this < other ) || ( *this > other ) );
+    back_emplace_iterator& operator= ( typename Container::value_type &&value ) {
+        c_->emplace_back ( std::move ( value ) );
+        return *this;
     }
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend bool operator== ( const Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( x == Rational ( y.numerator(), y.denominator() ) );
+    back_emplace_iterator& operator*() {
+        return *this;
     }
 
-    /**
-     * @brief test on inequality
-     *
-     * @param[in] other the %Rational to test to
-     *
-     * @return @c true if not equal, @c false otherwise
-     */
-    RATIONAL_CONSTEXPR bool operator!= ( const Rational& other ) const {
-        return ! ( *this == other );
+    back_emplace_iterator& operator++() {
+        return *this;
     }
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend bool operator!= ( const Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( x != Rational ( y.numerator(), y.denominator() ) );
+    back_emplace_iterator operator++ ( int ) {
+        return *this;
     }
 
-    /**
-     * @brief test if less than
-     *
-     * @param[in] other the %Rational to test to
-     *
-     * @return @c true if less than @c other, @c false otherwise
-     */
-    RATIONAL_CONSTEXPR bool operator< ( const Rational& other ) const;
+protected:
+    Container *c_;
+};
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend bool operator< ( const Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( x < Rational ( y.numerator(), y.denominator() ) );
+template<typename T, typename A> struct ContainerTraits<std::list<T, A>, false> {
+
+    typedef back_emplace_iterator<std::list<T, A> > iterator;
+
+    RATIONAL_CONSTEXPR static iterator make_iterator ( std::list<T, A>& c ) {
+        return iterator ( c );
+    }
+
+    static void clear ( std::list<T, A>& c ) {
+        c.clear();
+    }
+};
+
+template<typename T, typename A> struct ContainerTraits<std::deque<T, A>, false> {
+
+    typedef back_emplace_iterator<std::deque<T, A> > iterator;
+
+    RATIONAL_CONSTEXPR static iterator make_iterator ( std::deque<T, A>& c ) {
+        return iterator ( c );
+    }
+
+    static void clear ( std::deque<T, A>& c ) {
+        c.clear();
+    }
+};
+
+template<typename T, typename A> struct ContainerTraits<std::vector<T, A>, false> {
+
+    typedef back_emplace_iterator<std::vector<T, A> > iterator;
+
+    RATIONAL_CONSTEXPR static iterator make_iterator ( std::vector<T, A>& c ) {
+        return iterator ( c );
+    }
+
+    static void clear ( std::vector<T, A>& c ) {
+        c.clear();
+    }
+};
+
+#ifdef __EXCEPTIONS
+template<typename T, std::size_t N> class array_at_iterator :
+    public std::iterator<std::output_iterator_tag, void, void, void, void> {
+
+public:
+    explicit array_at_iterator ( std::array<T, N>& c ) : c_ ( &c ), pos_ ( 0 ) {}
+
+    array_at_iterator& operator= ( const typename std::array<T, N>::value_type& value ) {
+        c_->at ( pos_ ) = value;
+        return *this;
+    }
+
+    array_at_iterator& operator= ( typename std::array<T, N>::value_type &&value ) {
+        c_->at ( pos_ ) = std::move ( value );
+        return *this;
+    }
+
+    array_at_iterator& operator*() {
+        return *this;
+    }
+
+    array_at_iterator& operator++() {
+        ++pos_;
+        return *this;
+    }
+
+    array_at_iterator operator++ ( int ) {
+        array_at_iterator tmp ( *this );
+        ++pos_;
+        return tmp;
+    }
+
+protected:
+    std::array<T, N> *c_;
+    typename std::array<T, N>::size_type pos_;
+};
+#endif
+
+template<typename T, std::size_t N> struct ContainerTraits<std::array<T, N>, true> {
+
+#ifdef __EXCEPTIONS
+    typedef array_at_iterator<T, N> iterator;
+#else
+    typedef typename std::array<T, N>::iterator iterator;
+#endif
+
+    RATIONAL_CONSTEXPR static iterator make_iterator ( std::array<T, N>& c ) {
+#ifdef __EXCEPTIONS
+        return iterator ( c );
+#else
+        return c.begin();
+#endif
+    }
+
+    static void clear ( std::array<T, N>& c ) {
+        c.fill ( typename std::array<T, N>::value_type() );
+    }
+};
+#endif
+
+template<typename Container> class ContainerPolicy {
+    typedef ContainerTraits<Container, tmp::_hasPushBack<Container>::No> traits;
+
+public:
+    typedef typename traits::iterator iterator;
+
+    static iterator make_iterator ( Container& c ) {
+        return traits::make_iterator ( c );
+    }
+
+    static void clear ( Container& c ) {
+        traits::clear ( c );
+    }
+
+    static void reserve ( Container& c, std::size_t n ) {
+        _container_reserve ( c, n );
     }
+};
+
+/**
+ * @ingroup main
+ * @brief %Rational (fraction) template class
+ *
+ * @note All %Rational objects are reduced (see @ref gcd)
+ *
+ * @tparam T storage type
+ * @tparam GCD GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD = GCD_euclid_fast,
+         template<class, typename = T, bool = std::numeric_limits<T>::is_signed>
+         class CHKOP = NO_OPERATOR_CHECK, template<typename> class Alloc = std::allocator>
+class Rational {
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    static_assert ( std::is_integral<T>::value || std::numeric_limits<T>::is_integer,
+                    "only integer types are allowed as storage type" );
+#endif
+
+    friend struct _swapSign<T, GCD, CHKOP, Alloc, std::numeric_limits<T>::is_signed>;
+    friend struct _mod<T, GCD, CHKOP, Alloc, std::numeric_limits<T>::is_signed>;
+    friend class RationalReader<Rational>;
+    friend class RationalDigits<Rational>;
+    friend class RationalConvergents<Rational>;
+    friend class FareySequence<Rational>;
+    friend class AtomicRational<T, GCD, CHKOP, Alloc>;
+    friend struct _unarySquare<Rational>;
+    friend struct _unaryTwice<Rational>;
+    template<typename, template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class, template<class, typename, bool> class,
+             template<typename> class, typename, bool, template<typename> class,
+             template<typename> class> friend struct _approxFract;
+
+    template<typename CharT> struct _eval_state;
+public:
+    typedef typename RationalTraits<T>::integer_type integer_type; ///< storage type
 
     /**
-     * @brief test if less or equal than
+     * @brief reusable scratch state of the expression parser
      *
-     * @param[in] other the %Rational to test to
+     * Evaluating many expressions with the same state reuses the memory of the parser's
+     * stacks. A state must not be used by multiple threads at once.
      *
-     * @return @c true if less or equal than @c other, @c false otherwise
+     * @see eval(IIter, IIter, eval_state&)
      */
-    RATIONAL_CONSTEXPR bool operator<= ( const Rational& other ) const {
-        return ! ( other < *this );
-    }
+    typedef _eval_state<char> eval_state;
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend bool operator<= ( const Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( x <= Rational ( y.numerator(), y.denominator() ) );
-    }
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    template<class Op, typename CT = T,
+             bool IS = std::numeric_limits<CT>::is_signed> using chkop = CHKOP<Op, CT, IS>;
+    template<typename GT = T, bool IS = std::numeric_limits<GT>::is_signed,
+             template<class, typename = GT, bool = IS> class CO = chkop,
+             template<typename> class CV = TYPE_CONVERT> using gcd = GCD<GT, IS, CO, CV>;
+    template<typename AT = T> using alloc = Alloc<AT>;
+#endif
 
     /**
-     * @brief test if greater than
-     *
-     * @param[in] other the %Rational to test to
+     * @brief type of the return value of mod()
      *
-     * @return @c true if greater than @c other, @c false otherwise
+     * This type is based on @c std::pair, where @c first is the integral value and @c second the
+     * fractional part
      */
-    RATIONAL_CONSTEXPR bool operator> ( const Rational& other ) const {
-        return other < *this;
-    }
+    typedef typename _mod<integer_type, GCD, CHKOP, Alloc,
+            std::numeric_limits<integer_type>::is_signed>::pair_type mod_type;
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend bool operator> ( const Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( x > Rational ( y.numerator(), y.denominator() ) );
-    }
+    /**
+     * @brief addition (@c a @b + @c b) operator
+     */
+    typedef CHKOP<std::plus<T> > op_plus;
 
     /**
-     * @brief test if greater or equal than
+     * @brief subtraction (@c a @b - @c b) operator
+     */
+    typedef CHKOP<std::minus<T> > op_minus;
+
+    /**
+     * @brief subtraction (@c a @b - @c b) operator
+     */
+    typedef CHKOP<std::negate<T> > op_negate;
+
+    /**
+     * @brief multiplication (@c a @b * @c b) operator
+     */
+    typedef CHKOP<std::multiplies<T> > op_multiplies;
+
+    /**
+     * @brief division (@c a @b / @c b) operator
+     */
+    typedef CHKOP<std::divides<T> > op_divides;
+
+    /**
+     * @brief modulus (@c a @b % @c b) operator
+     */
+    typedef CHKOP<std::modulus<T> > op_modulus;
+
+    /**
+     * @brief creates a default (null) %Rational
      *
-     * @param[in] other the %Rational to test to
+     * Creates a fraction @f$ \frac{0}{1} @f$
+     */
+    RATIONAL_CONSTEXPR Rational() : m_numer (), m_denom ( one_ ) {}
+
+    /**
+     * @brief creates a %Rational
      *
-     * @return @c true if greater or equal than @c other, @c false otherwise
+     * Creates a copy of @c numer and divides it by @c denom
+     *
+     * @note to achieve a continued faction like \f$\frac{1}{\frac{1}{2}}\f$ you must explicitely
+     * cast the @em numerator, i.e.
+     * @code const Rational<rational_type> x ( Rational<rational_type> ( 1 ),
+     *   Rational<rational_type> ( 1,2 )); @endcode
+     *
+     * @tparam U1 GCD algorithm of the numerator
+     * @tparam V1 operator checker of the numerator
+     *
+     * @tparam U2 GCD algorithm of the denominator
+     * @tparam V2 operator checker of the denominator
+     *
+     * @param[in] numer the numerator
+     * @param[in] denom the denominator
      */
-    RATIONAL_CONSTEXPR bool operator>= ( const Rational& other ) const {
-        return ! ( *this < other );
-    }
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U1,
+             template<class, typename, bool> class V1, template<typename> class Alloc1,
+             template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U2,
+             template<class, typename, bool> class V2, template<typename> class Alloc2>
+    Rational ( const Rational<integer_type, U1, V1, Alloc1>& numer,
+               const Rational<integer_type, U2, V2, Alloc2>& denom ) :
+        m_numer ( numer.numerator() ), m_denom ( numer.denominator() ) {
+        *this *= denom.inverse();
+    }
+
+    /**
+     * @brief creates a %Rational
+     *
+     * Creates a fraction @f$ \frac{numer}{denom} @f$
+     *
+     * @param[in] numer the numerator
+     * @param[in] denom the denominator
+     */
+    Rational ( const integer_type& numer, const integer_type& denom );
+
+    /**
+     * @brief creates a inproper (mixed) %Rational
+     *
+     * Creates a fraction @f$ whole + \frac{numer}{denom} @f$
+     *
+     * @param[in] whole whole number part
+     * @param[in] numer the numerator
+     * @param[in] denom the denominator
+     */
+    Rational ( const integer_type& whole, const integer_type& numer,
+               const integer_type& denom ) : m_numer (), m_denom ( one_ ) {
+        *this += Rational ( numer, denom ) += Rational ( whole );
+    }
+
+    /**
+     * @brief creates an approximated %Rational
+     *
+     * @b Example: \n @c Commons::Math::Rational<uint64_t>( std::sqrt( 2.0l ) )
+     * to get @f$ \sqrt{2} \approx \frac{6333631924}{4478554083} @f$
+     *
+     * @see Commons::Math::EPSILON to control the quality of the approximation
+     *
+     * @tparam NumberType type of the number to approximate
+     *
+     * @param[in] number the number to create an approximated %Rational of
+     */
+    template<typename NumberType>
+    Rational ( const NumberType& number );
+
+    /**
+     * @brief creates a %Rational approximated by an expression
+     *
+     * If @c expr is not @c null and not empty then it is parsed and evaluated as
+     * @c long @c double expression and approximated to a fraction.
+     *
+     * The @em expression can be a simple infix arithmetic expression containing
+     *
+     * * addition (@c +); also @em unary
+     * * subtraction (@c -); also @em unary
+     * * multiplication (@c *)
+     * * division (@c /)
+     * * modulus (@c %)
+     * * parenthesises
+     *
+     * Numbers can be integers or floats in non-scientific notation. Allowed are spaces, tabs
+     * and newlines around numbers, parenthesises and operators.
+     *
+     * The expression gets evaluated into a sequence of Commons::Math::Rational terms. Floats
+     * are approximated using @c ExpressionEvalTraits<integer_type> as float number type.\n
+     * @c ExpressionEvalTraits<integer_type> corresponds to @c long @c double if not specialized
+     *
+     * In case of errors an @c std::runtime_exception is thrown if exceptions are enabled,
+     * else the result is undefined.
+     *
+     * @b Example: \n @code{.cpp}
+     * Rational<long> x ( "(11/2) * +(4.25+3.75)" );@endcode produces the fraction
+     * @f$x = \frac{44}{1}@f$
+     *
+     * @see Rational(const NumberType& number)
+     * @see ExpressionEvalTraits
+     *
+     * @param[in] expr the expression to evaluate and approximate
+     */
+    Rational ( const char *expr ) : m_numer(), m_denom ( one_ ) {
+        *this = RATIONAL_MOVE ( eval ( expr ) );
+    }
+
+    ~Rational();
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    // the user-declared destructor would otherwise suppress the implicit move operations
+    Rational ( const Rational & ) = default;
+    Rational ( Rational && ) = default;
+    Rational &operator= ( const Rational & ) = default;
+    Rational &operator= ( Rational && ) = default;
+#endif
+
+    /**
+     * @brief assigns from a @c NumberType
+     *
+     * The @c number is approximated to a %Rational, then it gets assigned
+     *
+     * @see Rational(const NumberType& number)
+     * @see Commons::Math::EPSILON
+     *
+     * @tparam NumberType type of the number to approximate
+     *
+     * @param[in] number the number to assign
+     */
+    template<typename NumberType>
+    Rational& operator= ( const NumberType& number ) {
+        return ( *this = RATIONAL_MOVE ( Rational ( number ) ) );
+    }
+
+#ifndef __clang__
+    operator void() const RATIONAL_NOEXCEPT {}
+#endif
+
+    /**
+     * @brief convert to @c NumberType
+     *
+     * @tparam NumberType type of the number to approximate
+     *
+     * @return the number value of the %Rational
+     */
+    template<typename NumberType>
+    RATIONAL_CONSTEXPR operator NumberType() const {
+        return typename RationalTraits<integer_type>::type_convert ( m_numer ).
+               template convert<NumberType>() /
+        typename RationalTraits<integer_type>::type_convert ( m_denom ).
+        template convert<NumberType>();
+    }
+
+    /**
+     * @brief gets the numerator
+     *
+     * @return the numerator
+     */
+    RATIONAL_CONSTEXPR integer_type numerator() const RATIONAL_NOEXCEPT {
+        return m_numer;
+    }
+
+    /**
+     * @brief gets the denominator
+     *
+     * @return the denominator
+     */
+    RATIONAL_CONSTEXPR integer_type denominator() const RATIONAL_NOEXCEPT {
+        return m_denom;
+    }
+
+    /**
+     * @brief checks if @c m describes an integer @f$\neq 0@f$
+     *
+     * @see Commons::Math::Rational::mod()
+     *
+     * @param[in] m a mod_type
+     *
+     * @return @c true if @c describes an integer @f$\neq 0@f$, @c false otherwise
+     */
+    static bool isInteger ( const mod_type& m ) {
+        return std::not_equal_to<typename mod_type::first_type>() ( m.first, zero_ ) &&
+               m.second.numerator() == zero_;
+    }
+
+    /**
+     * @copybrief
+     * @overload
+     */
+    bool isInteger () const {
+        return isInteger ( mod() );
+    }
+
+    /**
+     * @brief Structure holding a description of a repeating fraction
+     *
+     * @see Commons::Math::Rational::decompose()
+     * @see Commons::Math::Rational::rf()
+     */
+    typedef struct _rf_info {
+
+        typedef typename DecomposeBaseTraits<integer_type,
+                std::numeric_limits<integer_type>::is_signed>::digit_type digit_type;
+
+        RATIONAL_NOCOPYASSIGN ( _rf_info );
+
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic push
+        _rf_info ( const integer_type& r, std::size_t lz = 0u,
+                   const integer_type& p = integer_type(),  std::size_t plz = 0u ) :
+            reptend ( r ), leading_zeros ( lz ), pre ( p ), pre_leading_zeros ( plz ),
+            negative ( r < zero_ || p < zero_ ) {}
+#pragma GCC diagnostic pop
+
+        _rf_info() : reptend(), leading_zeros ( 0u ), pre(), pre_leading_zeros ( 0u ),
+            negative ( false ) {}
+
+        integer_type reptend; ///< the repeating part as integer_type
+        std::size_t leading_zeros; ///< the amount of zeros at the beginning of @c reptend
+        integer_type pre; ///< the digits before @c reptend as integer_type
+        std::size_t pre_leading_zeros; ///< the amount of zeros at the beginning of @c pre
+
+        bool negative; ///< @c true if the decimal is negative, @c false otherwise
+
+    } rf_info;
+
+    /**
+     * @ingroup main
+     * @brief Constructs a fraction from a repeating decimal
+     *
+     * @see Commons::Math::Rational::decompose()
+     *
+     * The fraction is calculated by the formula: \n \n
+     * @f$ \frac{\displaystyle{\mathrm{pre}} + \frac{\displaystyle{\mathrm{reptend}}}{\begin{cases}
+     * \displaystyle{1} & \displaystyle{\text{if } \mathrm{x} = 0} \\
+     * \displaystyle{10^{\displaystyle{\lceil\log_{10}(|\mathrm{reptend}| + 1)\rceil +
+     * \mathrm{leading\_zeros}}} - 1} & \displaystyle{\text{if } \mathrm{x} \neq 0}
+     * \end{cases}}}{\displaystyle{10}^{\displaystyle{\displaystyle{\lceil\log_{10}(|\mathrm{pre}|
+     * + 1)\rceil + \mathrm{pre\_leading\_zeros}}}}} @f$
+     *
+     * @remarks
+     * * to get an intuitive result @c reptend and @c pre should be positive numbers
+     * * the resulting fraction will be within @f$ 0 \leq x \leq 1@f$, where @f$ x @f$ is the
+     * decimal value of the fraction
+     *
+     * @b Examples: \n
+     * * to construct a fraction representing
+     *   @f$\frac{13717421}{111111111} = 0.\overline{123456789}@f$ you'll need to write: @code{.cpp}
+     * Commons::Math::Rational<long> frac =
+     *      Commons::Math::Rational<long>(Commons::Math::rf_info(123456789));@endcode
+     * * to construct a fraction representing
+     *   @f$\frac{667}{6000} = 0.1111\overline{66}@f$ you'll need to write: @code{.cpp}
+     * Commons::Math::Rational<long> frac =
+     *      Commons::Math::Rational<long>(Commons::Math::rf_info(6, 0, 1111));@endcode
+     *
+     * @param[in] info a repeating decimal description
+     */
+    Rational ( const rf_info& info );
+
+    /**
+     * @brief Splits a fraction in it's whole and repetitive part
+     *
+     * @tparam PreC container type to store pre digit sequences
+     * @tparam RepC container type to store reptend digit sequences
+     *
+     * @param[out] rf_info rf_info structure to store the result
+     * @param[out] pre_digits Container to store the pre-digits
+     * @param[out] reptend_digits Container to store the reptend-digits
+     * @param[in] digitsOnly omit calculation of @c rf_info.pre and @c rf_info.reptend
+     * @param[in] base the base, defaults to integer_type (10) as a decimal base
+     *
+     * @return the whole part of the fraction
+     */
+    template<class PreC, class RepC>
+    integer_type decompose ( rf_info& rf_info, PreC& pre_digits, RepC& reptend_digits,
+                             bool digitsOnly ) const;
+    /**
+     * @overload
+     */
+    template<class PreC, class RepC>
+    integer_type decompose ( rf_info& rf_info, PreC& pre_digits, RepC& reptend_digits ) const {
+        return decompose ( rf_info, pre_digits, reptend_digits, false );
+    }
+
+    template<typename IIter>
+    static Rational eval ( IIter first, IIter last );
+
+    /**
+     * @brief evaluates an expression using a reusable scratch state
+     *
+     * @see eval_state
+     *
+     * @tparam IIter input iterator over @c char
+     *
+     * @param[in] first iterator pointing to the begin of the expression
+     * @param[in] last iterator pointing to the end of the expression
+     * @param[in,out] state the scratch state of the parser
+     */
+    template<typename IIter>
+    static Rational eval ( IIter first, IIter last, eval_state& state ) {
+        return _eval ( first, last, state );
+    }
+
+    Rational eval ( const char *expr ) const;
+
+    /**
+     * @brief extract the integral and fractional part
+     *
+     * each part has the same sign as the Rational
+     *
+     * @see mod_type
+     *
+     * @return a @c mod_type containing the integral and fractional part
+     */
+    RATIONAL_CONSTEXPR mod_type mod() const;
+
+    /**
+     * @brief gets the absolute %Rational
+     *
+     * Returns for @em signed types
+     * @c ( this->numerator() < T() ? -(*this) : (*this) )
+     * and for @em unsigned types @c (*this)
+     *
+     * @return a copy of the absolute %Rational
+     */
+    RATIONAL_CONSTEXPR Rational abs() const {
+        return _abs<integer_type, GCD, CHKOP, Alloc,
+               std::numeric_limits<integer_type>::is_signed>() ( *this );
+    }
+
+    /**
+     * @brief gets the a new %Rational raised to the power of @c exp
+     *
+     * If overflows can get ruled out (i.e. with use of Commons::Math::gmp_rational),
+     * you can speed up the calculation by initializing a %Rational with
+     * Commons::Math::GCD_null and initializing the resulting power in a %Rational
+     * with the desired GCD: @code{.cpp}
+     * const Commons::Math::gmp_rational r(3, 4);
+     *
+     * typedef Commons::Math::Rational<Commons::Math::gmp_rational::integer_type,
+     *         Commons::Math::GCD_null, Commons::Math::NO_OPERATOR_CHECK> gmp_nogcd_rational;
+     *
+     * const gmp_nogcd_rational& nr(gmp_nogcd_rational(r.numerator(), r.denominator()).pow(256));
+     *
+     * std::cout << Commons::Math::gmp_rational(nr.numerator(), nr.denominator())
+     *           << std::endl;@endcode
+     *
+     * @warning negative values or zero can cause undefined behaviour if compiled
+     * without exceptions
+     *
+     * @param[in] exp the exponent to raise this %Rational
+     * @return a copy of the absolute %Rational raised to the power of @c exp
+     */
+    Rational pow ( const integer_type& exp ) const {
+        return _pow<integer_type, GCD, CHKOP, Alloc,
+               std::numeric_limits<integer_type>::is_signed>() ( *this, exp );
+    }
+
+    /**
+     * @brief gets the square root as a new %Rational
+     *
+     * @return a square root copy of %Rational
+     */
+    Rational sqrt() const;
+
+    /**
+     * @brief inverts the %Rational
+     *
+     * @b Example: \n @f$ \frac{-5}{12} @f$ will become to @f$ \frac{-12}{5} @f$
+     *
+     * @return the inverted %Rational
+     */
+    Rational& invert();
+
+    /**
+     * @brief gets a copy of the inverted %Rational
+     *
+     * @see invert()
+     *
+     * @return a copy of the inverted %Rational
+     */
+    RATIONAL_CONSTEXPR Rational inverse() const;
+
+    /**
+     * @brief add and assign a %Rational
+     *
+     * @param[in] other the %Rational to add and assign
+     *
+     * @return the %Rational
+     */
+    Rational& operator+= ( const Rational& other ) {
+        return knuth_addSub<op_plus> ( other );
+    }
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend Rational& operator+= ( Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( x += Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief add a %Rational
+     *
+     * @param[in] other the %Rational to add
+     *
+     * @return a new %Rational
+     */
+    RATIONAL_CONSTEXPR Rational operator+ ( const Rational& other ) const;
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend Rational operator+ ( const Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( Rational ( x ) += Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief get a copy of the %Rational
+     *
+     * @return a copy of %Rational
+     */
+    RATIONAL_CONSTEXPR Rational operator+() const {
+        return Rational ( *this );
+    }
+
+    /**
+     * @brief pre-increment a %Rational
+     *
+     * the result will be
+     * @f$ \frac{numerator + denominator}{denominator} \Rightarrow numerator + 1@f$
+     *
+     * @return the incremented %Rational
+     */
+    Rational& operator++() {
+        m_numer = RATIONAL_MOVE ( op_plus() ( m_numer, m_denom ) );
+        return reduce();
+    }
+
+    /**
+     * @brief post-increment a %Rational
+     *
+     * @see operator++()
+     *
+     * @return a copy of %Rational
+     */
+    Rational operator++ ( int ) {
+        Rational tmp ( *this );
+        ++*this;
+        return tmp;
+    }
+
+    /**
+     * @brief subtract and assign a %Rational
+     *
+     * @param[in] other the %Rational to subtract and assign
+     *
+     * @return the %Rational
+     */
+    Rational& operator-= ( const Rational& other ) {
+        return knuth_addSub<op_minus> ( other );
+    }
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend Rational& operator-= ( Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( x -= Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief subtract a %Rational
+     *
+     * @param[in] other the %Rational to subtract
+     *
+     * @return a new %Rational
+     */
+    RATIONAL_CONSTEXPR Rational operator- ( const Rational& other ) const {
+        return ( Rational ( *this ) -= other );
+    }
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend Rational operator- ( const Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( Rational ( x ) -= Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief get a negated copy of the %Rational
+     *
+     * @return a negated copy of %Rational
+     */
+    Rational operator-() const {
+        Rational tmp ( *this );
+        tmp.m_numer = RATIONAL_MOVE ( op_negate() ( tmp.m_numer ) );
+        return tmp;
+    }
+
+    /**
+      * @brief pre-decrement a %Rational
+      *
+      * the result will be
+      * @f$ \frac{numerator - denominator}{denominator} \Rightarrow numerator - 1@f$
+      *
+      * @return the incremented %Rational
+      */
+    Rational& operator--() {
+        m_numer = RATIONAL_MOVE ( op_minus() ( m_numer, m_denom ) );
+        return reduce();
+    }
+
+    /**
+     * @brief post-decrement a %Rational
+     *
+     * @see operator--()
+     *
+     * @return a copy of %Rational
+     */
+    Rational operator-- ( int ) {
+        Rational tmp ( *this );
+        --*this;
+        return tmp;
+    }
+
+    /**
+     * @brief multiply and assign a %Rational
+     *
+     * @param[in] other the %Rational to multiply and assign
+     *
+     * @return the %Rational
+     */
+    Rational& operator*= ( const Rational& other );
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend Rational& operator*= ( Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( x *= Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief multiply a %Rational
+     *
+     * @param[in] other the %Rational to multiply
+     *
+     * @return a new %Rational
+     */
+    RATIONAL_CONSTEXPR Rational operator* ( const Rational& other ) const;
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend Rational operator* ( const Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( Rational ( x ) *= Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief divide and assign a %Rational
+     *
+     * @param[in] other the %Rational to divide and assign
+     *
+     * @return the %Rational
+     */
+    Rational& operator/= ( const Rational& other ) {
+        return ( *this *= other.inverse() );
+    }
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend Rational& operator/= ( Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( x /= Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief divide a %Rational
+     *
+     * @param[in] other the %Rational to divide
+     *
+     * @return a new %Rational
+     */
+    RATIONAL_CONSTEXPR Rational operator/ ( const Rational& other ) const {
+        return ( Rational ( *this ) /= other );
+    }
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend Rational operator/ ( const Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( Rational ( x ) /= Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief modulo and assign a %Rational
+     *
+     * @param[in] other the %Rational to modulo and assign
+     *
+     * @return the %Rational
+     */
+    Rational& operator%= ( const Rational& other );
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend Rational& operator%= ( Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( x %= Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief modulo a %Rational
+     *
+     * @param[in] other the %Rational to modulo
+     *
+     * @return a new %Rational
+     */
+    RATIONAL_CONSTEXPR Rational operator% ( const Rational& other ) const {
+        return ( Rational ( *this ) %= other );
+    }
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend Rational operator% ( const Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( Rational ( x ) %= Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief test on equality
+     *
+     * @param[in] other the %Rational to test to
+     *
+     * @return @c true if equal, @c false otherwise
+     */
+    RATIONAL_CONSTEXPR bool operator== ( const Rational& other ) const {
+        return ! ( ( *this < other ) || ( *this > other ) );
+    }
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend bool operator== ( const Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( x == Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief test on inequality
+     *
+     * @param[in] other the %Rational to test to
+     *
+     * @return @c true if not equal, @c false otherwise
+     */
+    RATIONAL_CONSTEXPR bool operator!= ( const Rational& other ) const {
+        return ! ( *this == other );
+    }
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend bool operator!= ( const Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( x != Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief test if less than
+     *
+     * @param[in] other the %Rational to test to
+     *
+     * @return @c true if less than @c other, @c false otherwise
+     */
+    RATIONAL_CONSTEXPR bool operator< ( const Rational& other ) const;
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend bool operator< ( const Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( x < Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief test if less or equal than
+     *
+     * @param[in] other the %Rational to test to
+     *
+     * @return @c true if less or equal than @c other, @c false otherwise
+     */
+    RATIONAL_CONSTEXPR bool operator<= ( const Rational& other ) const {
+        return ! ( other < *this );
+    }
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend bool operator<= ( const Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( x <= Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief test if greater than
+     *
+     * @param[in] other the %Rational to test to
+     *
+     * @return @c true if greater than @c other, @c false otherwise
+     */
+    RATIONAL_CONSTEXPR bool operator> ( const Rational& other ) const {
+        return other < *this;
+    }
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend bool operator> ( const Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( x > Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief test if greater or equal than
+     *
+     * @param[in] other the %Rational to test to
+     *
+     * @return @c true if greater or equal than @c other, @c false otherwise
+     */
+    RATIONAL_CONSTEXPR bool operator>= ( const Rational& other ) const {
+        return ! ( *this < other );
+    }
+
+    template<template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class U, template<class, typename, bool> class V,
+             template<typename> class W>
+    RATIONAL_CONSTEXPR friend bool operator>= ( const Rational& x,
+            const Rational<integer_type, U, V, W>& y ) {
+        return ( x >= Rational ( y.numerator(), y.denominator() ) );
+    }
+
+    /**
+     * @brief test if it is the neutral element to addition and subtraction
+     *
+     * Tests if the @c numerator is equal to the default constructed @c integer_type
+     *
+     * @note @f$ 0 + x = x + 0 = x @f$ and @f$ 0 - x = x - 0 = x @f$
+     *
+     * @warning it does @b not do the test for the neutral element to multiplication and division
+     *
+     * @return @c true if it is the neutral element to addition and subtraction, @c false otherwise
+     */
+    RATIONAL_CONSTEXPR bool operator!() const {
+        return m_numer == zero_;
+    }
+
+    /**
+     * @brief generates the string representation of %Rational
+     *
+     * @param[in] mixed if @c true, than a mixed (inproper) fraction is generated
+     *
+     * @return the string representation of %Rational
+     */
+    std::string str ( bool mixed = false ) const;
+
+    /**
+     * @brief writes the string representation of %Rational into a character range
+     *
+     * Writes the same characters as str(bool) would return, but directly into
+     * @c [first, last) without any stream or heap allocation involved
+     * (for the built-in storage types). No terminating @c NUL is written.
+     *
+     * @see formatted_size()
+     * @see Commons::Math::ToCharsTraits
+     *
+     * @param[out] first pointer to the begin of the range
+     * @param[out] last pointer to the end of the range
+     * @param[in] r the %Rational to write
+     * @param[in] mixed if @c true, than a mixed (inproper) fraction is written
+     *
+     * @return pointer past the last character written, or @c 0L if the range is too small
+     */
+    friend char *to_chars ( char *first, char *last, const Rational& r, bool mixed = false ) {
+        return r._to_chars ( first, last, mixed, _decimal_conv() );
+    }
+
+    /**
+     * @brief gets the size of a range sufficient for to_chars()
+     *
+     * @param[in] r the %Rational to query
+     * @param[in] mixed if @c true, than the size for a mixed (inproper) fraction is returned
+     *
+     * @return the amount of characters to_chars() needs at most to write @c r
+     */
+    friend std::size_t formatted_size ( const Rational& r, bool mixed = false ) {
+        return r._formatted_size ( mixed, _decimal_conv() );
+    }
+
+    /**
+     * @brief writes the string representation of %Rational in base @c base into a
+     * character range
+     *
+     * For bases greater than 10 the letters @c a to @c z represent the digits 10 to 35.
+     * For bases greater than 36 the upper case letters @c A to @c Z represent the digits
+     * 10 to 35 and the lower case letters @c a to @c z the digits 36 to 61. Power of
+     * two bases are written by bit slicing for the built-in storage types.
+     *
+     * @see to_chars(char *, char *, const Rational&, bool)
+     *
+     * @param[out] first pointer to the begin of the range
+     * @param[out] last pointer to the end of the range
+     * @param[in] r the %Rational to write
+     * @param[in] base the base within 2 and 62
+     * @param[in] mixed if @c true, than a mixed (inproper) fraction is written
+     *
+     * @return pointer past the last character written, or @c 0L if the range is too small
+     *         or @c base is outside @c 2 and @c 62
+     */
+    friend char *to_chars ( char *first, char *last, const Rational& r, int base,
+                            bool mixed = false ) {
+        return _is_radix ( base ) ? r._to_chars ( first, last, mixed, _radix_conv ( base ) ) :
+               0L;
+    }
+
+    /**
+     * @brief gets the size of a range sufficient for to_chars() in base @c base
+     *
+     * @param[in] r the %Rational to query
+     * @param[in] base the base within 2 and 62
+     * @param[in] mixed if @c true, than the size for a mixed (inproper) fraction is returned
+     *
+     * @return the amount of characters to_chars() needs at most to write @c r, or @c 0 if
+     *         @c base is outside @c 2 and @c 62
+     */
+    friend std::size_t formatted_size ( const Rational& r, int base, bool mixed = false ) {
+        return _is_radix ( base ) ? r._formatted_size ( mixed, _radix_conv ( base ) ) : 0u;
+    }
+
+    /**
+     * @brief writes %Rational in positional notation with @c precision fractional digits
+     *
+     * The digits after the radix point are truncated, i.e. @f$ -\frac{2}{3} @f$ with a
+     * precision of @c 4 is written as @c -0.6666. The fractional digits are calculated by
+     * Commons::Math::RadixExpandTraits.
+     *
+     * @see fixed_size()
+     *
+     * @param[out] first pointer to the begin of the range
+     * @param[out] last pointer to the end of the range
+     * @param[in] r the %Rational to write
+     * @param[in] precision the amount of digits after the radix point
+     * @param[in] base the base within 2 and 62
+     *
+     * @return pointer past the last character written, or @c 0L if the range is too small
+     *         or @c base is outside @c 2 and @c 62
+     */
+    friend char *to_chars_fixed ( char *first, char *last, const Rational& r,
+                                  std::size_t precision, int base = 10 ) {
+        return r._to_chars_fixed ( first, last, precision, base );
+    }
+
+    /**
+     * @brief gets the size of a range sufficient for to_chars_fixed()
+     *
+     * @param[in] r the %Rational to query
+     * @param[in] precision the amount of digits after the radix point
+     * @param[in] base the base within 2 and 62
+     *
+     * @return the amount of characters to_chars_fixed() needs at most to write @c r, or @c 0
+     *         if @c base is outside @c 2 and @c 62
+     */
+    friend std::size_t fixed_size ( const Rational& r, std::size_t precision, int base = 10 ) {
+        return _is_radix ( base ) ? _radix_conv ( base ).size ( r.m_numer ) + 2u + precision :
+               0u;
+    }
+
+    /**
+     * @brief output stream operator
+     *
+     * Sends a string representation of %Rational to a @c std::ostream
+     *
+     * @see str(bool)
+     *
+     * @param[out] o the stream to send to
+     * @param[in] r the %Rational to send to the stream @c o
+     *
+     * @return the stream @c o
+     */
+    friend std::ostream& operator<< ( std::ostream& o, const Rational& r ) {
+
+        char buf[64];
+        const char *e;
+
+        if ( !o.width() && ( e = r._to_chars ( buf, buf + sizeof ( buf ), false,
+                                               _decimal_conv() ) ) ) {
+            return o.write ( buf, e - buf );
+        }
+
+        return ( o << r.str() );
+    }
+
+    /**
+     * @brief reads a %Rational from a character range
+     *
+     * Reads an optionally signed integer or fraction (i.e. @c -3 or @c 3/4) at the begin of
+     * @c [first, last) without any stream or allocation involved (for the built-in storage
+     * types).
+     *
+     * @see Commons::Math::FromCharsTraits
+     *
+     * @param[in] first pointer to the begin of the range
+     * @param[in] last pointer to the end of the range
+     * @param[out] r the %Rational to assign to, unchanged on failure
+     *
+     * @return pointer past the last character read, or @c 0L if no %Rational could be read
+     */
+    friend const char *from_chars ( const char *first, const char *last, Rational& r ) {
+        return _from_chars ( first, last, r );
+    }
+
+    /**
+     * @brief the amount of bytes serialize() needs at most for @c r
+     *
+     * @param[in] r the %Rational
+     *
+     * @return the size in bytes
+     */
+    friend std::size_t serialized_size ( const Rational& r ) {
+        return SerializeTraits<integer_type>::size ( r.m_numer ) +
+               SerializeTraits<integer_type>::size ( r.m_denom );
+    }
+
+    /**
+     * @brief writes @c r in a compact binary format
+     *
+     * The numerator and the denominator are written according to
+     * Commons::Math::SerializeTraits, i.e. as variable length integers for the built-in
+     * storage types. The format is independent of the endianess of the machine.
+     *
+     * @see deserialize()
+     * @see Commons::Math::RationalBinaryWriter
+     *
+     * @param[out] first pointer to the begin of the range
+     * @param[out] last pointer to the end of the range
+     * @param[in] r the %Rational to write
+     *
+     * @return pointer past the last byte written, or @c 0L if the range is too small
+     */
+    friend unsigned char *serialize ( unsigned char *first, unsigned char *last,
+                                      const Rational& r ) {
+        return ( first = SerializeTraits<integer_type>::write ( first, last, r.m_numer ) ) ?
+               SerializeTraits<integer_type>::write ( first, last, r.m_denom ) : 0L;
+    }
+
+    /**
+     * @brief reads a %Rational written by serialize()
+     *
+     * A denominator, which isn't positive, is rejected, a fraction, which isn't reduced,
+     * gets reduced.
+     *
+     * @param[in] first pointer to the begin of the range
+     * @param[in] last pointer to the end of the range
+     * @param[out] r the %Rational to assign to, unchanged on failure
+     * @param[out] more if not @c 0L, set to @c true if the range ends within the %Rational,
+     * i.e. if more bytes could make it valid, and to @c false otherwise
+     *
+     * @return pointer past the last byte read, or @c 0L if the range is too small or
+     * doesn't contain a valid %Rational
+     */
+    friend const unsigned char *deserialize ( const unsigned char *first,
+            const unsigned char *last, Rational& r, bool *more = 0L ) {
+        return _deserialize ( first, last, r, more );
+    }
+
+    /**
+     * @brief reads in a record containing an @c expression from a @c std::istream
+     *
+     * Like the extraction of numbers, leading whitespace is skipped and the record ends
+     * at whitespace, so multiple %Rationals can be read from one stream. Whitespace within
+     * an expression is allowed as long as the expression continues, i.e. the record
+     * @c "1/8 * 8.897 - 3.6" is one %Rational, whereas @c "2 3/4" are two of them.
+     *
+     * If nothing could be read, the @c failbit is set.
+     *
+     * @see Rational(const char *expr)
+     * @see Commons::Math::rational_delimiter
+     * @see Commons::Math::RationalReader
+     *
+     * @param[in] i the stream to read from
+     * @param[out] r the %Rational to assign to
+     *
+     * @return the stream @c i
+     */
+    friend std::istream& operator>> ( std::istream& i, Rational& r ) {
+
+        std::vector<char> buf;
+
+        if ( _read_record ( i, buf,
+                            static_cast<char> ( i.iword ( _rational_delimiter_index() ) ) ) ) {
+            _assign_record ( &buf[0], &buf[0] + buf.size(), r );
+        }
+
+        return i;
+    }
+
+private:
+    Rational& reduce();
+
+    Rational _sqrt() const;
+
+    struct _decimal_conv {
+
+        std::size_t size ( const integer_type& x ) const {
+            return ToCharsTraits<integer_type>::size ( x );
+        }
+
+        char *operator() ( char *first, char *last, const integer_type& x ) const {
+            return ToCharsTraits<integer_type>::convert ( first, last, x );
+        }
+    };
+
+    struct _radix_conv {
+
+        explicit _radix_conv ( int base ) : base_ ( base ) {}
+
+        std::size_t size ( const integer_type& x ) const {
+            return ToCharsTraits<integer_type>::size ( x, base_ );
+        }
+
+        char *operator() ( char *first, char *last, const integer_type& x ) const {
+            return ToCharsTraits<integer_type>::convert ( first, last, x, base_ );
+        }
+
+        const int base_;
+    };
+
+    template<class Conv>
+    char *_to_chars ( char *first, char *last, bool mixed, const Conv& conv ) const;
+
+    template<class Conv>
+    std::size_t _formatted_size ( bool mixed, const Conv& conv ) const;
+
+    char *_to_chars_fixed ( char *first, char *last, std::size_t precision, int base ) const;
+
+    static const char *_from_chars ( const char *first, const char *last, Rational& r );
+
+    static const unsigned char *_deserialize ( const unsigned char *first,
+            const unsigned char *last, Rational& r, bool *more );
+
+    template<class Container>
+    static bool _read_record ( std::istream& i, Container& buf, char delim );
+
+    static void _assign_record ( const char *first, const char *last, Rational& r ) {
+        if ( _from_chars ( first, last, r ) != last ) r = RATIONAL_MOVE ( eval ( first, last ) );
+    }
+
+    RATIONAL_CONSTEXPR static bool isOperator ( const char op ) {
+        return op == '/' || op == '*' || op == '+' || op == '-' || op == '%' || op == 1 || op == 2;
+    }
+
+    RATIONAL_CONSTEXPR static bool isDelimiter ( const char d ) {
+        return isOperator ( d ) || d == '(' || d == ')' || d == '\n' || d == ' ' || d == '\t';
+    }
+
+    RATIONAL_CONSTEXPR static bool isLeftAssoc ( const char op ) {
+        return op > 2;
+    }
+
+    RATIONAL_CONSTEXPR static unsigned char getPrec ( const char op ) {
+        return !isLeftAssoc ( op ) ? 2 : ( ( op == '*' || op == '/' || op == '%' ) ? 1 : 0 );
+    }
+
+    typedef std::stack<Rational, std::vector<Rational, Alloc<Rational> > > evalStack;
+
+    template<typename CharT>
+    struct _eval_state {
+
+        _eval_state() : syard(), token(), rpn() {}
+
+        void clear() {
+
+            while ( !syard.empty() ) syard.pop();
+            while ( !rpn.empty() ) rpn.pop();
+
+            token.clear();
+        }
+
+        std::stack<CharT, std::vector<CharT, Alloc<CharT> > > syard;
+        std::vector<CharT, Alloc<CharT> > token;
+        evalStack rpn;
+    };
+
+    template<typename IIter, typename State>
+    static Rational _eval ( IIter first, IIter last, State& state );
+
+    static bool eval_ ( const char op, evalStack& s );
+
+    template<typename Container>
+    static void pushToken ( evalStack& rpn, Container& token ) {
+
+        Rational r;
+
+        // integers exactly representable by the NumberType are read directly
+        if ( token.size() <= static_cast<std::size_t> ( std::numeric_limits<long double>::digits10 )
+                && ( !std::numeric_limits<integer_type>::is_bounded || token.size() <=
+                     static_cast<std::size_t> ( std::numeric_limits<integer_type>::digits10 ) ) &&
+                _token_from_chars ( token.data(), token.data() + token.size(), r ) ) {
+            rpn.push ( RATIONAL_MOVE ( r ) );
+        } else {
+            rpn.push ( typename RationalTraits<typename Container::const_pointer>::type_convert
+                       ( token.data(), token.data() + token.size() ).template convert<typename
+                       ExpressionEvalTraits<integer_type>::NumberType>() );
+        }
+
+        token.clear();
+    }
+
+    static bool _token_from_chars ( const char *first, const char *last, Rational& r ) {
+        return std::find ( first, last, '.' ) == last && _from_chars ( first, last, r ) == last;
+    }
+
+    template<typename CharT>
+    static bool _token_from_chars ( const CharT *, const CharT *, Rational& ) {
+        return false;
+    }
+
+    template<typename PreOIter, typename RepOIter>
+    struct cd_lambda {
+
+        typedef enum { PRE, REP } PUSH;
+
+        cd_lambda ( typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes,
+                    const integer_type&, const integer_type>::ResultT d, PreOIter pre,
+                    RepOIter rep, rf_info& rf_info, bool horner ) : rfi_ ( rf_info ), d_ ( d ),
+            q_(), pre_ ( pre ), rep_ ( rep ), horner_ ( horner ) {
+
+            if ( horner ) rfi_.reptend = rfi_.pre = zero_;
+        }
+
+        integer_type operator() ( const integer_type& r ) const {
+            return ( op_multiplies() ( op_modulus() ( r, d_ ),
+                                       DecomposeBaseTraits<integer_type,
+                                       std::numeric_limits<integer_type>::is_signed>::Base ) );
+        }
+
+        integer_type operator() ( const integer_type& r, PUSH p ) const {
+
+            const integer_type ret ( op_multiplies() ( _remquo<integer_type, GCD, CHKOP, Alloc,
+                                     typename DecomposeBaseTraits<integer_type,
+                                     std::numeric_limits<integer_type>::is_signed>::digit_type>()
+                                     ( r, d_, q_ ), DecomposeBaseTraits<integer_type,
+                                     std::numeric_limits<integer_type>::is_signed>::Base ) );
+            if ( p == REP ) {
+
+                if ( horner_ ) rfi_.reptend =
+                        RATIONAL_MOVE ( op_plus()
+                                        ( op_multiplies()
+                                          ( rfi_.reptend, DecomposeBaseTraits<integer_type,
+                                            std::numeric_limits<integer_type>::is_signed>::Base ),
+                                          q_ ) );
+
+                * ( rep_++ ) = RATIONAL_MOVE ( q_ );
+
+            } else {
+
+                if ( horner_ ) rfi_.pre =
+                        RATIONAL_MOVE ( op_plus()
+                                        ( op_multiplies()
+                                          ( rfi_.pre, DecomposeBaseTraits<integer_type,
+                                            std::numeric_limits<integer_type>::is_signed>::Base ),
+                                          q_ ) );
+
+                * ( pre_++ ) = RATIONAL_MOVE ( q_ );
+            }
+
+            return ret;
+        }
+
+    private:
+        rf_info& rfi_;
+        typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
+                 const integer_type>::ResultT d_;
+        mutable typename DecomposeBaseTraits<integer_type,
+                std::numeric_limits<integer_type>::is_signed>::digit_type q_;
+        mutable PreOIter pre_;
+        mutable RepOIter rep_;
+        bool horner_;
+    };
+
+    static std::size_t _strip_base ( integer_type& d, const integer_type& base );
+
+    // a real gcd regardless of the policy (GCD_null doesn't reduce)
+    static integer_type _euclid ( const integer_type& a, const integer_type& b ) {
+        return GCD_euclid<integer_type, std::numeric_limits<integer_type>::is_signed, CHKOP,
+               TYPE_CONVERT>() ( a, b );
+    }
+
+    template<class IIter>
+    static std::size_t countLeading ( IIter first, IIter last,
+                                      const typename std::iterator_traits<IIter>::value_type& v =
+                                          typename std::iterator_traits<IIter>::value_type() ) {
+
+        const IIter& f ( std::find_if ( first, last, std::not1 ( std::bind2nd ( std::equal_to
+                                        <typename std::iterator_traits<IIter>::value_type>(),
+                                        v ) ) ) );
+
+        return f != last ? static_cast<std::size_t> ( std::distance ( first, f ) ) : 0u;
+    }
+
+    template<class Op>
+    Rational& knuth_addSub ( const Rational& o );
+
+public:
+    static const integer_type zero_; ///< represents @em zero in the given Rational::integer_type
+    static const integer_type one_; ///< represents @em one in the given Rational::integer_type
+
+private:
+    integer_type m_numer;
+    integer_type m_denom;
+};
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+const typename Rational<T, GCD, CHKOP, Alloc>::integer_type Rational<T, GCD, CHKOP, Alloc>::zero_
+    = integer_type();
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+const typename Rational<T, GCD, CHKOP, Alloc>::integer_type Rational<T, GCD, CHKOP, Alloc>::one_
+    = integer_type ( 1 );
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc>::Rational ( const integer_type& n, const integer_type& d )
+    : m_numer ( n ), m_denom ( d ) {
+
+#ifdef __EXCEPTIONS
+    if ( m_denom == zero_ ) throw std::domain_error ( "denominator can't be null" );
+#endif
+
+    reduce();
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+template<typename NumberType> Rational<T, GCD, CHKOP, Alloc>::Rational ( const NumberType& nt )
+    : m_numer ( typename RationalTraits<NumberType>::type_convert ( nt ).
+                template convert<integer_type> () ), m_denom ( one_ ) {
+
+    _approxFract<integer_type, GCD, CHKOP, Alloc, NumberType,
+                 ! ( std::numeric_limits<NumberType>::is_integer ||
+                     std::numeric_limits<NumberType>::is_exact ) >() ( *this, nt );
+}
+
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic push
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc>::Rational ( const rf_info& info ) : m_numer ( info.pre ),
+    m_denom () {
+
+    typedef RadixPowerTraits<integer_type> rp;
+
+    const int base = DecomposeBaseTraits<integer_type,
+                     std::numeric_limits<integer_type>::is_signed>::Base;
+
+    m_denom = RATIONAL_MOVE ( rp::pow ( base, rp::digits ( info.pre < zero_ ?
+                                        integer_type ( op_negate() ( info.pre ) ) : info.pre,
+                                        base ) + info.pre_leading_zeros ) );
+
+    if ( std::not_equal_to<integer_type>() ( info.reptend, zero_ ) ) {
+
+        const integer_type& r ( op_minus() ( rp::pow ( base, rp::digits ( info.reptend < zero_ ?
+                                             integer_type ( op_negate() ( info.reptend ) ) :
+                                             info.reptend, base ) + info.leading_zeros ),
+                                             one_ ) );
+
+        m_numer = RATIONAL_MOVE ( op_plus() ( op_multiplies() ( m_numer, r ), info.reptend ) );
+        m_denom = RATIONAL_MOVE ( op_multiplies() ( m_denom, r ) );
+    }
+
+    reduce();
+}
+#pragma GCC diagnostic pop
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc> template<typename IIter>
+Rational<T, GCD, CHKOP, Alloc> Rational<T, GCD, CHKOP, Alloc>::Rational::eval ( IIter first,
+        IIter last ) {
+
+    _eval_state<typename std::iterator_traits<IIter>::value_type> state;
+
+    return _eval ( first, last, state );
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc> template<typename IIter, typename State>
+Rational<T, GCD, CHKOP, Alloc> Rational<T, GCD, CHKOP, Alloc>::Rational::_eval ( IIter first,
+        IIter last, State& state ) {
+
+    Rational result;
+
+    typedef typename std::iterator_traits<IIter>::value_type value_type;
+    typedef std::stack<value_type, std::vector<value_type, Alloc<value_type> > > SYARD;
+    typedef std::vector<value_type, Alloc<value_type> > TOKENS;
+
+    state.clear();
+
+    SYARD& syard ( state.syard );
+    TOKENS& token ( state.token );
+    evalStack& rpn ( state.rpn );
+
+    typename ContainerPolicy<TOKENS>::iterator
+    tokenIter ( ContainerPolicy<TOKENS>::make_iterator ( token ) );
+
+    if ( first != last ) {
+
+        value_type prev ( 0 );
+        typename SYARD::value_type top(0);
+
+        while ( first != last ) {
+
+            typename tmp::_ifThenElse<tmp::_isClassT<value_type>::Yes,
+                     const value_type&, const value_type>::ResultT cur ( *first );
+
+            if ( !isDelimiter ( cur ) ) {
+
+                if ( ( cur >= '0' && cur <= '9' ) || cur == '.' ) {
+                    * ( tokenIter++ ) = RATIONAL_MOVE ( cur );
+                } else {
+#ifdef __EXCEPTIONS
+                    throw std::runtime_error (
+                        std::string ( "invalid character(s) in expression" ) );
+#endif
+                }
+
+                prev = *first++;
+
+                if ( first == last ) pushToken ( rpn, token );
+
+                continue;
+
+            } else if ( !token.empty() ) pushToken ( rpn, token );
+
+            if ( cur == ' ' || cur == '\t' || cur == '\n' ) {
+                ++first;
+                continue;
+            }
+
+            if ( cur == '(' ) {
+
+                prev = cur;
+                syard.push ( cur );
+
+            } else if ( cur == ')' ) {
+
+                prev = cur;
+
+                while ( !syard.empty() && ( top = RATIONAL_MOVE ( syard.top() ) ) != '(' ) {
+
+                    if ( !eval_ ( top, rpn ) ) {
+#ifdef __EXCEPTIONS
+                        throw std::runtime_error ( std::string ( "invalid expression" ) );
+#endif
+                    }
+
+                    syard.pop();
+                }
+
+                if ( !syard.empty() && top == '(' ) {
+
+                    syard.pop();
+
+                } else {
+#ifdef __EXCEPTIONS
+                    throw std::runtime_error ( "mismatched braces" );
+#endif
+                }
+
+            } else if ( isOperator ( cur ) ) {
+
+                value_type cop ( cur );
+
+                const bool isUnary = !prev || ( prev == '(' || isOperator ( prev ) );
+
+                if ( cur == '-' && isUnary ) {
+                    cop = 1;
+                } else if ( cur == '+' && isUnary ) {
+                    cop = 2;
+                } else {
+
+                    while ( !syard.empty() && isOperator ( top = RATIONAL_MOVE ( syard.top() ) ) &&
+                            ( ( isLeftAssoc ( cop ) && getPrec ( cop ) <= getPrec ( top ) ) ||
+                              ( !isLeftAssoc ( cop ) && getPrec ( cop ) < getPrec ( top ) ) ) ) {
+
+                        if ( !eval_ ( top, rpn ) ) {
+#ifdef __EXCEPTIONS
+                            throw std::runtime_error ( std::string ( "invalid expression" ) );
+#endif
+                        }
+
+                        syard.pop();
+                    }
+                }
+
+                prev = cur;
+                syard.push ( cop );
+            }
+
+            ++first;
+        }
+
+        while ( !syard.empty() && isOperator ( top = RATIONAL_MOVE ( syard.top() ) ) ) {
+
+            if ( !eval_ ( top, rpn ) ) {
+#ifdef __EXCEPTIONS
+                throw std::runtime_error ( std::string ( "invalid expression" ) );
+#endif
+            }
+
+            syard.pop();
+        }
+
+        if ( ! ( !syard.empty() || rpn.empty() || rpn.size() > 1 ) ) {
+            return rpn.top();
+        } else {
+#ifdef __EXCEPTIONS
+            throw std::runtime_error ( std::string ( "invalid expression" ) );
+#endif
+        }
+    }
+
+    return result;
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc>::~Rational() {}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc>& Rational<T, GCD, CHKOP, Alloc>::reduce() {
+
+    typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
+             const integer_type>::ResultT x ( m_numer != zero_ ?
+                     GCD<T, std::numeric_limits<integer_type>::is_signed,
+                     CHKOP, TYPE_CONVERT>() ( m_numer, m_denom ) : m_denom );
+
+    if ( std::not_equal_to<integer_type>() ( x, one_ ) ) {
+        m_numer = RATIONAL_MOVE ( op_divides() ( m_numer, x ) );
+        m_denom = RATIONAL_MOVE ( op_divides() ( m_denom, x ) );
+    }
+
+    return _swapSign<integer_type, GCD, CHKOP, Alloc,
+           std::numeric_limits<integer_type>::is_signed>() ( *this );
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc> Rational<T, GCD, CHKOP, Alloc>:: _sqrt() const {
+
+#ifdef __EXCEPTIONS
+    if ( std::numeric_limits<integer_type>::is_signed && m_numer < zero_ ) {
+        throw std::domain_error ( "sqrt is undefined for negative numbers" );
+    }
+
+    if ( m_numer == zero_ ) throw std::domain_error ( "sqrt is undefined for zero" );
+#endif
+
+    if ( m_numer == m_denom ) return *this;
+
+    const Rational half ( one_, one_ + one_ );
+    Rational aux, inv, x ( SQRT_HERON_ITERATE<Rational>() ( *this, one_, one_ ) ?
+                           ( Rational ( one_, one_ ) += *this ) *= half : *this );
+
+    while ( SQRT_HERON_ITERATE<Rational>() ( *this, m_numer,
+            ( inv = RATIONAL_MOVE ( x.inverse() ) ).denominator() ) &&
+            SQRT_HERON_ITERATE<Rational>() ( x, ( aux = Rational ( *this ) *= inv ) ) ) {
+
+        x += aux;
+        x *= half;
+    }
+
+    return _psq<integer_type, GCD, CHKOP, Alloc>() ( x, *this );
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+template<class Op> Rational<T, GCD, CHKOP, Alloc> &
+Rational<T, GCD, CHKOP, Alloc>::knuth_addSub ( const Rational<T, GCD, CHKOP, Alloc>& o ) {
+
+    typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
+             const integer_type>::ResultT d1 ( GCD<integer_type,
+                     std::numeric_limits<integer_type>::is_signed,
+                     CHKOP, TYPE_CONVERT>() ( m_denom, o.m_denom ) );
+
+    if ( d1 == one_ ) {
+
+        m_numer = RATIONAL_MOVE ( Op() ( op_multiplies() ( m_numer, o.m_denom ),
+                                         op_multiplies() ( m_denom, o.m_numer ) ) );
+        m_denom = RATIONAL_MOVE ( op_multiplies() ( m_denom, o.m_denom ) );
+
+    } else {
+
+        typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
+                 const integer_type>::ResultT t ( Op() (
+                             op_multiplies() ( m_numer, ( op_divides() ( o.m_denom, d1 ) ) ),
+                             op_multiplies() ( o.m_numer,
+                                               ( op_divides() ( m_denom, d1 ) ) ) ) );
+
+        typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
+                 const integer_type>::ResultT d2 ( GCD<integer_type,
+                         std::numeric_limits<integer_type>::is_signed,
+                         CHKOP, TYPE_CONVERT>() ( t, d1 ) );
+
+        m_numer = RATIONAL_MOVE ( op_divides() ( t, d2 ) );
+        m_denom = RATIONAL_MOVE ( op_multiplies() ( op_divides() ( m_denom, d1 ),
+                                  op_divides() ( o.m_denom, d2 ) ) );
+    }
+
+    return *this;
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc>
+Rational<T, GCD, CHKOP, Alloc>::operator+ ( const Rational& other ) const {
+    return ( Rational ( *this ) += other );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
+RATIONAL_CONSTEXPR NumberType&
+operator+= ( NumberType& n, const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ( n = Rational<T, GCD, CHKOP, Alloc> ( n ) += o );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam NumberType the number type
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
+Rational<T, GCD, CHKOP, Alloc> operator+ ( const Rational<T, GCD, CHKOP, Alloc>& o,
+        const NumberType& n ) {
+    return ( o + Rational<T, GCD, CHKOP, Alloc> ( n ) );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
+RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc> operator+ ( const NumberType& n,
+        const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ( Rational<T, GCD, CHKOP, Alloc> ( n ) + o );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
+RATIONAL_CONSTEXPR NumberType& operator-= ( NumberType& n,
+        const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ( n = Rational<T, GCD, CHKOP, Alloc> ( n ) -= o );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam NumberType the number type
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
+Rational<T, GCD, CHKOP, Alloc> operator- ( const Rational<T, GCD, CHKOP, Alloc>& o,
+        const NumberType& n ) {
+    return o - Rational<T, GCD, CHKOP, Alloc> ( n );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
+RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc> operator- ( const NumberType& n,
+        const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ( Rational<T, GCD, CHKOP, Alloc> ( n ) - o );
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc>
+Rational<T, GCD, CHKOP, Alloc>::operator* ( const Rational& other ) const {
+    return ( Rational ( *this ) *= other );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
+RATIONAL_CONSTEXPR NumberType& operator*= ( NumberType& n,
+        const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ( n = Rational<T, GCD, CHKOP, Alloc> ( n ) *= o );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam NumberType the number type
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
+Rational<T, GCD, CHKOP, Alloc> operator* ( const Rational<T, GCD, CHKOP, Alloc>& o,
+        const NumberType& n ) {
+    return ( o * Rational<T, GCD, CHKOP, Alloc> ( n ) );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
+RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc> operator* ( const NumberType& n,
+        const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ( Rational<T, GCD, CHKOP, Alloc> ( n ) * o );
+}
+
+template<typename T, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc>& Rational<T, GCD, CHKOP, Alloc>::invert() {
+
+    using namespace std;
+    swap ( m_numer, m_denom );
+
+#ifdef __EXCEPTIONS
+    if ( m_denom == zero_ ) throw std::domain_error ( "division by zero" );
+#endif
+
+    return _swapSign<integer_type, GCD, CHKOP, Alloc,
+           std::numeric_limits<integer_type>::is_signed>() ( *this );
+}
+
+template<typename T, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
+RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc> Rational<T, GCD, CHKOP, Alloc>::inverse() const {
+    return Rational ( *this ).invert();
+}
+
+template<typename T, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc> Rational<T, GCD, CHKOP, Alloc>::sqrt() const {
+
+    if ( m_numer == m_denom ) return *this;
+
+    Rational p, q;
+
+    return ( ( p = RATIONAL_MOVE ( Rational ( m_numer, one_ )._sqrt() ) ).isInteger() &&
+             ( q = RATIONAL_MOVE ( Rational ( m_denom, one_ )._sqrt() ) ).isInteger() ) ?
+           Rational ( p.numerator(), q.numerator() ) : _sqrt();
+}
+
+template<typename T, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
+RATIONAL_CONSTEXPR typename Rational<T, GCD, CHKOP, Alloc>::mod_type
+Rational<T, GCD, CHKOP, Alloc>::mod() const {
+    return _mod<integer_type, GCD, CHKOP, Alloc,
+           std::numeric_limits<integer_type>::is_signed>() ( *this );
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+std::size_t Rational<T, GCD, CHKOP, Alloc>::_strip_base ( integer_type& d,
+        const integer_type& base ) {
+
+    std::size_t n = 0u;
+    integer_type g;
+
+    // every common factor stripped from the denominator delays the reptend by one digit,
+    // a real gcd is needed regardless of the policy (GCD_null would never strip anything)
+    while ( std::not_equal_to<integer_type>() ( g = GCD_euclid<integer_type,
+            std::numeric_limits<integer_type>::is_signed, CHKOP, TYPE_CONVERT>() ( d, base ),
+            one_ ) ) {
+        d = RATIONAL_MOVE ( op_divides() ( d, g ) );
+        ++n;
+    }
+
+    return n;
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc> template<class PreC, class RepC>
+typename Rational<T, GCD, CHKOP, Alloc>::integer_type
+Rational<T, GCD, CHKOP, Alloc>::decompose ( rf_info& rf_info, PreC& pre_digits, RepC& rep_digits,
+        bool digitsOnly ) const {
+
+    typedef cd_lambda<typename ContainerPolicy<PreC>::iterator,
+            typename ContainerPolicy<RepC>::iterator> digits;
+
+    ContainerPolicy<PreC>().clear ( pre_digits );
+    ContainerPolicy<RepC>().clear ( rep_digits );
+
+    const integer_type base ( DecomposeBaseTraits<integer_type,
+                              std::numeric_limits<integer_type>::is_signed>::Base );
+
+    std::size_t pre, rep = 0u;
+    integer_type d ( m_denom ), g ( GCD_euclid<integer_type,
+                                    std::numeric_limits<integer_type>::is_signed, CHKOP,
+                                    TYPE_CONVERT>() ( m_numer < zero_ ? integer_type ( -m_numer ) :
+                                            m_numer, m_denom ) ), w;
+
+    // the lengths depend on the reduced denominator, which GCD_null doesn't provide
+    if ( std::not_equal_to<integer_type>() ( g, one_ ) ) {
+        d = RATIONAL_MOVE ( op_divides() ( d, g ) );
+    }
+
+    pre = _strip_base ( d, base );
+
+    // the length of the reptend is the multiplicative order of the base modulo the rest,
+    // which exists as the rest is coprime to the base (zero would mean it isn't)
+    if ( std::not_equal_to<integer_type>() ( d, one_ ) ) {
+
+        for ( g = op_modulus() ( base, d ), rep = 1u; std::not_equal_to<integer_type>() ( g,
+                one_ ) && std::not_equal_to<integer_type>() ( g, zero_ ); ++rep ) {
+            g = RATIONAL_MOVE ( op_modulus() ( op_multiplies() ( g, base ), d ) );
+        }
+    }
+
+    ContainerPolicy<PreC>::reserve ( pre_digits, pre );
+    ContainerPolicy<RepC>::reserve ( rep_digits, rep );
+
+    const digits f ( m_denom, ContainerPolicy<PreC>::make_iterator ( pre_digits ),
+                     ContainerPolicy<RepC>::make_iterator ( rep_digits ), rf_info, !digitsOnly );
+
+    integer_type r ( f ( _remquo<T, GCD, CHKOP, Alloc> () ( m_numer < zero_ ?
+                         integer_type ( -m_numer ) : m_numer, m_denom, w ) ) );
+
+    for ( ; pre; --pre ) r = RATIONAL_MOVE ( f ( r, digits::PRE ) );
+    for ( ; rep; --rep ) r = RATIONAL_MOVE ( f ( r, digits::REP ) );
+
+    rf_info.negative = m_numer < zero_;
+    rf_info.pre_leading_zeros = countLeading ( pre_digits.begin(), pre_digits.end() );
+    rf_info.leading_zeros = countLeading ( rep_digits.begin(), rep_digits.end() );
+
+    if ( !digitsOnly && rf_info.negative ) {
+        rf_info.pre = RATIONAL_MOVE ( -rf_info.pre );
+        rf_info.reptend = RATIONAL_MOVE ( -rf_info.reptend );
+    }
+
+    return !rf_info.negative ? w : integer_type ( -w );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
+RATIONAL_CONSTEXPR NumberType& operator/= ( NumberType& n,
+        const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ( n = Rational<T, GCD, CHKOP, Alloc> ( n ) /= o );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam NumberType the number type
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
+Rational<T, GCD, CHKOP, Alloc> operator/ ( const Rational<T, GCD, CHKOP, Alloc>& o,
+        const NumberType& n ) {
+    return ( o / Rational<T, GCD, CHKOP, Alloc> ( n ) );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T, template<typename, bool,
+         template<class, typename, bool> class, template<typename> class> class GCD,
+         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
+RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc> operator/ ( const NumberType& n,
+        const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ( Rational<T, GCD, CHKOP, Alloc> ( n ) / o );
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc> Rational<T, GCD, CHKOP, Alloc>&
+Rational<T, GCD, CHKOP, Alloc>::operator*= ( const Rational& other ) {
+
+    typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
+             const integer_type>::ResultT d2 ( GCD<integer_type,
+                     std::numeric_limits<integer_type>::is_signed, CHKOP, TYPE_CONVERT>()
+                     ( m_denom, other.m_numer ) );
+
+    typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
+             const integer_type>::ResultT d1 ( d2 == one_ ? GCD<integer_type,
+                     std::numeric_limits<integer_type>::is_signed, CHKOP, TYPE_CONVERT>()
+                     ( m_numer, other.m_denom ) : one_ );
+
+    if ( ! ( d2 == one_ && d1 == one_ ) ) {
+
+        m_numer = RATIONAL_MOVE ( op_multiplies() ( ( op_divides() ( m_numer, d1 ) ),
+                                  ( op_divides() ( other.m_numer, d2 ) ) ) );
+        m_denom = RATIONAL_MOVE ( op_multiplies() ( ( op_divides() ( m_denom, d2 ) ),
+                                  ( op_divides() ( other.m_denom, d1 ) ) ) );
+
+    } else {
+        m_numer = RATIONAL_MOVE ( op_multiplies() ( m_numer, other.m_numer ) );
+        m_denom = RATIONAL_MOVE ( op_multiplies() ( m_denom, other.m_denom ) );
+    }
+
+    return *this;
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc> Rational<T, GCD, CHKOP, Alloc>&
+Rational<T, GCD, CHKOP, Alloc>::operator%= ( const Rational& o ) {
+
+    if ( std::not_equal_to<integer_type>() ( m_denom, o.m_denom ) ) {
+
+        typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
+                 const integer_type>::ResultT l ( _lcm<integer_type, GCD, CHKOP, Alloc,
+                         std::numeric_limits<integer_type>::is_signed>()
+                         ( m_denom, o.m_denom ) );
+
+        typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
+                 const integer_type>::ResultT a ( op_multiplies()
+                         ( op_divides() ( l, o.m_denom ), o.m_numer ) );
+
+        m_numer = RATIONAL_MOVE ( op_modulus() ( op_plus() ( op_modulus() ( op_multiplies()
+                                  ( op_divides() ( l, m_denom ), m_numer ), a ), a ), a ) );
+        m_denom = RATIONAL_MOVE ( l );
+
+    } else {
+        m_numer = RATIONAL_MOVE ( op_modulus() ( op_plus() ( op_modulus() ( m_numer, o.m_numer ),
+                                  o.m_numer ), o.m_numer ) );
+    }
+
+    return reduce();
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+std::string Rational<T, GCD, CHKOP, Alloc>::str ( bool mixed ) const {
+
+    std::string s ( _formatted_size ( mixed, _decimal_conv() ), '\0' );
+
+    s.resize ( static_cast<std::string::size_type> ( _to_chars ( &s[0], &s[0] + s.size(),
+               mixed, _decimal_conv() ) - &s[0] ) );
+
+    return s;
+}
+
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic push
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc> template<class Conv>
+char *Rational<T, GCD, CHKOP, Alloc>::_to_chars ( char *first, char *last, bool mixed,
+        const Conv& conv ) const {
+
+    const bool fraction = std::not_equal_to<integer_type>() ( m_denom, one_ );
+
+    if ( mixed && fraction ) {
+
+        typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
+                 const integer_type>::ResultT w ( op_divides() ( m_numer, m_denom ) );
+
+        if ( std::not_equal_to<integer_type>() ( w, zero_ ) ) {
+
+            if ( ! ( first = conv ( first, last, w ) ) || first == last ) return 0L;
+
+            *first++ = ' ';
+        }
+
+        typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
+                 const integer_type>::ResultT r ( op_modulus() ( m_numer, m_denom ) );
+
+        if ( ! ( first = conv ( first, last, r < zero_ ?
+                                integer_type ( op_negate() ( r ) ) : r ) ) ) return 0L;
+
+    } else if ( ! ( first = conv ( first, last, m_numer ) ) ) return 0L;
+
+    if ( fraction ) {
+
+        if ( first == last ) return 0L;
+
+        *first++ = '/';
+        first = conv ( first, last, m_denom );
+    }
+
+    return first;
+}
+#pragma GCC diagnostic pop
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc> template<class Conv>
+std::size_t Rational<T, GCD, CHKOP, Alloc>::_formatted_size ( bool mixed,
+        const Conv& conv ) const {
+
+    if ( std::not_equal_to<integer_type>() ( m_denom, one_ ) ) {
+
+        const std::size_t d = conv.size ( m_denom );
+
+        // the whole part is not wider than the numerator, the remainder not wider than d
+        return conv.size ( m_numer ) + 1u + d + ( mixed ? 1u + d : 0u );
+    }
+
+    return conv.size ( m_numer );
+}
+
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic push
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+char *Rational<T, GCD, CHKOP, Alloc>::_to_chars_fixed ( char *first, char *last,
+        std::size_t precision, int base ) const {
+
+    if ( !_is_radix ( base ) ) return 0L;
+
+    typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
+             const integer_type>::ResultT w ( op_divides() ( m_numer, m_denom ) );
+
+    if ( m_numer < zero_ && !std::not_equal_to<integer_type>() ( w, zero_ ) ) {
+
+        if ( first == last ) return 0L;
+
+        *first++ = '-';
+    }
+
+    if ( ! ( first = _radix_conv ( base ) ( first, last, w ) ) ) return 0L;
+
+    if ( precision ) {
+
+        if ( first == last ) return 0L;
+
+        *first++ = '.';
+
+        typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
+                 const integer_type>::ResultT r ( op_modulus() ( m_numer, m_denom ) );
+
+        first = RadixExpandTraits<integer_type>::expand ( first, last, r < zero_ ?
+                integer_type ( op_negate() ( r ) ) : r, m_denom, base, precision );
+    }
+
+    return first;
+}
+#pragma GCC diagnostic pop
+
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic push
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+const char *Rational<T, GCD, CHKOP, Alloc>::_from_chars ( const char *first, const char *last,
+        Rational& r ) {
+
+    typedef FromCharsTraits<integer_type> fc;
+
+    const bool neg = first != last && *first == '-';
+
+    if ( first != last && ( neg || *first == '+' ) ) ++first;
+
+    if ( neg && !std::numeric_limits<integer_type>::is_signed ) return 0L;
+
+    integer_type n, d ( one_ );
+
+    if ( ! ( first = fc::convert ( first, last, n ) ) ) return 0L;
+
+    if ( first != last && *first == '/' ) {
+
+        const char *e = fc::convert ( first + 1, last, d );
+
+        if ( e && std::not_equal_to<integer_type>() ( d, zero_ ) ) {
+            first = e;
+        } else {
+            d = one_;
+        }
+    }
+
+    r = Rational ( neg ? integer_type ( op_negate() ( n ) ) : n, d );
+
+    return first;
+}
+#pragma GCC diagnostic pop
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+const unsigned char *Rational<T, GCD, CHKOP, Alloc>::_deserialize ( const unsigned char *first,
+        const unsigned char *last, Rational& r, bool *more ) {
+
+    typedef SerializeTraits<integer_type> st;
+
+    integer_type n, d;
+
+    if ( ! ( first = st::read ( first, last, n, more ) ) ||
+            ! ( first = st::read ( first, last, d, more ) ) ) return 0L;
+
+    if ( ! ( zero_ < d ) ) {
+        if ( more ) *more = false;
+        return 0L;
+    }
+
+    r.m_numer = RATIONAL_MOVE ( n );
+    r.m_denom = RATIONAL_MOVE ( d );
+
+    // serialize() writes reduced fractions only, but the input may come from elsewhere
+    r.reduce();
+
+    return first;
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc> template<class Container>
+bool Rational<T, GCD, CHKOP, Alloc>::_read_record ( std::istream& i, Container& buf,
+        char delim ) {
+
+    typedef std::istream::traits_type traits_type;
+    typedef traits_type::int_type int_type;
+
+    buf.clear();
+
+    const std::istream::sentry ok ( i );
+
+    if ( !ok ) return false;
+
+    std::streambuf *sb = i.rdbuf();
+    std::ios_base::iostate state = std::ios_base::goodbit;
+
+    unsigned int depth = 0u;
+    char last = 0;
+
+    for ( int_type c = sb->sgetc(); ; ) {
+
+        if ( traits_type::eq_int_type ( c, traits_type::eof() ) ) {
+            state |= std::ios_base::eofbit;
+            break;
+        }
+
+        const char cur = traits_type::to_char_type ( c );
+
+        if ( delim && cur == delim ) {
+            sb->sbumpc();
+            break;
+        }
+
+        if ( cur == ' ' || cur == '\t' || cur == '\n' || cur == '\r' || cur == '\v' ||
+                cur == '\f' ) {
+
+            bool eol = cur == '\n';
+
+            while ( !traits_type::eq_int_type ( c = sb->snextc(), traits_type::eof() ) ) {
+
+                const char ws = traits_type::to_char_type ( c );
+
+                if ( ws == '\n' ) {
+                    eol = true;
+                } else if ( ws != ' ' && ws != '\t' && ws != '\r' && ws != '\v' && ws != '\f' ) {
+                    break;
+                }
+            }
+
+            if ( traits_type::eq_int_type ( c, traits_type::eof() ) ) continue;
+
+            if ( !delim || eol ) {
+
+                const char nxt = traits_type::to_char_type ( c );
+
+                bool cont = depth || last == '(' || isOperator ( last ) || nxt == '*' ||
+                            nxt == '/' || nxt == '%' || nxt == ')' || ( delim && nxt == delim );
+
+                if ( !cont && ( nxt == '+' || nxt == '-' ) ) {
+
+                    // a sign directly followed by its operand starts the next record
+                    c = sb->snextc();
+
+                    cont = traits_type::eq_int_type ( c, traits_type::eof() ) ||
+                           isDelimiter ( traits_type::to_char_type ( c ) ) ||
+                           traits_type::eq_int_type ( sb->sputbackc ( nxt ), traits_type::eof() );
+
+                    if ( cont ) {
+                        buf.push_back ( ' ' );
+                        buf.push_back ( last = nxt );
+                        continue;
+                    }
+
+                    c = sb->sgetc();
+                }
+
+                if ( !cont ) break;
+            }
+
+            buf.push_back ( ' ' );
+            continue;
+        }
+
+        if ( cur == '(' ) {
+            ++depth;
+        } else if ( cur == ')' && depth ) {
+            --depth;
+        }
+
+        buf.push_back ( last = cur );
+        c = sb->snextc();
+    }
+
+    while ( !buf.empty() && buf.back() == ' ' ) buf.pop_back();
+
+    if ( buf.empty() ) state |= std::ios_base::failbit;
+
+    if ( state != std::ios_base::goodbit ) i.setstate ( state );
+
+    return !buf.empty();
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc> Rational<T, GCD, CHKOP, Alloc>::eval ( const char *expr ) const {
+
+    if ( expr && *expr ) {
+#if __EXCEPTIONS
+        try {
+#endif
+            return eval ( expr, expr + std::strlen ( expr ) );
+#if __EXCEPTIONS
+        } catch ( const std::domain_error& e ) {
+            throw std::domain_error ( std::string ( e.what() ).
+                                      append ( ": " ).append ( expr ) );
+        } catch ( const std::runtime_error& e ) {
+            throw std::runtime_error ( std::string ( e.what() ).
+                                       append ( ": " ).append ( expr ) );
+        }
+#endif
+    }
+
+    return Rational();
+}
+
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic push
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+bool Rational<T, GCD, CHKOP, Alloc>::eval_ ( const char op, evalStack& s ) {
+
+    if ( !s.empty() ) {
+
+        Rational operand[2] = { s.top(), Rational() };
+
+        s.pop();
+
+        if ( op > 2 && s.empty() ) return false;
+
+        switch ( op ) {
+        case '/':
+#if __EXCEPTIONS
+            if ( operand[0] == Rational() ) {
+                throw std::domain_error ( std::string ( "division by zero in expression" ) );
+            }
+#endif
+            operand[1] = RATIONAL_MOVE ( s.top() );
+            s.pop();
+            s.push ( RATIONAL_MOVE ( operand[1] /= operand[0] ) );
+            return true;
+        case '*':
+            operand[1] = RATIONAL_MOVE ( s.top() );
+            s.pop();
+            s.push ( RATIONAL_MOVE ( operand[1] *= operand[0] ) );
+            return true;
+        case '+':
+            operand[1] = RATIONAL_MOVE ( s.top() );
+            s.pop();
+            s.push ( RATIONAL_MOVE ( operand[1] += operand[0] ) );
+            return true;
+        case '-':
+            operand[1] = RATIONAL_MOVE ( s.top() );
+            s.pop();
+            s.push ( RATIONAL_MOVE ( operand[1] -= operand[0] ) );
+            return true;
+        case '%':
+#if __EXCEPTIONS
+            if ( operand[0] == Rational() ) {
+                throw std::domain_error ( std::string ( "modulus by zero in expression" ) );
+            }
+#endif
+            operand[1] = RATIONAL_MOVE ( s.top() );
+            s.pop();
+            s.push ( RATIONAL_MOVE ( operand[1] %= operand[0] ) );
+            return true;
+        case 1:
+            s.push ( RATIONAL_MOVE ( -operand[0] ) );
+            return true;
+        case 2:
+            s.push ( RATIONAL_MOVE ( operand[0] ) );
+            return true;
+        }
+    }
+
+    return false;
+}
+#pragma GCC diagnostic pop
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T,
+         template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+RATIONAL_CONSTEXPR NumberType& operator%= ( NumberType& n,
+        const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ( n = Rational<T, GCD, CHKOP, Alloc> ( n ) %= o );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam NumberType the number type
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
+Rational<T, GCD, CHKOP, Alloc> operator% ( const Rational<T, GCD, CHKOP, Alloc>& o,
+        const NumberType& n ) {
+    return ( o % Rational<T, GCD, CHKOP, Alloc> ( n ) );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T,
+         template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc> operator% ( const NumberType& n,
+        const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ( Rational<T, GCD, CHKOP, Alloc> ( n ) % o );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T,
+         template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+RATIONAL_CONSTEXPR bool operator== ( const NumberType& n,
+                                     const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ( Rational<T, GCD, CHKOP, Alloc> ( n ) == o );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam NumberType the number type
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
+bool operator== ( const Rational<T, GCD, CHKOP, Alloc>& o, const NumberType& n ) {
+    return ( o == Rational<T, GCD, CHKOP, Alloc> ( n ) );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T,
+         template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+RATIONAL_CONSTEXPR bool operator!= ( const NumberType& n,
+                                     const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ! ( Rational<T, GCD, CHKOP, Alloc> ( n ) == o );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam NumberType the number type
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
+bool operator!= ( const Rational<T, GCD, CHKOP, Alloc>& o, const NumberType& n ) {
+    return ! ( o == Rational<T, GCD, CHKOP, Alloc> ( n ) );
+}
+
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+RATIONAL_CONSTEXPR bool Rational<T, GCD, CHKOP, Alloc>::operator< ( const Rational& other ) const {
+    return ( m_numer * other.m_denom ) < ( other.m_numer * m_denom );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T,
+         template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+RATIONAL_CONSTEXPR bool operator< ( const NumberType& n,
+                                    const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ( Rational<T, GCD, CHKOP, Alloc> ( n ) < o );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam NumberType the number type
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType>
+RATIONAL_CONSTEXPR bool operator< ( const Rational<T, GCD, CHKOP, Alloc>& o, const NumberType& n ) {
+    return ( o < Rational<T, GCD, CHKOP, Alloc> ( n ) );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T,
+         template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+RATIONAL_CONSTEXPR bool operator<= ( const NumberType& n,
+                                     const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ! ( o < Rational<T, GCD, CHKOP, Alloc> ( n ) );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam NumberType the number type
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
+bool operator<= ( const Rational<T, GCD, CHKOP, Alloc>& o, const NumberType& n ) {
+    return ! ( Rational<T, GCD, CHKOP, Alloc> ( n ) < o );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T,
+         template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+RATIONAL_CONSTEXPR bool operator> ( const NumberType& n, const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return o < Rational<T, GCD, CHKOP, Alloc> ( n );
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam NumberType the number type
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename T,
+         template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
+bool operator> ( const Rational<T, GCD, CHKOP, Alloc>& o, const NumberType& n ) {
+    return Rational<T, GCD, CHKOP, Alloc> ( n ) < o;
+}
+
+/**
+ * @relates Rational
+ *
+ * @tparam NumberType the number type
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename NumberType, typename T,
+         template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+RATIONAL_CONSTEXPR bool operator>= ( const NumberType& n,
+                                     const Rational<T, GCD, CHKOP, Alloc>& o ) {
+    return ! ( Rational<T, GCD, CHKOP, Alloc> ( n ) < o );
+}
 
-    template<template<typename, bool, template<class, typename, bool> class,
-             template<typename> class> class U, template<class, typename, bool> class V,
-             template<typename> class W>
-    RATIONAL_CONSTEXPR friend bool operator>= ( const Rational& x,
-            const Rational<integer_type, U, V, W>& y ) {
-        return ( x >= Rational ( y.numerator(), y.denominator() ) );
-    }
+/**
+ * @relates Rational
+ *
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam NumberType the number type
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
+bool operator>= ( const Rational<T, GCD, CHKOP, Alloc>& o, const NumberType& n ) {
+    return ! ( o < Rational<T, GCD, CHKOP, Alloc> ( n ) );
+}
 
-    /**
-     * @brief test if it is the neutral element to addition and subtraction
-     *
-     * Tests if the @c numerator is equal to the default constructed @c integer_type
-     *
-     * @note @f$ 0 + x = x + 0 = x @f$ and @f$ 0 - x = x - 0 = x @f$
-     *
-     * @warning it does @b not do the test for the neutral element to multiplication and division
-     *
-     * @return @c true if it is the neutral element to addition and subtraction, @c false otherwise
-     */
-    RATIONAL_CONSTEXPR bool operator!() const {
-        return m_numer == zero_;
-    }
+template<typename NumberType, template<typename> class EPSILON>
+struct _approxUtils {
 
-    /**
-     * @brief generates the string representation of %Rational
-     *
-     * @param[in] mixed if @c true, than a mixed (inproper) fraction is generated
-     *
-     * @return the string representation of %Rational
-     */
-    std::string str ( bool mixed = false ) const;
+    RATIONAL_NOCOPYASSIGN ( _approxUtils );
 
-    /**
-     * @brief output stream operator
-     *
-     * Sends a string representation of %Rational to a @c std::ostream
-     *
-     * @see str(bool)
-     *
-     * @param[out] o the stream to send to
-     * @param[in] r the %Rational to send to the stream @c o
-     *
-     * @return the stream @c o
-     */
-    RATIONAL_CONSTEXPR friend std::ostream& operator<< ( std::ostream& o, const Rational& r ) {
-        return ( o << r.str() );
+    static bool approximated ( const NumberType& af, const NumberType& nt ) {
+        return abs ( af - nt ) < eps_;
     }
 
-    /**
-     * @brief reads in an @c expression from a @c std::istream and assign it to @c r
-     *
-     * @see Rational(const char *expr)
-     *
-     * @param[in] i the stream to read from
-     * @param[out] r the %Rational to assign to
-     *
-     * @return the stream @c i
-     */
-    friend std::istream& operator>> ( std::istream& i, Rational& r ) {
+    static NumberType reciprocal ( const NumberType& x ) {
+        return one_ / x;
+    }
 
-        r = RATIONAL_MOVE ( eval ( std::istreambuf_iterator<std::istream::char_type> ( i ),
-                                   std::istreambuf_iterator<std::istream::char_type>() ) );
+    const static NumberType eps_;
 
-        return i;
+private:
+    static NumberType abs ( const NumberType& nt ) {
+        return nt < NumberType() ? NumberType ( -nt ) : nt;
     }
 
 private:
-    Rational& reduce();
+    const static NumberType one_;
+};
 
-    Rational _sqrt() const;
+template<typename NumberType, template<typename> class EPSILON>
+const NumberType _approxUtils<NumberType, EPSILON>::eps_ ( EPSILON<NumberType>::value() );
 
-    RATIONAL_CONSTEXPR static bool isOperator ( const char op ) {
-        return op == '/' || op == '*' || op == '+' || op == '-' || op == '%' || op == 1 || op == 2;
-    }
+template<typename NumberType, template<typename> class EPSILON>
+const NumberType _approxUtils<NumberType, EPSILON>::one_ ( 1 );
 
-    RATIONAL_CONSTEXPR static bool isDelimiter ( const char d ) {
-        return isOperator ( d ) || d == '(' || d == ')' || d == '\n' || d == ' ' || d == '\t';
-    }
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType, template<typename> class EPSILON,
+         template<typename> class CONV>
+struct _approxFract<T, GCD, CHKOP, Alloc, NumberType, true, EPSILON, CONV> {
+private:
+    typedef Rational<T, GCD, CHKOP, Alloc> rat;
 
-    RATIONAL_CONSTEXPR static bool isLeftAssoc ( const char op ) {
-        return op > 2;
-    }
+public:
+    void operator() ( rat& r, const NumberType& nt ) const;
 
-    RATIONAL_CONSTEXPR static unsigned char getPrec ( const char op ) {
-        return !isLeftAssoc ( op ) ? 2 : ( ( op == '*' || op == '/' || op == '%' ) ? 1 : 0 );
-    }
+private:
+    const static T zero_;
+    const static T one_;
+};
 
-    typedef std::stack<Rational, std::vector<Rational, Alloc<Rational> > > evalStack;
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType, template<typename> class EPSILON,
+         template<typename> class CONV>
+const T _approxFract<T, GCD, CHKOP, Alloc, NumberType, true, EPSILON, CONV>::zero_ = T();
 
-    static bool eval_ ( const char op, evalStack& s );
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType, template<typename> class EPSILON,
+         template<typename> class CONV>
+const T _approxFract<T, GCD, CHKOP, Alloc, NumberType, true, EPSILON, CONV>::one_ = T ( 1 );
 
-    template<typename Container>
-    static void pushToken ( evalStack& rpn, Container& token ) {
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#pragma GCC diagnostic push
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename NumberType, template<typename> class EPSILON,
+         template<typename> class CONV>
+void _approxFract<T, GCD, CHKOP, Alloc, NumberType, true, EPSILON, CONV>::operator() ( rat& r,
+        const NumberType& nt ) const {
 
-        rpn.push ( typename RationalTraits<typename Container::const_pointer>::type_convert
-                   ( token.data(), token.data() + token.size() ).template convert<typename
-                   ExpressionEvalTraits<integer_type>::NumberType>() );
+#ifdef __EXCEPTIONS
+    if ( ! ( ! ( std::numeric_limits<T>::max() == zero_ ||
+                 std::numeric_limits<T>::min() == zero_ ) &&
+             ( nt > CONV<T> ( std::numeric_limits<T>::max() ).template convert<NumberType>() ||
+               nt < CONV<T> ( std::numeric_limits<T>::min() ).template convert<NumberType>() ) ) ) {
+#endif
 
-        token.clear();
-    }
+        T m[2][2] = { { zero_, one_ }, { one_, zero_ } };
 
-    template<typename PreOIter, typename RepOIter, typename SizeType>
-    struct cd_lambda {
+        NumberType x ( nt );
+        rat res ( r );
 
-        typedef enum { PRE, REP } PUSH;
-        typedef SizeType size_type;
+        while ( !_approxUtils<NumberType, EPSILON>::approximated ( res, nt ) ) {
 
-        cd_lambda ( typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes,
-                    const integer_type&, const integer_type>::ResultT d, PreOIter pre,
-                    RepOIter rep, rf_info& rf_info, bool horner ) : rfi_ ( rf_info ), d_ ( d ),
-            q_(), pre_ ( pre ), rep_ ( rep ), horner_ ( horner ) {
+            using namespace std;
 
-            if ( horner ) rfi_.reptend = rfi_.pre = zero_;
-        }
+            typename tmp::_ifThenElse<tmp::_isClassT<T>::Yes, const T&,
+                     const T>::ResultT n ( CONV<NumberType> ( floor ( x ) ).template convert<T>() );
 
-        integer_type operator() ( const integer_type& r ) const {
-            return ( op_multiplies() ( op_modulus() ( r, d_ ),
-                                       DecomposeBaseTraits<integer_type,
-                                       std::numeric_limits<integer_type>::is_signed>::Base ) );
-        }
+            res.m_numer = typename rat::op_plus ()
+                          ( m[0][0], typename rat::op_multiplies () ( n, m[0][1] ) );
 
-        integer_type operator() ( const integer_type& r, PUSH p ) const {
+            m[0][0] = RATIONAL_MOVE ( m[0][1] );
+            m[0][1] = res.m_numer;
 
-            const integer_type ret ( op_multiplies() ( _remquo<integer_type, GCD, CHKOP, Alloc,
-                                     typename DecomposeBaseTraits<integer_type,
-                                     std::numeric_limits<integer_type>::is_signed>::digit_type>()
-                                     ( r, d_, q_ ), DecomposeBaseTraits<integer_type,
-                                     std::numeric_limits<integer_type>::is_signed>::Base ) );
-            if ( p == REP ) {
+            res.m_denom = typename rat::op_plus ()
+                          ( m[1][0], typename rat::op_multiplies () ( n, m[1][1] ) );
 
-                if ( horner_ ) rfi_.reptend =
-                        RATIONAL_MOVE ( op_plus()
-                                        ( op_multiplies()
-                                          ( rfi_.reptend, DecomposeBaseTraits<integer_type,
-                                            std::numeric_limits<integer_type>::is_signed>::Base ),
-                                          q_ ) );
+            m[1][0] = RATIONAL_MOVE ( m[1][1] );
+            m[1][1] = res.m_denom;
 
-                * ( rep_++ ) = RATIONAL_MOVE ( q_ );
+            typename tmp::_ifThenElse<tmp::_isClassT<NumberType>::Yes, const NumberType&,
+                     const NumberType>::ResultT
+                     d ( x - CONV<T> ( n ).template convert<NumberType>() );
 
+            if ( !_approxUtils<NumberType, EPSILON>::approximated ( d, NumberType() ) ) {
+                x = _approxUtils<NumberType, EPSILON>::reciprocal ( d );
             } else {
-
-                if ( horner_ ) rfi_.pre =
-                        RATIONAL_MOVE ( op_plus()
-                                        ( op_multiplies()
-                                          ( rfi_.pre, DecomposeBaseTraits<integer_type,
-                                            std::numeric_limits<integer_type>::is_signed>::Base ),
-                                          q_ ) );
-
-                * ( pre_++ ) = RATIONAL_MOVE ( q_ );
+                break;
             }
-
-            return ret;
         }
 
-    private:
-        rf_info& rfi_;
-        typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
-                 const integer_type>::ResultT d_;
-        mutable typename DecomposeBaseTraits<integer_type,
-                std::numeric_limits<integer_type>::is_signed>::digit_type q_;
-        mutable PreOIter pre_;
-        mutable RepOIter rep_;
-        bool horner_;
-    };
-
-    template<class IIter>
-    static std::size_t countLeading ( IIter first, IIter last,
-                                      const typename std::iterator_traits<IIter>::value_type& v =
-                                          typename std::iterator_traits<IIter>::value_type() ) {
-
-        const IIter& f ( std::find_if ( first, last, std::not1 ( std::bind2nd ( std::equal_to
-                                        <typename std::iterator_traits<IIter>::value_type>(),
-                                        v ) ) ) );
+        r = RATIONAL_MOVE ( res );
 
-        return f != last ? static_cast<std::size_t> ( std::distance ( first, f ) ) : 0u;
+#ifdef __EXCEPTIONS
+    } else {
+        throw std::domain_error ( "rational approximation overflow" );
     }
-
-    template<class F>
-    static void floyd_cycle_detect (
-        F f, typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes,
-        const integer_type&, const integer_type>::ResultT x );
-
-    template<class Op>
-    Rational& knuth_addSub ( const Rational& o );
-
-public:
-    static const integer_type zero_; ///< represents @em zero in the given Rational::integer_type
-    static const integer_type one_; ///< represents @em one in the given Rational::integer_type
-
-private:
-    integer_type m_numer;
-    integer_type m_denom;
-};
+#endif
+}
+#pragma GCC diagnostic pop
 
 template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-const typename Rational<T, GCD, CHKOP, Alloc>::integer_type Rational<T, GCD, CHKOP, Alloc>::zero_
-    = integer_type();
+         template<typename> class Alloc, typename NumberType, template<typename> class EPSILON,
+         template<typename> class CONV>
+struct _approxFract<T, GCD, CHKOP, Alloc, NumberType, false, EPSILON, CONV> {
+    void operator() ( const Rational<T, GCD, CHKOP, Alloc>&,
+                      const NumberType& ) const RATIONAL_NOEXCEPT {}
+};
 
 template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
          template<typename> class Alloc>
-const typename Rational<T, GCD, CHKOP, Alloc>::integer_type Rational<T, GCD, CHKOP, Alloc>::one_
-    = integer_type ( 1 );
+struct _abs<T, GCD, CHKOP, Alloc, true> {
+
+    RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc>
+    operator() ( const Rational<T, GCD, CHKOP, Alloc>& r ) const {
+        return r.numerator() < Rational<T, GCD, CHKOP, Alloc>::zero_ ? -r : r;
+    }
+};
 
 template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
          template<typename> class Alloc>
-Rational<T, GCD, CHKOP, Alloc>::Rational ( const integer_type& n, const integer_type& d )
-    : m_numer ( n ), m_denom ( d ) {
-
-#ifdef __EXCEPTIONS
-    if ( m_denom == zero_ ) throw std::domain_error ( "denominator can't be null" );
-#endif
+struct _abs<T, GCD, CHKOP, Alloc, false> {
 
-    reduce();
-}
+    RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc>
+    operator() ( const Rational<T, GCD, CHKOP, Alloc>& r ) const {
+        return r;
+    }
+};
 
 template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
          template<typename> class Alloc>
-template<typename NumberType> Rational<T, GCD, CHKOP, Alloc>::Rational ( const NumberType& nt )
-    : m_numer ( typename RationalTraits<NumberType>::type_convert ( nt ).
-                template convert<integer_type> () ), m_denom ( one_ ) {
+struct _mod<T, GCD, CHKOP, Alloc, true> {
 
-    _approxFract<integer_type, GCD, CHKOP, Alloc, NumberType,
-                 ! ( std::numeric_limits<NumberType>::is_integer ||
-                     std::numeric_limits<NumberType>::is_exact ) >() ( *this, nt );
-}
+    typedef std::pair<T, Rational<T, GCD, CHKOP, Alloc> > pair_type;
+
+    pair_type operator() ( const Rational<T, GCD, CHKOP, Alloc>& r ) const;
+};
 
-#pragma GCC diagnostic ignored "-Wtype-limits"
-#pragma GCC diagnostic push
 template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
          template<typename> class Alloc>
-Rational<T, GCD, CHKOP, Alloc>::Rational ( const rf_info& info ) : m_numer (), m_denom () {
+typename _mod<T, GCD, CHKOP, Alloc, true>::pair_type
+_mod<T, GCD, CHKOP, Alloc, true>::operator() ( const Rational<T, GCD, CHKOP, Alloc>& r ) const {
 
-    using namespace std;
+    const Rational<T, GCD, CHKOP, Alloc>& h ( Rational<T, GCD, CHKOP, Alloc> (
+                ( typename Rational<T, GCD, CHKOP, Alloc>::op_modulus()
+                  ( r.m_numer, r.m_denom ) ), r.m_denom ) );
 
-#if defined(_ISOC99_SOURCE) || _POSIX_C_SOURCE >= 200112L || defined(_DEFAULT_SOURCE)
-    typedef long double pow_promote_;
-#else
-    typedef double pow_promote_;
-#endif
-
-    *this = RATIONAL_MOVE (
-                Rational ( info.pre, info.reptend, info.reptend == zero_ ? one_ :
-                           static_cast<integer_type>
-                           ( _type_round_helper<integer_type>() (
-                               TYPE_CONVERT<pow_promote_>(
-                                   std::pow (static_cast<pow_promote_>(10),
-                                             TYPE_CONVERT<integer_type>(
-                                                 ceil ( log10 (
-                                                 ( info.reptend < zero_ ?
-                                                 integer_type ( -info.reptend )
-                                                 : info.reptend ) + one_ ) ) +
-                                                 info.leading_zeros).
-                                             template convert<pow_promote_>()
-                                            ) ).template convert<integer_type>()
-                                            - one_ ) ) ) *=
-                    Rational ( one_,
-                               static_cast<integer_type> (
-                                   _type_round_helper<integer_type>() (
-                                       TYPE_CONVERT<pow_promote_>(
-                                           std::pow (
-                                           static_cast<pow_promote_>(10),
-                                                     TYPE_CONVERT<integer_type>(
-                                                         ceil ( log10 (
-                                                             ( info.pre < zero_
-                                                             ? integer_type
-                                                             ( -info.pre ) :
-                                                             info.pre ) +
-                                                             one_ ) )).
-                                                     template convert<pow_promote_>()
-                                                     + info.pre_leading_zeros ) ).
-                                       template convert<integer_type>() ) ) ));
+    return std::make_pair ( typename Rational<T, GCD, CHKOP, Alloc>::op_divides() ( r.m_numer,
+                            r.m_denom ), h );
 }
-#pragma GCC diagnostic pop
 
 template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc> template<typename IIter>
-Rational<T, GCD, CHKOP, Alloc> Rational<T, GCD, CHKOP, Alloc>::Rational::eval ( IIter first,
-        IIter last ) {
-
-    Rational result;
-
-    typedef typename std::iterator_traits<IIter>::value_type value_type;
-    typedef std::stack<value_type, std::vector<value_type, Alloc<value_type> > > SYARD;
-    typedef std::vector<value_type, Alloc<value_type> > TOKENS;
-
-    SYARD syard;
-    TOKENS token;
-    evalStack rpn;
-
-    typename ContainerPolicy<TOKENS>::iterator
-    tokenIter ( ContainerPolicy<TOKENS>::make_iterator ( token ) );
-
-    if ( first != last ) {
-
-        value_type prev ( 0 );
-        typename SYARD::value_type top(0);
+         template<typename> class Alloc>
+struct _mod<T, GCD, CHKOP, Alloc, false> {
 
-        while ( first != last ) {
+    typedef std::pair<T, Rational<T, GCD, CHKOP, Alloc> > pair_type;
 
-            typename tmp::_ifThenElse<tmp::_isClassT<value_type>::Yes,
-                     const value_type&, const value_type>::ResultT cur ( *first );
+    RATIONAL_CONSTEXPR pair_type operator() ( const Rational<T, GCD, CHKOP, Alloc>& r ) const {
+        return std::make_pair ( typename Rational<T, GCD, CHKOP, Alloc>::op_divides() ( r.m_numer,
+                                r.m_denom ), Rational<T, GCD, CHKOP, Alloc> (
+                                    ( typename Rational<T, GCD, CHKOP, Alloc>::op_modulus()
+                                      ( r.m_numer, r.m_denom ) ), r.m_denom ) );
+    }
+};
 
-            if ( !isDelimiter ( cur ) ) {
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+struct _pow<T, GCD, CHKOP, Alloc, false> {
+    Rational<T, GCD, CHKOP, Alloc> operator() ( const Rational<T, GCD, CHKOP, Alloc>& r,
+            const T& exp ) const;
+};
 
-                if ( ( cur >= '0' && cur <= '9' ) || cur == '.' ) {
-                    * ( tokenIter++ ) = RATIONAL_MOVE ( cur );
-                } else {
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc> Rational<T, GCD, CHKOP, Alloc>
+_pow<T, GCD, CHKOP, Alloc, false>::operator() ( const Rational<T, GCD, CHKOP, Alloc>& r,
+        const T& exp ) const {
 #ifdef __EXCEPTIONS
-                    throw std::runtime_error (
-                        std::string ( "invalid character(s) in expression" ) );
+    if ( exp > Rational<T, GCD, CHKOP, Alloc>::zero_ ) {
 #endif
-                }
-
-                prev = *first++;
-
-                if ( first == last ) pushToken ( rpn, token );
-
-                continue;
-
-            } else if ( !token.empty() ) pushToken ( rpn, token );
 
-            if ( cur == ' ' || cur == '\t' || cur == '\n' ) {
-                ++first;
-                continue;
-            }
+        Rational<T, GCD, CHKOP, Alloc> b ( r );
+        Rational<T, GCD, CHKOP, Alloc> result ( Rational<T, GCD, CHKOP, Alloc>::one_,
+                                                Rational<T, GCD, CHKOP, Alloc>::one_ );
+        T e ( exp );
 
-            if ( cur == '(' ) {
+        do {
 
-                prev = cur;
-                syard.push ( cur );
+            if ( ( e & 1 ) != Rational<T, GCD, CHKOP, Alloc>::zero_ ) result *= b;
 
-            } else if ( cur == ')' ) {
+            e >>= 1;
+            b *= b;
 
-                prev = cur;
+        } while ( e != Rational<T, GCD, CHKOP, Alloc>::zero_ );
 
-                while ( !syard.empty() && ( top = RATIONAL_MOVE ( syard.top() ) ) != '(' ) {
+        return result;
 
-                    if ( !eval_ ( top, rpn ) ) {
 #ifdef __EXCEPTIONS
-                        throw std::runtime_error ( std::string ( "invalid expression" ) );
+    } else {
+        throw std::domain_error ( "power is undefined for zero" );
+    }
 #endif
-                    }
-
-                    syard.pop();
-                }
+}
 
-                if ( !syard.empty() && top == '(' ) {
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+struct _pow<T, GCD, CHKOP, Alloc, true> {
 
-                    syard.pop();
+    Rational<T, GCD, CHKOP, Alloc> operator() ( const Rational<T, GCD, CHKOP, Alloc>& r,
+            const T& exp ) const {
 
-                } else {
 #ifdef __EXCEPTIONS
-                    throw std::runtime_error ( "mismatched braces" );
+        if ( exp >= Rational<T, GCD, CHKOP, Alloc>::zero_ ) {
 #endif
-                }
+            return _pow<T, GCD, CHKOP, Alloc, false>() ( r, exp );
 
-            } else if ( isOperator ( cur ) ) {
+#ifdef __EXCEPTIONS
+        } else {
+            throw std::domain_error ( "power is undefined for negative numbers" );
+        }
+#endif
+    }
+};
 
-                value_type cop ( cur );
+template<typename T, bool IsSigned, template<class, typename, bool> class CHKOP,
+         template<typename> class CONV> struct GCD_null {
 
-                const bool isUnary = !prev || ( prev == '(' || isOperator ( prev ) );
+    RATIONAL_CONSTEXPR const T& operator() ( const T&, const T& ) const RATIONAL_NOEXCEPT {
+        return one_;
+    }
 
-                if ( cur == '-' && isUnary ) {
-                    cop = 1;
-                } else if ( cur == '+' && isUnary ) {
-                    cop = 2;
-                } else {
+private:
+    const static T one_;
+};
 
-                    while ( !syard.empty() && isOperator ( top = RATIONAL_MOVE ( syard.top() ) ) &&
-                            ( ( isLeftAssoc ( cop ) && getPrec ( cop ) <= getPrec ( top ) ) ||
-                              ( !isLeftAssoc ( cop ) && getPrec ( cop ) < getPrec ( top ) ) ) ) {
+template<typename T, bool IsSigned, template<class, typename, bool> class CHKOP,
+         template<typename> class CONV>
+const T GCD_null<T, IsSigned, CHKOP, CONV>::one_ = T ( 1 );
 
-                        if ( !eval_ ( top, rpn ) ) {
-#ifdef __EXCEPTIONS
-                            throw std::runtime_error ( std::string ( "invalid expression" ) );
-#endif
-                        }
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
+struct GCD_euclid_fast<T, false, CHKOP, CONV> {
 
-                        syard.pop();
-                    }
-                }
+    T operator() ( const T& a, const T& b ) const;
 
-                prev = cur;
-                syard.push ( cop );
-            }
+private:
+    static const T zero_;
+};
 
-            ++first;
-        }
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
+const T GCD_euclid_fast<T, false, CHKOP, CONV>::zero_ = T();
 
-        while ( !syard.empty() && isOperator ( top = RATIONAL_MOVE ( syard.top() ) ) ) {
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
+T GCD_euclid_fast<T, false, CHKOP, CONV>::operator() ( const T& a, const T& b ) const {
 
-            if ( !eval_ ( top, rpn ) ) {
-#ifdef __EXCEPTIONS
-                throw std::runtime_error ( std::string ( "invalid expression" ) );
-#endif
-            }
+    T x ( a ), y ( b );
 
-            syard.pop();
-        }
+    while ( std::not_equal_to<T>() ( y, zero_ ) ) {
 
-        if ( ! ( !syard.empty() || rpn.empty() || rpn.size() > 1 ) ) {
-            return rpn.top();
-        } else {
-#ifdef __EXCEPTIONS
-            throw std::runtime_error ( std::string ( "invalid expression" ) );
-#endif
-        }
+        x %= y;
+        y ^= x;
+        x ^= y;
+        y ^= x;
     }
 
-    return result;
+    return x;
 }
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-Rational<T, GCD, CHKOP, Alloc>::~Rational() {}
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
+struct GCD_euclid_fast<T, true, CHKOP, CONV> {
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-Rational<T, GCD, CHKOP, Alloc>& Rational<T, GCD, CHKOP, Alloc>::reduce() {
+    T operator() ( const T& a, const T& b ) const;
 
-    typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
-             const integer_type>::ResultT x ( m_numer != zero_ ?
-                     GCD<T, std::numeric_limits<integer_type>::is_signed,
-                     CHKOP, TYPE_CONVERT>() ( m_numer, m_denom ) : m_denom );
+private:
+    static const T zero_;
+};
+
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
+const T GCD_euclid_fast<T, true, CHKOP, CONV>::zero_ = T();
+
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
+T GCD_euclid_fast<T, true, CHKOP, CONV>::operator() ( const T& a, const T& b ) const {
+    typename tmp::_ifThenElse<tmp::_isClassT<T>::Yes, const T&,
+             const T>::ResultT h ( GCD_euclid_fast<T, false, CHKOP, CONV>() ( a, b ) );
+    return h < zero_ ? T ( -h ) : h;
+}
+
+template<typename T, template<class, typename = T, bool = false> class CHKOP,
+         template<typename> class CONV> struct GCD_euclid<T, false, CHKOP, CONV> {
 
-    if ( std::not_equal_to<integer_type>() ( x, one_ ) ) {
-        m_numer = RATIONAL_MOVE ( op_divides() ( m_numer, x ) );
-        m_denom = RATIONAL_MOVE ( op_divides() ( m_denom, x ) );
-    }
+    T operator() ( const T& a, const T& b ) const {
 
-    return _swapSign<integer_type, GCD, CHKOP, Alloc,
-           std::numeric_limits<integer_type>::is_signed>() ( *this );
-}
+        T x ( a ), y ( b );
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-Rational<T, GCD, CHKOP, Alloc> Rational<T, GCD, CHKOP, Alloc>:: _sqrt() const {
+        while ( std::not_equal_to<T>() ( y, zero_ ) ) {
 
-#ifdef __EXCEPTIONS
-    if ( std::numeric_limits<integer_type>::is_signed && m_numer < zero_ ) {
-        throw std::domain_error ( "sqrt is undefined for negative numbers" );
+            typename tmp::_ifThenElse<tmp::_isClassT<T>::Yes, const T&,
+                     const T>::ResultT h ( CHKOP<std::modulus<T> >() ( x, y ) );
+
+            x = RATIONAL_MOVE ( y );
+            y = RATIONAL_MOVE ( h );
+        }
+
+        return x;
     }
 
-    if ( m_numer == zero_ ) throw std::domain_error ( "sqrt is undefined for zero" );
-#endif
+private:
+    static const T zero_;
+};
 
-    if ( m_numer == m_denom ) return *this;
+template<typename T, template<class, typename = T, bool = false> class CHKOP,
+         template<typename> class CONV>
+const T GCD_euclid<T, false, CHKOP, CONV>::zero_ = T();
 
-    const Rational half ( one_, one_ + one_ );
-    Rational aux, inv, x ( SQRT_HERON_ITERATE<Rational>() ( *this, one_, one_ ) ?
-                           ( Rational ( one_, one_ ) += *this ) *= half : *this );
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
+struct GCD_euclid<T, true, CHKOP, CONV> {
 
-    while ( SQRT_HERON_ITERATE<Rational>() ( *this, m_numer,
-            ( inv = RATIONAL_MOVE ( x.inverse() ) ).denominator() ) &&
-            SQRT_HERON_ITERATE<Rational>() ( x, ( aux = Rational ( *this ) *= inv ) ) ) {
+    T operator() ( const T& a, const T& b ) const;
 
-        x += aux;
-        x *= half;
-    }
+private:
+    static const T zero_;
+};
 
-    return _psq<integer_type, GCD, CHKOP, Alloc>() ( x, *this );
+template<typename T, template<class, typename = T, bool = false> class CHKOP,
+         template<typename> class CONV>
+const T GCD_euclid<T, true, CHKOP, CONV>::zero_ = T();
+
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
+T GCD_euclid<T, true, CHKOP, CONV>::operator() ( const T& a, const T& b ) const {
+    typename tmp::_ifThenElse<tmp::_isClassT<T>::Yes, const T&,
+             const T>::ResultT h ( GCD_euclid<T, false, CHKOP, CONV>() ( a, b ) );
+    return h < zero_ ? T ( -h ) : h;
 }
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-template<class Op> Rational<T, GCD, CHKOP, Alloc> &
-Rational<T, GCD, CHKOP, Alloc>::knuth_addSub ( const Rational<T, GCD, CHKOP, Alloc>& o ) {
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
+struct GCD_stein<T, false, CHKOP, CONV> {
 
-    typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
-             const integer_type>::ResultT d1 ( GCD<integer_type,
-                     std::numeric_limits<integer_type>::is_signed,
-                     CHKOP, TYPE_CONVERT>() ( m_denom, o.m_denom ) );
+    T operator() ( const T& a, const T& b ) const;
 
-    if ( d1 == one_ ) {
+private:
+    static const T zero_;
+};
 
-        m_numer = RATIONAL_MOVE ( Op() ( op_multiplies() ( m_numer, o.m_denom ),
-                                         op_multiplies() ( m_denom, o.m_numer ) ) );
-        m_denom = RATIONAL_MOVE ( op_multiplies() ( m_denom, o.m_denom ) );
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
+const T GCD_stein<T, false, CHKOP, CONV>::zero_ = T();
 
-    } else {
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
+T GCD_stein<T, false, CHKOP, CONV>::operator() ( const T& a, const T& b ) const {
 
-        typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
-                 const integer_type>::ResultT t ( Op() (
-                             op_multiplies() ( m_numer, ( op_divides() ( o.m_denom, d1 ) ) ),
-                             op_multiplies() ( o.m_numer,
-                                               ( op_divides() ( m_denom, d1 ) ) ) ) );
+    T x ( a ), y ( b ), f = zero_;
 
-        typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
-                 const integer_type>::ResultT d2 ( GCD<integer_type,
-                         std::numeric_limits<integer_type>::is_signed,
-                         CHKOP, TYPE_CONVERT>() ( t, d1 ) );
+    while ( std::not_equal_to<T>() ( y, zero_ ) ) {
 
-        m_numer = RATIONAL_MOVE ( op_divides() ( t, d2 ) );
-        m_denom = RATIONAL_MOVE ( op_multiplies() ( op_divides() ( m_denom, d1 ),
-                                  op_divides() ( o.m_denom, d2 ) ) );
-    }
+        if ( x < y ) {
 
-    return *this;
-}
+            y ^= x;
+            x ^= y;
+            y ^= x;
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc>
-Rational<T, GCD, CHKOP, Alloc>::operator+ ( const Rational& other ) const {
-    return ( Rational ( *this ) += other );
-}
+        } else if ( T ( x & 1 ) == zero_ ) {
 
-/**
- * @relates Rational
- *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename NumberType, typename T, template<typename, bool,
-         template<class, typename, bool> class, template<typename> class> class GCD,
-         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
-RATIONAL_CONSTEXPR NumberType&
-operator+= ( NumberType& n, const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ( n = Rational<T, GCD, CHKOP, Alloc> ( n ) += o );
-}
+            x >>= 1;
 
-/**
- * @relates Rational
- *
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam NumberType the number type
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
-Rational<T, GCD, CHKOP, Alloc> operator+ ( const Rational<T, GCD, CHKOP, Alloc>& o,
-        const NumberType& n ) {
-    return ( o + Rational<T, GCD, CHKOP, Alloc> ( n ) );
-}
+            if ( T ( y & 1 ) == zero_ ) {
+                y >>= 1;
+                ++f;
+            }
 
-/**
- * @relates Rational
- *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename NumberType, typename T, template<typename, bool,
-         template<class, typename, bool> class, template<typename> class> class GCD,
-         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
-RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc> operator+ ( const NumberType& n,
-        const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ( Rational<T, GCD, CHKOP, Alloc> ( n ) + o );
-}
+        } else if ( T ( y & 1 ) == zero_ ) {
+            y >>= 1;
+        } else {
+            x -= y;
+        }
+    }
 
-/**
- * @relates Rational
- *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename NumberType, typename T, template<typename, bool,
-         template<class, typename, bool> class, template<typename> class> class GCD,
-         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
-RATIONAL_CONSTEXPR NumberType& operator-= ( NumberType& n,
-        const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ( n = Rational<T, GCD, CHKOP, Alloc> ( n ) -= o );
+    return x << CONV<T> ( f ).template convert<unsigned long int>();
 }
 
-/**
- * @relates Rational
- *
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam NumberType the number type
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
-Rational<T, GCD, CHKOP, Alloc> operator- ( const Rational<T, GCD, CHKOP, Alloc>& o,
-        const NumberType& n ) {
-    return o - Rational<T, GCD, CHKOP, Alloc> ( n );
-}
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
+struct GCD_stein<T, true, CHKOP, CONV> {
 
-/**
- * @relates Rational
- *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename NumberType, typename T, template<typename, bool,
-         template<class, typename, bool> class, template<typename> class> class GCD,
-         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
-RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc> operator- ( const NumberType& n,
-        const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ( Rational<T, GCD, CHKOP, Alloc> ( n ) - o );
+    T operator() ( const T& a, const T& b ) const;
+
+private:
+    static const T zero_;
+};
+
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
+const T GCD_stein<T, true, CHKOP, CONV>::zero_ = T();
+
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
+T GCD_stein<T, true, CHKOP, CONV>::operator() ( const T& a, const T& b ) const {
+    return GCD_stein<T, false, CHKOP, CONV>()
+           ( a < zero_ ? T ( -a ) : a, b < zero_ ? T ( -b ) : b );
 }
 
 template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
          template<typename> class Alloc>
-RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc>
-Rational<T, GCD, CHKOP, Alloc>::operator* ( const Rational& other ) const {
-    return ( Rational ( *this ) *= other );
-}
-
-/**
- * @relates Rational
- *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename NumberType, typename T, template<typename, bool,
-         template<class, typename, bool> class, template<typename> class> class GCD,
-         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
-RATIONAL_CONSTEXPR NumberType& operator*= ( NumberType& n,
-        const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ( n = Rational<T, GCD, CHKOP, Alloc> ( n ) *= o );
-}
-
-/**
- * @relates Rational
- *
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam NumberType the number type
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
+struct _lcm<T, GCD, CHKOP, Alloc, true> {
+    T operator() ( const T& a, const T& b ) const;
+};
+
 template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
-Rational<T, GCD, CHKOP, Alloc> operator* ( const Rational<T, GCD, CHKOP, Alloc>& o,
-        const NumberType& n ) {
-    return ( o * Rational<T, GCD, CHKOP, Alloc> ( n ) );
-}
+         template<typename> class Alloc>
+T _lcm<T, GCD, CHKOP, Alloc, true>::operator() ( const T& a, const T& b ) const {
 
-/**
- * @relates Rational
- *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename NumberType, typename T, template<typename, bool,
-         template<class, typename, bool> class, template<typename> class> class GCD,
-         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
-RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc> operator* ( const NumberType& n,
-        const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ( Rational<T, GCD, CHKOP, Alloc> ( n ) * o );
+    typename tmp::_ifThenElse<tmp::_isClassT<T>::Yes, const T&, const T>::ResultT
+    x ( a < Rational<T, GCD, CHKOP, Alloc>::zero_ ? T ( -a ) : a ),
+      y ( b < Rational<T, GCD, CHKOP, Alloc>::zero_ ? T ( -b ) : b );
+
+    return typename Rational<T, GCD, CHKOP, Alloc>::op_multiplies()
+           ( ( typename Rational<T, GCD, CHKOP, Alloc>::op_divides() ( static_cast<T> ( x ),
+                   ( a != Rational<T, GCD, CHKOP, Alloc>::zero_ ? GCD<T, false,
+                     CHKOP, TYPE_CONVERT>() ( x, y ) : b ) ) ), static_cast<T> ( y ) );
 }
 
-template<typename T, template<typename, bool,
-         template<class, typename, bool> class, template<typename> class> class GCD,
-         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
-Rational<T, GCD, CHKOP, Alloc>& Rational<T, GCD, CHKOP, Alloc>::invert() {
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+struct _lcm<T, GCD, CHKOP, Alloc, false> {
 
-    using namespace std;
-    swap ( m_numer, m_denom );
+    RATIONAL_CONSTEXPR T operator() ( const T& a, const T& b ) const {
+        return typename Rational<T, GCD, CHKOP, Alloc>::op_multiplies()
+               ( typename Rational<T, GCD, CHKOP, Alloc>::op_divides()
+                 ( a, ( a ? GCD<T, false, CHKOP, TYPE_CONVERT>() ( a, b ) : b ) ), b );
+    }
+};
 
-#ifdef __EXCEPTIONS
-    if ( m_denom == zero_ ) throw std::domain_error ( "division by zero" );
-#endif
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+struct _swapSign<T, GCD, CHKOP, Alloc, true> {
 
-    return _swapSign<integer_type, GCD, CHKOP, Alloc,
-           std::numeric_limits<integer_type>::is_signed>() ( *this );
-}
+    Rational<T, GCD, CHKOP, Alloc>& operator() ( Rational<T, GCD, CHKOP, Alloc>& r ) const {
 
-template<typename T, template<typename, bool,
-         template<class, typename, bool> class, template<typename> class> class GCD,
-         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
-RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc> Rational<T, GCD, CHKOP, Alloc>::inverse() const {
-    return Rational ( *this ).invert();
-}
+        if ( r.m_denom < zero_ ) {
+            r.m_numer =  -r.m_numer;
+            r.m_denom = -r.m_denom;
+        }
 
-template<typename T, template<typename, bool,
-         template<class, typename, bool> class, template<typename> class> class GCD,
-         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
-Rational<T, GCD, CHKOP, Alloc> Rational<T, GCD, CHKOP, Alloc>::sqrt() const {
+        return r;
+    }
 
-    if ( m_numer == m_denom ) return *this;
+private:
+    const static T zero_;
+};
 
-    Rational p, q;
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+const T _swapSign<T, GCD, CHKOP, Alloc, true>::zero_ = T();
 
-    return ( ( p = RATIONAL_MOVE ( Rational ( m_numer, one_ )._sqrt() ) ).isInteger() &&
-             ( q = RATIONAL_MOVE ( Rational ( m_denom, one_ )._sqrt() ) ).isInteger() ) ?
-           Rational ( p.numerator(), q.numerator() ) : _sqrt();
-}
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+struct _swapSign<T, GCD, CHKOP, Alloc, false> {
 
-template<typename T, template<typename, bool,
-         template<class, typename, bool> class, template<typename> class> class GCD,
-         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
-RATIONAL_CONSTEXPR typename Rational<T, GCD, CHKOP, Alloc>::mod_type
-Rational<T, GCD, CHKOP, Alloc>::mod() const {
-    return _mod<integer_type, GCD, CHKOP, Alloc,
-           std::numeric_limits<integer_type>::is_signed>() ( *this );
-}
+    RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc> &
+    operator() ( Rational<T, GCD, CHKOP, Alloc>& r ) const RATIONAL_NOEXCEPT {
+        return r;
+    }
+};
 
 template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc> template<class F>
-void Rational<T, GCD, CHKOP, Alloc>::floyd_cycle_detect (
-    F f, typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
-    const integer_type>::ResultT x ) {
+         template<typename> class Alloc>
+struct _psq {
 
-    integer_type tortoise ( f ( x ) );
-    integer_type hare ( f ( tortoise ) );
+    Rational<T, GCD, CHKOP, Alloc> operator() ( const Rational<T, GCD, CHKOP, Alloc>& x,
+            const Rational<T, GCD, CHKOP, Alloc>& y ) const {
 
-    while ( std::not_equal_to<integer_type>() ( tortoise, hare ) ) {
-        tortoise = RATIONAL_MOVE ( f ( tortoise ) );
-        hare = RATIONAL_MOVE ( f ( f ( hare ) ) );
-    }
+        typename tmp::_ifThenElse<tmp::_isClassT<typename Rational<T, GCD,
+                 CHKOP, Alloc>::mod_type::first_type>::Yes,
+                 const typename Rational<T, GCD, CHKOP, Alloc>::mod_type::first_type&,
+                 const typename Rational<T, GCD, CHKOP, Alloc>::mod_type::first_type>::ResultT
+                 m ( x.mod().first );
 
-    typename F::size_type mu ( 0 );
+        if ( std::not_equal_to<typename Rational<T, GCD, CHKOP, Alloc>::mod_type::first_type>()
+                ( m, typename Rational<T, GCD, CHKOP, Alloc>::mod_type::first_type() ) ) {
+
+            const Rational<T, GCD, CHKOP, Alloc> psq ( m );
 
-    tortoise = RATIONAL_MOVE ( x );
+            return ( psq * psq ) == y ? psq : x;
+        }
 
-    while ( std::not_equal_to <integer_type>() ( tortoise, hare ) ) {
-        tortoise = RATIONAL_MOVE ( mu++ ? f ( tortoise, F::PRE ) : f ( tortoise ) );
-        hare = RATIONAL_MOVE ( f ( hare ) );
+        return x;
     }
+};
+
+#ifdef __EXCEPTIONS
+template<typename T>
+struct ENABLE_OVERFLOW_CHECK<std::plus<T>, T, true> {
 
-    hare = RATIONAL_MOVE ( std::not_equal_to<integer_type>() ( tortoise, zero_ ) ?
-                           f ( tortoise,  F::REP ) : f ( tortoise ) );
+    T operator() ( const T& x, const T& y ) const {
+
+        if ( ! ( ( ( y > T() ) && ( x > ( std::numeric_limits<T>::max() - y ) ) ) ||
+                 ( ( y < T() ) && ( x < ( std::numeric_limits<T>::min() - y ) ) ) ) ) {
 
-    while ( std::not_equal_to<integer_type>() ( tortoise, hare ) ) {
-        hare = RATIONAL_MOVE ( f ( hare, F::REP ) );
+            return std::plus<T>() ( x, y );
+        }
+
+        throw std::domain_error ( "addition overflow" );
     }
-}
+};
+#endif
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc> template<class PreC, class RepC>
-typename Rational<T, GCD, CHKOP, Alloc>::integer_type
-Rational<T, GCD, CHKOP, Alloc>::decompose ( rf_info& rf_info, PreC& pre_digits, RepC& rep_digits,
-        bool digitsOnly ) const {
+#ifdef __EXCEPTIONS
+template<typename T>
+struct ENABLE_OVERFLOW_CHECK<std::minus<T>, T, true> {
 
-    ContainerPolicy<PreC>().clear ( pre_digits );
-    ContainerPolicy<RepC>().clear ( rep_digits );
+    T operator() ( const T& x, const T& y ) const {
 
-    integer_type w;
+        if ( ! ( ( y > T() && x < std::numeric_limits<T>::min() + y ) ||
+                 ( y < T() && x > std::numeric_limits<T>::max() + y ) ) ) {
 
-    // with many thanks to David Eisenstat (http://stackoverflow.com/a/34977982/1939803)
-    floyd_cycle_detect ( cd_lambda<typename ContainerPolicy<PreC>::iterator,
-                         typename ContainerPolicy<RepC>::iterator,
-                         typename RepC::size_type> ( m_denom,
-                                 ContainerPolicy<PreC>::make_iterator ( pre_digits ),
-                                 ContainerPolicy<RepC>::make_iterator ( rep_digits ),
-                                 rf_info, !digitsOnly ), _remquo<T, GCD, CHKOP, Alloc> ()
-                         ( m_numer < zero_ ? integer_type ( -m_numer ) : m_numer, m_denom, w ) );
+            return std::minus<T>() ( x, y );
+        }
 
-    rf_info.negative = m_numer < zero_;
-    rf_info.pre_leading_zeros = countLeading ( pre_digits.begin(), pre_digits.end() );
-    rf_info.leading_zeros = countLeading ( rep_digits.begin(), rep_digits.end() );
+        throw std::domain_error ( "subtraction overflow" );
+    }
+};
+#endif
 
-    if ( !digitsOnly && rf_info.negative ) {
-        rf_info.pre = RATIONAL_MOVE ( -rf_info.pre );
-        rf_info.reptend = RATIONAL_MOVE ( -rf_info.reptend );
+#ifdef __EXCEPTIONS
+template<typename T>
+struct ENABLE_OVERFLOW_CHECK<std::negate<T>, T, true> {
+
+    T operator() ( const T& x ) const {
+
+        if ( x != std::numeric_limits<T>::min() ) {
+            return std::negate<T>() ( x );
+        }
+
+        throw std::domain_error ( "negation overflow" );
     }
+};
+#endif
 
-    return !rf_info.negative ? w : integer_type ( -w );
-}
+#ifdef __EXCEPTIONS
+template<typename T>
+struct ENABLE_OVERFLOW_CHECK<std::multiplies<T>, T, true> {
+    T operator() ( const T& x, const T& y ) const;
+};
+#endif
 
-/**
- * @relates Rational
- *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename NumberType, typename T, template<typename, bool,
-         template<class, typename, bool> class, template<typename> class> class GCD,
-         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
-RATIONAL_CONSTEXPR NumberType& operator/= ( NumberType& n,
-        const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ( n = Rational<T, GCD, CHKOP, Alloc> ( n ) /= o );
-}
+#ifdef __EXCEPTIONS
+template<typename T>
+T ENABLE_OVERFLOW_CHECK<std::multiplies<T>, T, true>::operator() ( const T& x, const T& y ) const {
 
-/**
- * @relates Rational
- *
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam NumberType the number type
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
-Rational<T, GCD, CHKOP, Alloc> operator/ ( const Rational<T, GCD, CHKOP, Alloc>& o,
-        const NumberType& n ) {
-    return ( o / Rational<T, GCD, CHKOP, Alloc> ( n ) );
-}
+    bool overflow = false;
 
-/**
- * @relates Rational
- *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename NumberType, typename T, template<typename, bool,
-         template<class, typename, bool> class, template<typename> class> class GCD,
-         template<class, typename, bool> class CHKOP, template<typename> class Alloc>
-RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc> operator/ ( const NumberType& n,
-        const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ( Rational<T, GCD, CHKOP, Alloc> ( n ) / o );
+    if ( x > T() ) {
+        if ( y > T() ) {
+            if ( x > ( std::numeric_limits<T>::max() / y ) ) {
+                overflow = true;
+            }
+        } else {
+            if ( y < ( std::numeric_limits<T>::min() / x ) ) {
+                overflow = true;
+            }
+        }
+    } else {
+        if ( y > T() ) {
+            if ( x < ( std::numeric_limits<T>::min() / y ) ) {
+                overflow = true;
+            }
+        } else {
+            if ( ( x != T() ) && ( y < ( std::numeric_limits<T>::max() / x ) ) ) {
+                overflow = true;
+            }
+        }
+    }
+
+    if ( overflow ) throw std::domain_error ( "multiplication overflow" );
+
+    return std::multiplies<T>() ( x, y );
 }
+#endif
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc> Rational<T, GCD, CHKOP, Alloc>&
-Rational<T, GCD, CHKOP, Alloc>::operator*= ( const Rational& other ) {
+#ifdef __EXCEPTIONS
+template<typename T>
+struct ENABLE_OVERFLOW_CHECK<std::divides<T>, T, true> {
+    T operator() ( const T& x, const T& y ) const;
+};
+#endif
 
-    typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
-             const integer_type>::ResultT d2 ( GCD<integer_type,
-                     std::numeric_limits<integer_type>::is_signed, CHKOP, TYPE_CONVERT>()
-                     ( m_denom, other.m_numer ) );
+#ifdef __EXCEPTIONS
+template<typename T>
+T ENABLE_OVERFLOW_CHECK<std::divides<T>, T, true>::operator() ( const T& x, const T& y ) const {
 
-    typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
-             const integer_type>::ResultT d1 ( d2 == one_ ? GCD<integer_type,
-                     std::numeric_limits<integer_type>::is_signed, CHKOP, TYPE_CONVERT>()
-                     ( m_numer, other.m_denom ) : one_ );
+    if ( ! ( ( y == T() ) || ( ( x == std::numeric_limits<T>::min() ) && ( y == -1 ) ) ) ) {
+        return std::divides<T>() ( x, y );
+    }
 
-    if ( ! ( d2 == one_ && d1 == one_ ) ) {
+    throw std::domain_error ( "division overflow" );
+}
+#endif
 
-        m_numer = RATIONAL_MOVE ( op_multiplies() ( ( op_divides() ( m_numer, d1 ) ),
-                                  ( op_divides() ( other.m_numer, d2 ) ) ) );
-        m_denom = RATIONAL_MOVE ( op_multiplies() ( ( op_divides() ( m_denom, d2 ) ),
-                                  ( op_divides() ( other.m_denom, d1 ) ) ) );
+#ifdef __EXCEPTIONS
+template<typename T>
+struct ENABLE_OVERFLOW_CHECK<std::modulus<T>, T, true> {
 
-    } else {
-        m_numer = RATIONAL_MOVE ( op_multiplies() ( m_numer, other.m_numer ) );
-        m_denom = RATIONAL_MOVE ( op_multiplies() ( m_denom, other.m_denom ) );
+    T operator() ( const T& x, const T& y ) const {
+
+        if ( ! ( ( y == T() ) || ( ( x == std::numeric_limits<T>::min() ) && ( y == -1 ) ) ) ) {
+            return std::modulus<T>() ( x, y );
+        }
+
+        throw std::domain_error ( "modulus overflow" );
     }
+};
+#endif
 
-    return *this;
-}
+#ifdef __EXCEPTIONS
+template<typename T>
+struct ENABLE_OVERFLOW_CHECK<std::plus<T>, T, false> {
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc> Rational<T, GCD, CHKOP, Alloc>&
-Rational<T, GCD, CHKOP, Alloc>::operator%= ( const Rational& o ) {
+    T operator() ( const T& x, const T& y ) const {
 
-    if ( std::not_equal_to<integer_type>() ( m_denom, o.m_denom ) ) {
+        if ( ! ( std::numeric_limits<T>::max() - x < y ) ) {
+            return std::plus<T>() ( x, y );
+        }
 
-        typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
-                 const integer_type>::ResultT l ( _lcm<integer_type, GCD, CHKOP, Alloc,
-                         std::numeric_limits<integer_type>::is_signed>()
-                         ( m_denom, o.m_denom ) );
+        throw std::domain_error ( "unsigned addition wrap" );
+    }
+};
+#endif
 
-        typename tmp::_ifThenElse<tmp::_isClassT<integer_type>::Yes, const integer_type&,
-                 const integer_type>::ResultT a ( op_multiplies()
-                         ( op_divides() ( l, o.m_denom ), o.m_numer ) );
+#ifdef __EXCEPTIONS
+template<typename T>
+struct ENABLE_OVERFLOW_CHECK<std::minus<T>, T, false> {
 
-        m_numer = RATIONAL_MOVE ( op_modulus() ( op_plus() ( op_modulus() ( op_multiplies()
-                                  ( op_divides() ( l, m_denom ), m_numer ), a ), a ), a ) );
-        m_denom = RATIONAL_MOVE ( l );
+    T operator() ( const T& x, const T& y ) const {
 
-    } else {
-        m_numer = RATIONAL_MOVE ( op_modulus() ( op_plus() ( op_modulus() ( m_numer, o.m_numer ),
-                                  o.m_numer ), o.m_numer ) );
+        if ( ! ( x < y ) ) return std::minus<T>() ( x, y );
+
+        throw std::domain_error ( "unsigned subtraction wrap" );
     }
+};
+#endif
 
-    return reduce();
-}
+template<typename T>
+struct ENABLE_OVERFLOW_CHECK<std::negate<T>, T, false> {
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-std::string Rational<T, GCD, CHKOP, Alloc>::str ( bool mixed ) const {
+#ifndef __EXCEPTIONS
+    T operator() ( const T& x ) const {
+        return std::negate<T>() ( x );
+#else
+    T operator() ( const T& ) const {
+        throw std::domain_error ( "unsigned negation wrap" );
+#endif
+    }
+};
 
-    std::ostringstream os;
+#ifdef __EXCEPTIONS
+template<typename T>
+struct ENABLE_OVERFLOW_CHECK<std::multiplies<T>, T, false> {
 
-    if ( !mixed ) {
+    T operator() ( const T& x, const T& y ) const {
 
-        os << m_numer;
+        if ( y == T ( 0 ) || ! ( x > std::numeric_limits<T>::max() / y ) ) {
+            return std::multiplies<T>() ( x, y );
+        }
 
-        if ( std::not_equal_to<integer_type>() ( m_denom, one_ ) ) os << '/' << m_denom;
+        throw std::domain_error ( "unsigned multiplication wrap" );
+    }
+};
+#endif
 
-    } else {
+/**
+ * @ingroup main
+ * @brief Traits class to choose an appropriate Commons::Math::Rational
+ */
+template<typename T>
+struct CFRationalTraits {
+    typedef Rational<T> rational_type;
+};
 
-        const mod_type& p ( mod() );
+/**
+ * @ingroup main
+ * @brief Constructs a Rational of a given continued fraction sequence
+ *
+ * @see Commons::Math::CFRationalTraits
+ *
+ * @tparam IIter an input iterator
+ *
+ * @param[in] first iterator pointing to the begin of the sequence
+ * @param[in] last iterator pointing to the end of the sequence
+ *
+ * @return the Commons::Math::Rational representing the sequence
+ */
+template<typename IIter>
+typename CFRationalTraits<typename std::iterator_traits<IIter>::value_type>::rational_type
+cf ( IIter first, IIter last ) {
 
-        if ( std::not_equal_to<integer_type>() ( m_denom, one_ ) ) {
+    typedef typename std::iterator_traits<IIter>::value_type value_type;
+    typedef typename CFRationalTraits<typename
+    std::iterator_traits<IIter>::value_type>::rational_type rat;
 
-            if ( std::not_equal_to<typename mod_type::first_type>() ( p.first, zero_ ) ) {
-                os << p.first << ' ';
-            }
+    value_type m[2][2] = {
+        { value_type(), value_type ( 1 ) },
+        { value_type ( 1 ), value_type() }
+    };
 
-            os << p.second.abs().str ( false );
+    value_type n ( m[0][0] ), d ( m[0][1] );
 
-        } else {
-            os << ( p.first + p.second.abs().numerator() );
-        }
-    }
+    while ( first != last ) {
 
-    return os.str();
-}
+        n = typename rat::op_plus() (
+                typename rat::op_multiplies() ( *first, m[0][1] ), m[0][0] );
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-Rational<T, GCD, CHKOP, Alloc> Rational<T, GCD, CHKOP, Alloc>::eval ( const char *expr ) const {
+        m[0][0] = RATIONAL_MOVE ( m[0][1] );
+        m[0][1] = n;
 
-    if ( expr && *expr ) {
-#if __EXCEPTIONS
-        try {
-#endif
-            return eval ( expr, expr + std::strlen ( expr ) );
-#if __EXCEPTIONS
-        } catch ( const std::domain_error& e ) {
-            throw std::domain_error ( std::string ( e.what() ).
-                                      append ( ": " ).append ( expr ) );
-        } catch ( const std::runtime_error& e ) {
-            throw std::runtime_error ( std::string ( e.what() ).
-                                       append ( ": " ).append ( expr ) );
-        }
-#endif
+        d = typename rat::op_plus() (
+                typename rat::op_multiplies() ( *first++, m[1][1] ), m[1][0] );
+
+        m[1][0] = RATIONAL_MOVE ( m[1][1] );
+        m[1][1] = d;
     }
 
-    return Rational();
+    return rat ( n, d );
 }
 
-#pragma GCC diagnostic ignored "-Wfloat-equal"
-#pragma GCC diagnostic push
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-bool Rational<T, GCD, CHKOP, Alloc>::eval_ ( const char op, evalStack& s ) {
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+// calls f(i) for i = 0, ..., n - 1 on a thread each and rethrows the first exception thrown
+// by any call; if a thread can't be started, the running ones get joined before rethrowing,
+// as destroying a joinable std::thread would terminate
+template<class F>
+void _parallel_run ( unsigned int n, const F &f ) {
 
-    if ( !s.empty() ) {
+    std::vector<std::exception_ptr> errors ( n );
+    std::vector<std::thread> pool;
 
-        Rational operand[2] = { s.top(), Rational() };
+    pool.reserve ( n );
 
-        s.pop();
+#ifdef __EXCEPTIONS
+    try {
+#endif
+        for ( unsigned int i = 0u; i < n; ++i ) {
+            pool.emplace_back ( [&f, &errors, i]() {
+#ifdef __EXCEPTIONS
+                try {
+#endif
+                    f ( i );
+#ifdef __EXCEPTIONS
+                } catch ( ... ) {
+                    errors[i] = std::current_exception();
+                }
+#endif
+            } );
+        }
+#ifdef __EXCEPTIONS
+    } catch ( ... ) {
 
-        if ( op > 2 && s.empty() ) return false;
+        for ( std::thread &t : pool ) t.join();
 
-        switch ( op ) {
-        case '/':
-#if __EXCEPTIONS
-            if ( operand[0] == Rational() ) {
-                throw std::domain_error ( std::string ( "division by zero in expression" ) );
-            }
+        throw;
+    }
 #endif
-            operand[1] = RATIONAL_MOVE ( s.top() );
-            s.pop();
-            s.push ( RATIONAL_MOVE ( operand[1] /= operand[0] ) );
-            return true;
-        case '*':
-            operand[1] = RATIONAL_MOVE ( s.top() );
-            s.pop();
-            s.push ( RATIONAL_MOVE ( operand[1] *= operand[0] ) );
-            return true;
-        case '+':
-            operand[1] = RATIONAL_MOVE ( s.top() );
-            s.pop();
-            s.push ( RATIONAL_MOVE ( operand[1] += operand[0] ) );
-            return true;
-        case '-':
-            operand[1] = RATIONAL_MOVE ( s.top() );
-            s.pop();
-            s.push ( RATIONAL_MOVE ( operand[1] -= operand[0] ) );
-            return true;
-        case '%':
-#if __EXCEPTIONS
-            if ( operand[0] == Rational() ) {
-                throw std::domain_error ( std::string ( "modulus by zero in expression" ) );
-            }
+
+    for ( std::thread &t : pool ) t.join();
+
+    for ( const std::exception_ptr &e : errors ) {
+        if ( e ) std::rethrow_exception ( e );
+    }
+}
+
+// calls f on a new thread and g on the calling one; the thread gets joined in any case, an
+// exception of g is rethrown before one of f
+template<class F, class G>
+void _fork_join ( const F &f, const G &g ) {
+
+    std::exception_ptr error;
+    std::thread t ( [&f, &error]() {
+#ifdef __EXCEPTIONS
+        try {
 #endif
-            operand[1] = RATIONAL_MOVE ( s.top() );
-            s.pop();
-            s.push ( RATIONAL_MOVE ( operand[1] %= operand[0] ) );
-            return true;
-        case 1:
-            s.push ( RATIONAL_MOVE ( -operand[0] ) );
-            return true;
-        case 2:
-            s.push ( RATIONAL_MOVE ( operand[0] ) );
-            return true;
+            f();
+#ifdef __EXCEPTIONS
+        } catch ( ... ) {
+            error = std::current_exception();
         }
+#endif
+    } );
+
+#ifdef __EXCEPTIONS
+    try {
+#endif
+        g();
+#ifdef __EXCEPTIONS
+    } catch ( ... ) {
+
+        t.join();
+
+        throw;
     }
+#endif
 
-    return false;
-}
-#pragma GCC diagnostic pop
+    t.join();
 
-/**
- * @relates Rational
- *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename NumberType, typename T,
-         template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-RATIONAL_CONSTEXPR NumberType& operator%= ( NumberType& n,
-        const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ( n = Rational<T, GCD, CHKOP, Alloc> ( n ) %= o );
+    if ( error ) std::rethrow_exception ( error );
 }
+#endif
 
-/**
- * @relates Rational
- *
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam NumberType the number type
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
-Rational<T, GCD, CHKOP, Alloc> operator% ( const Rational<T, GCD, CHKOP, Alloc>& o,
-        const NumberType& n ) {
-    return ( o % Rational<T, GCD, CHKOP, Alloc> ( n ) );
-}
+template<class R, typename RAIter>
+void _cf_tree ( RAIter first, RAIter last, typename R::integer_type *m, unsigned int threads ) {
 
-/**
- * @relates Rational
- *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename NumberType, typename T,
-         template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc> operator% ( const NumberType& n,
-        const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ( Rational<T, GCD, CHKOP, Alloc> ( n ) % o );
+    typedef typename R::integer_type value_type;
+
+    if ( last - first <= 16 ) {
+
+        m[0] = m[3] = value_type ( 1 );
+        m[1] = m[2] = value_type();
+
+        for ( ; first != last; ++first ) {
+
+            value_type x ( typename R::op_plus() ( typename R::op_multiplies() ( m[0], *first ),
+                           m[1] ) );
+
+            m[1] = RATIONAL_MOVE ( m[0] );
+            m[0] = RATIONAL_MOVE ( x );
+
+            x = typename R::op_plus() ( typename R::op_multiplies() ( m[2], *first ), m[3] );
+
+            m[3] = RATIONAL_MOVE ( m[2] );
+            m[2] = RATIONAL_MOVE ( x );
+        }
+
+        return;
+    }
+
+    const RAIter mid ( first + ( last - first ) / 2 );
+    value_type l[4], r[4];
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    if ( threads > 1u ) {
+
+        _fork_join ( [first, mid, &l, threads]() {
+            _cf_tree<R> ( first, mid, l, threads / 2u );
+        }, [mid, last, &r, threads]() {
+            _cf_tree<R> ( mid, last, r, threads - threads / 2u );
+        } );
+
+    } else
+#else
+    ( void ) threads;
+#endif
+    {
+        _cf_tree<R> ( first, mid, l, 1u );
+        _cf_tree<R> ( mid, last, r, 1u );
+    }
+
+    for ( int i = 0; i < 4; i += 2 ) {
+        m[i] = typename R::op_plus() ( typename R::op_multiplies() ( l[i], r[0] ),
+                                       typename R::op_multiplies() ( l[i + 1], r[2] ) );
+        m[i + 1] = typename R::op_plus() ( typename R::op_multiplies() ( l[i], r[1] ),
+                                           typename R::op_multiplies() ( l[i + 1], r[3] ) );
+    }
 }
 
 /**
- * @relates Rational
+ * @ingroup main
+ * @brief Constructs a Rational of a given continued fraction sequence by a product tree
  *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ * Each partial quotient @f$ a_i @f$ corresponds to the matrix
+ * @f$ \left(\begin{smallmatrix} a_i & 1 \\ 1 & 0 \end{smallmatrix}\right) @f$. Instead of
+ * multiplying them from left to right as cf() does, they are multiplied in a balanced binary
+ * tree, so that the big multiplications are done on numbers of about the same size. For long
+ * sequences of big storage types (i.e. @c mpz_class) this is much faster than cf(), for short
+ * sequences and built-in storage types cf() should be used.
+ *
+ * If @c threads is greater than @c 1 and C++11 is available, the subtrees are calculated in
+ * parallel. The result is the same as of cf() in every case.
+ *
+ * @see Commons::Math::cf()
+ *
+ * @tparam RAIter a random access iterator
+ *
+ * @param[in] first iterator pointing to the begin of the sequence
+ * @param[in] last iterator pointing to the end of the sequence
+ * @param[in] threads the maximum amount of threads to use
+ *
+ * @return the Commons::Math::Rational representing the sequence
  */
-template<typename NumberType, typename T,
-         template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-RATIONAL_CONSTEXPR bool operator== ( const NumberType& n,
-                                     const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ( Rational<T, GCD, CHKOP, Alloc> ( n ) == o );
+template<typename RAIter>
+typename CFRationalTraits<typename std::iterator_traits<RAIter>::value_type>::rational_type
+cf_tree ( RAIter first, RAIter last, unsigned int threads = 1u ) {
+
+    typedef typename CFRationalTraits<typename
+    std::iterator_traits<RAIter>::value_type>::rational_type rat;
+
+    if ( first == last ) return rat();
+
+    typename rat::integer_type m[4];
+
+    _cf_tree<rat> ( first, last, m, threads ? threads : 1u );
+
+    return rat ( m[0], m[2] );
 }
 
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic push
 /**
- * @relates Rational
+ * @ingroup main
+ * @brief Extracts a continued fraction sequence of a Rational
  *
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam NumberType the number type
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ * @see Commons::Math::Rational::mod()
+ *
+ * @tparam OIter an output iterator
+ *
+ * @param[in] r the Commons::Math::Rational to extract the continued fraction sequence from
+ * @param[out] out iterator to ouput the sequence to
+ *
+ * @return iterator pointing to the end of @c out
  */
 template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
-bool operator== ( const Rational<T, GCD, CHKOP, Alloc>& o, const NumberType& n ) {
-    return ( o == Rational<T, GCD, CHKOP, Alloc> ( n ) );
-}
+         template<typename> class Alloc, typename OIter>
+OIter seq ( const Rational<T, GCD, CHKOP, Alloc>& r, OIter out ) {
 
-/**
- * @relates Rational
- *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename NumberType, typename T,
-         template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-RATIONAL_CONSTEXPR bool operator!= ( const NumberType& n,
-                                     const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ! ( Rational<T, GCD, CHKOP, Alloc> ( n ) == o );
+    const bool neg = r.numerator() < Rational<T, GCD, CHKOP, Alloc>::zero_;
+
+    return ContinuedFractionTraits<T>::expand ( neg ? T ( typename Rational<T, GCD, CHKOP,
+            Alloc>::op_negate() ( r.numerator() ) ) : r.numerator(), r.denominator(), out, neg );
 }
+#pragma GCC diagnostic pop
 
 /**
- * @relates Rational
+ * @ingroup main
+ * @brief Calculates the mediant of two %Rationals
  *
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam NumberType the number type
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ * The mediant of @f$ \frac{a}{b} @f$ and @f$ \frac{c}{d} @f$ is @f$ \frac{a + c}{b + d} @f$.
+ *
+ * @param[in] x the first %Rational
+ * @param[in] y the second %Rational
+ *
+ * @return the mediant of @c x and @c y
  */
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
-bool operator!= ( const Rational<T, GCD, CHKOP, Alloc>& o, const NumberType& n ) {
-    return ! ( o == Rational<T, GCD, CHKOP, Alloc> ( n ) );
-}
-
 template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
          template<typename> class Alloc>
-RATIONAL_CONSTEXPR bool Rational<T, GCD, CHKOP, Alloc>::operator< ( const Rational& other ) const {
-    return ( m_numer * other.m_denom ) < ( other.m_numer * m_denom );
+Rational<T, GCD, CHKOP, Alloc> mediant ( const Rational<T, GCD, CHKOP, Alloc>& x,
+        const Rational<T, GCD, CHKOP, Alloc>& y ) {
+
+    typedef Rational<T, GCD, CHKOP, Alloc> rat;
+
+    return rat ( typename rat::op_plus() ( x.numerator(), y.numerator() ),
+                 typename rat::op_plus() ( x.denominator(), y.denominator() ) );
 }
 
-/**
- * @relates Rational
- *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename NumberType, typename T,
-         template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-RATIONAL_CONSTEXPR bool operator< ( const NumberType& n,
-                                    const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ( Rational<T, GCD, CHKOP, Alloc> ( n ) < o );
+template<class R>
+R _simplest ( typename R::integer_type xn, typename R::integer_type xd, bool xo,
+              typename R::integer_type yn, typename R::integer_type yd, bool yo ) {
+
+    typedef typename R::integer_type integer_type;
+
+    integer_type p[2] = { R::zero_, R::one_ }, q[2] = { R::one_, R::zero_ };
+
+    // descends the continued fractions of both bounds as long as they agree, a zero
+    // denominator stands for infinity
+    while ( true ) {
+
+        const integer_type a ( typename R::op_divides() ( xn, xd ) );
+        const integer_type r ( typename R::op_minus() ( xn, typename R::op_multiplies() ( a,
+                               xd ) ) );
+        const integer_type c ( xo || std::not_equal_to<integer_type>() ( r, R::zero_ ) ?
+                               integer_type ( typename R::op_plus() ( a, R::one_ ) ) : a );
+
+        if ( !std::not_equal_to<integer_type>() ( yd, R::zero_ ) ) return R ( typename
+                    R::op_plus() ( typename R::op_multiplies() ( c, p[1] ), p[0] ),
+                    typename R::op_plus() ( typename R::op_multiplies() ( c, q[1] ), q[0] ) );
+
+        const integer_type cy ( typename R::op_multiplies() ( c, yd ) );
+
+        if ( cy < yn || ( !yo && !std::not_equal_to<integer_type>() ( cy, yn ) ) ) {
+            return R ( typename R::op_plus() ( typename R::op_multiplies() ( c, p[1] ), p[0] ),
+                       typename R::op_plus() ( typename R::op_multiplies() ( c, q[1] ), q[0] ) );
+        }
+
+        integer_type x ( typename R::op_plus() ( typename R::op_multiplies() ( a, p[1] ),
+                         p[0] ) );
+
+        p[0] = RATIONAL_MOVE ( p[1] );
+        p[1] = RATIONAL_MOVE ( x );
+
+        x = typename R::op_plus() ( typename R::op_multiplies() ( a, q[1] ), q[0] );
+
+        q[0] = RATIONAL_MOVE ( q[1] );
+        q[1] = RATIONAL_MOVE ( x );
+
+        // continue with the interval [ 1 / (y - a), 1 / (x - a) ]
+        x = typename R::op_minus() ( yn, typename R::op_multiplies() ( a, yd ) );
+        yn = RATIONAL_MOVE ( xd );
+        xn = RATIONAL_MOVE ( yd );
+        xd = RATIONAL_MOVE ( x );
+        yd = r;
+
+        std::swap ( xo, yo );
+    }
 }
 
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic push
 /**
- * @relates Rational
+ * @ingroup main
+ * @brief Finds the simplest %Rational within an interval
  *
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam NumberType the number type
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ * The simplest %Rational is the one with the smallest denominator, and of those the one with
+ * the smallest absolute numerator. It is found by descending the continued fractions of both
+ * bounds simultaneously, i.e. in @f$ O(n) @f$ steps for @f$ n @f$ terms of the shorter
+ * continued fraction.
+ *
+ * Combined with Rational(const NumberType&) on the bounds of all values rounding to a
+ * floating point number, it gives the shortest fraction representing that number.
+ *
+ * @param[in] a one bound of the interval
+ * @param[in] b the other bound of the interval
+ * @param[in] open @c true if the bounds are excluded from the interval
+ *
+ * @throws std::domain_error if the interval is empty
+ *
+ * @return the simplest %Rational within @f$ [a, b] @f$, or @f$ (a, b) @f$ if @c open
  */
 template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType>
-RATIONAL_CONSTEXPR bool operator< ( const Rational<T, GCD, CHKOP, Alloc>& o, const NumberType& n ) {
-    return ( o < Rational<T, GCD, CHKOP, Alloc> ( n ) );
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc> simplest ( const Rational<T, GCD, CHKOP, Alloc>& a,
+        const Rational<T, GCD, CHKOP, Alloc>& b, bool open = false ) {
+
+    typedef Rational<T, GCD, CHKOP, Alloc> rat;
+
+    const rat& x ( b < a ? b : a );
+    const rat& y ( b < a ? a : b );
+
+#ifdef __EXCEPTIONS
+    if ( open && ! ( x < y ) ) throw std::domain_error ( "the interval is empty" );
+#endif
+
+    if ( open ? ( x.numerator() < rat::zero_ && rat::zero_ < y.numerator() ) :
+            ( ! ( rat::zero_ < x.numerator() ) && ! ( y.numerator() < rat::zero_ ) ) ) {
+        return rat();
+    }
+
+    if ( rat::zero_ < y.numerator() ) {
+        return _simplest<rat> ( x.numerator(), x.denominator(), open, y.numerator(),
+                                y.denominator(), open );
+    }
+
+    return -_simplest<rat> ( typename rat::op_negate() ( y.numerator() ), y.denominator(), open,
+                             typename rat::op_negate() ( x.numerator() ), x.denominator(),
+                             open );
 }
 
-/**
- * @relates Rational
- *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
-template<typename NumberType, typename T,
-         template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-RATIONAL_CONSTEXPR bool operator<= ( const NumberType& n,
-                                     const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ! ( o < Rational<T, GCD, CHKOP, Alloc> ( n ) );
+template<class R>
+typename R::integer_type _sb_node ( const R& r, typename R::integer_type *bounds ) {
+
+    typedef typename R::integer_type integer_type;
+
+#ifdef __EXCEPTIONS
+    if ( ! ( R::zero_ < r.numerator() ) ) {
+        throw std::domain_error ( "the Stern-Brocot tree contains positive rationals only" );
+    }
+#endif
+
+    integer_type u ( r.numerator() ), v ( r.denominator() ), d ( R::zero_ );
+    integer_type p[2] = { R::zero_, R::one_ }, q[2] = { R::one_, R::zero_ };
+
+    while ( true ) {
+
+        const integer_type a ( typename R::op_divides() ( u, v ) );
+        const integer_type w ( typename R::op_minus() ( u, typename R::op_multiplies() ( a,
+                               v ) ) );
+
+        d = typename R::op_plus() ( d, a );
+
+        if ( !std::not_equal_to<integer_type>() ( w, R::zero_ ) ) {
+
+            // the neighbours are the previous convergent and [a_0; ..., a_n - 1]
+            integer_type op ( typename R::op_minus() ( r.numerator(), p[1] ) );
+            integer_type oq ( typename R::op_minus() ( r.denominator(), q[1] ) );
+
+            const bool prevLeft = typename R::op_multiplies() ( p[1], oq ) <
+                                  typename R::op_multiplies() ( op, q[1] );
+
+            bounds[prevLeft ? 0 : 2] = p[1];
+            bounds[prevLeft ? 1 : 3] = q[1];
+            bounds[prevLeft ? 2 : 0] = RATIONAL_MOVE ( op );
+            bounds[prevLeft ? 3 : 1] = RATIONAL_MOVE ( oq );
+
+            return typename R::op_minus() ( d, R::one_ );
+        }
+
+        integer_type x ( typename R::op_plus() ( typename R::op_multiplies() ( a, p[1] ),
+                         p[0] ) );
+
+        p[0] = RATIONAL_MOVE ( p[1] );
+        p[1] = RATIONAL_MOVE ( x );
+
+        x = typename R::op_plus() ( typename R::op_multiplies() ( a, q[1] ), q[0] );
+
+        q[0] = RATIONAL_MOVE ( q[1] );
+        q[1] = RATIONAL_MOVE ( x );
+
+        u = RATIONAL_MOVE ( v );
+        v = w;
+    }
 }
+#pragma GCC diagnostic pop
 
-/**
- * @relates Rational
- *
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam NumberType the number type
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
- */
+// r in lowest terms regardless of the policy (GCD_null doesn't reduce), as the neighbours and
+// the mediants are only the ones of the tree for the reduced fraction
 template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
-bool operator<= ( const Rational<T, GCD, CHKOP, Alloc>& o, const NumberType& n ) {
-    return ! ( Rational<T, GCD, CHKOP, Alloc> ( n ) < o );
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc> _sb_reduced ( const Rational<T, GCD, CHKOP, Alloc>& r ) {
+
+    typedef Rational<T, GCD, CHKOP, Alloc> rat;
+
+    const T g ( GCD_euclid<T, std::numeric_limits<T>::is_signed, CHKOP, TYPE_CONVERT>() (
+                    r.numerator(), r.denominator() ) );
+
+    return std::not_equal_to<T>() ( g, rat::one_ ) && std::not_equal_to<T>() ( g, rat::zero_ ) ?
+           rat ( typename rat::op_divides() ( r.numerator(), g ),
+                 typename rat::op_divides() ( r.denominator(), g ) ) : r;
 }
 
 /**
- * @relates Rational
+ * @ingroup main
+ * @brief gets the depth of a %Rational in the Stern-Brocot tree
  *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ * The root @f$ \frac{1}{1} @f$ has the depth @c 0. The depth is the sum of the terms of the
+ * continued fraction minus one.
+ *
+ * @param[in] r a positive %Rational
+ *
+ * @throws std::domain_error if @c r is not positive
+ *
+ * @return the depth of @c r
  */
-template<typename NumberType, typename T,
-         template<typename, bool, template<class, typename, bool> class,
+template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
          template<typename> class Alloc>
-RATIONAL_CONSTEXPR bool operator> ( const NumberType& n, const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return o < Rational<T, GCD, CHKOP, Alloc> ( n );
+T sb_depth ( const Rational<T, GCD, CHKOP, Alloc>& r ) {
+
+    T bounds[4];
+
+    return _sb_node ( r, bounds );
 }
 
 /**
- * @relates Rational
+ * @ingroup main
+ * @brief gets the left child of a %Rational in the Stern-Brocot tree
  *
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam NumberType the number type
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ * @param[in] r a positive %Rational
+ *
+ * @throws std::domain_error if @c r is not positive
+ *
+ * @return the mediant of @c r and its left neighbour
  */
-template<typename T,
-         template<typename, bool, template<class, typename, bool> class,
+template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
-bool operator> ( const Rational<T, GCD, CHKOP, Alloc>& o, const NumberType& n ) {
-    return Rational<T, GCD, CHKOP, Alloc> ( n ) < o;
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc> sb_left ( const Rational<T, GCD, CHKOP, Alloc>& r ) {
+
+    typedef Rational<T, GCD, CHKOP, Alloc> rat;
+
+    const rat n ( _sb_reduced ( r ) );
+    T bounds[4];
+
+    _sb_node ( n, bounds );
+
+    return rat ( typename rat::op_plus() ( bounds[0], n.numerator() ),
+                 typename rat::op_plus() ( bounds[1], n.denominator() ) );
 }
 
 /**
- * @relates Rational
+ * @ingroup main
+ * @brief gets the right child of a %Rational in the Stern-Brocot tree
  *
- * @tparam NumberType the number type
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ * @param[in] r a positive %Rational
+ *
+ * @throws std::domain_error if @c r is not positive
+ *
+ * @return the mediant of @c r and its right neighbour
  */
-template<typename NumberType, typename T,
-         template<typename, bool, template<class, typename, bool> class,
+template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
          template<typename> class Alloc>
-RATIONAL_CONSTEXPR bool operator>= ( const NumberType& n,
-                                     const Rational<T, GCD, CHKOP, Alloc>& o ) {
-    return ! ( Rational<T, GCD, CHKOP, Alloc> ( n ) < o );
+Rational<T, GCD, CHKOP, Alloc> sb_right ( const Rational<T, GCD, CHKOP, Alloc>& r ) {
+
+    typedef Rational<T, GCD, CHKOP, Alloc> rat;
+
+    const rat n ( _sb_reduced ( r ) );
+    T bounds[4];
+
+    _sb_node ( n, bounds );
+
+    return rat ( typename rat::op_plus() ( n.numerator(), bounds[2] ),
+                 typename rat::op_plus() ( n.denominator(), bounds[3] ) );
 }
 
 /**
- * @relates Rational
+ * @ingroup main
+ * @brief gets the parent of a %Rational in the Stern-Brocot tree
  *
- * @tparam T the storage type
- * @tparam GCD the GCD algorithm
- * @tparam NumberType the number type
- * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ * @param[in] r a positive %Rational other than @c 1
+ *
+ * @throws std::domain_error if @c r is not positive or the root @f$ \frac{1}{1} @f$
+ *
+ * @return the neighbour of @c r created last
  */
 template<typename T, template<typename, bool, template<class, typename, bool> class,
          template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType> RATIONAL_CONSTEXPR
-bool operator>= ( const Rational<T, GCD, CHKOP, Alloc>& o, const NumberType& n ) {
-    return ! ( o < Rational<T, GCD, CHKOP, Alloc> ( n ) );
-}
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc> sb_parent ( const Rational<T, GCD, CHKOP, Alloc>& r ) {
 
-template<typename NumberType, template<typename> class EPSILON>
-struct _approxUtils {
+    typedef Rational<T, GCD, CHKOP, Alloc> rat;
 
-    RATIONAL_NOCOPYASSIGN ( _approxUtils );
+    const rat n ( _sb_reduced ( r ) );
+    T bounds[4];
 
-    static bool approximated ( const NumberType& af, const NumberType& nt ) {
-        return abs ( af - nt ) < eps_;
+#ifdef __EXCEPTIONS
+    if ( !std::not_equal_to<T>() ( _sb_node ( n, bounds ), rat::zero_ ) ) {
+        throw std::domain_error ( "the root has no parent" );
     }
+#else
+    _sb_node ( n, bounds );
+#endif
 
-    static NumberType reciprocal ( const NumberType& x ) {
-        return one_ / x;
+    const bool left = typename rat::op_plus() ( bounds[2], bounds[3] ) <
+                      typename rat::op_plus() ( bounds[0], bounds[1] );
+
+    return rat ( bounds[left ? 0 : 2], bounds[left ? 1 : 3] );
+}
+
+template<class Reader>
+class _reader_iterator {
+
+public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef typename Reader::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type *pointer;
+    typedef const value_type& reference;
+
+    _reader_iterator() : r_ ( 0L ), val_() {}
+
+    explicit _reader_iterator ( Reader *r ) : r_ ( r ), val_() {
+        ++*this;
     }
 
-    const static NumberType eps_;
+    const typename Reader::value_type& operator*() const {
+        return val_;
+    }
 
-private:
-    static NumberType abs ( const NumberType& nt ) {
-        return nt < NumberType() ? NumberType ( -nt ) : nt;
+    const typename Reader::value_type *operator->() const {
+        return &val_;
     }
 
-private:
-    const static NumberType one_;
-};
+    _reader_iterator& operator++() {
 
-template<typename NumberType, template<typename> class EPSILON>
-const NumberType _approxUtils<NumberType, EPSILON>::eps_ ( EPSILON<NumberType>::value() );
+        if ( r_ && !r_->next ( val_ ) ) r_ = 0L;
 
-template<typename NumberType, template<typename> class EPSILON>
-const NumberType _approxUtils<NumberType, EPSILON>::one_ ( 1 );
+        return *this;
+    }
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType, template<typename> class EPSILON,
-         template<typename> class CONV>
-struct _approxFract<T, GCD, CHKOP, Alloc, NumberType, true, EPSILON, CONV> {
-private:
-    typedef Rational<T, GCD, CHKOP, Alloc> rat;
+    _reader_iterator operator++ ( int ) {
+        _reader_iterator tmp ( *this );
+        ++*this;
+        return tmp;
+    }
 
-public:
-    void operator() ( rat& r, const NumberType& nt ) const;
+    bool operator== ( const _reader_iterator& o ) const {
+        return r_ == o.r_;
+    }
+
+    bool operator!= ( const _reader_iterator& o ) const {
+        return r_ != o.r_;
+    }
 
 private:
-    const static T zero_;
-    const static T one_;
+    Reader *r_;
+    typename Reader::value_type val_;
 };
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType, template<typename> class EPSILON,
-         template<typename> class CONV>
-const T _approxFract<T, GCD, CHKOP, Alloc, NumberType, true, EPSILON, CONV>::zero_ = T();
+/**
+ * @ingroup main
+ * @brief Reads a stream of %Rational records
+ *
+ * Each record is read like by @c operator>>, but into a buffer kept over all records, so
+ * that no allocation per record is needed. Integers and fractions are parsed directly from
+ * that buffer, all other records are evaluated as @c expression.
+ *
+ * @code
+ * Commons::Math::RationalReader<Commons::Math::Rational<long> > reader ( std::cin, ',' );
+ * const Commons::Math::Rational<long> &sum ( std::accumulate ( reader.begin(), reader.end(),
+ *                                            Commons::Math::Rational<long>() ) );
+ * @endcode
+ *
+ * @see Commons::Math::rational_delimiter
+ *
+ * @tparam R the Commons::Math::Rational type to read
+ */
+template<class R>
+class RationalReader {
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType, template<typename> class EPSILON,
-         template<typename> class CONV>
-const T _approxFract<T, GCD, CHKOP, Alloc, NumberType, true, EPSILON, CONV>::one_ = T ( 1 );
+    RATIONAL_NOCOPYASSIGN ( RationalReader );
 
-#pragma GCC diagnostic ignored "-Wfloat-equal"
-#pragma GCC diagnostic push
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType, template<typename> class EPSILON,
-         template<typename> class CONV>
-void _approxFract<T, GCD, CHKOP, Alloc, NumberType, true, EPSILON, CONV>::operator() ( rat& r,
-        const NumberType& nt ) const {
+public:
+    typedef R value_type; ///< the type of the records
+    typedef _reader_iterator<RationalReader> iterator; ///< input iterator over the records
 
-#ifdef __EXCEPTIONS
-    if ( ! ( ! ( std::numeric_limits<T>::max() == zero_ ||
-                 std::numeric_limits<T>::min() == zero_ ) &&
-             ( nt > CONV<T> ( std::numeric_limits<T>::max() ).template convert<NumberType>() ||
-               nt < CONV<T> ( std::numeric_limits<T>::min() ).template convert<NumberType>() ) ) ) {
-#endif
+    /**
+     * @brief Constructs a reader on a stream
+     *
+     * @param[in] is the stream to read from
+     * @param[in] delim the record delimiter, @c 0 to delimit records by whitespace
+     */
+    explicit RationalReader ( std::istream& is, char delim = 0 ) : m_is ( is ), m_buf(),
+        m_delim ( delim ) {}
 
-        T m[2][2] = { { zero_, one_ }, { one_, zero_ } };
+    /**
+     * @brief reads the next record
+     *
+     * @param[out] r the %Rational to assign the record to
+     *
+     * @return @c false if there are no more records
+     */
+    bool next ( R& r ) {
 
-        NumberType x ( nt );
-        rat res ( r );
+        if ( R::_read_record ( m_is, m_buf, m_delim ) ) {
+            R::_assign_record ( &m_buf[0], &m_buf[0] + m_buf.size(), r );
+            return true;
+        }
 
-        while ( !_approxUtils<NumberType, EPSILON>::approximated ( res, nt ) ) {
+        return false;
+    }
 
-            using namespace std;
+    /**
+     * @brief reads the first record and returns an iterator pointing to it
+     */
+    iterator begin() {
+        return iterator ( this );
+    }
 
-            typename tmp::_ifThenElse<tmp::_isClassT<T>::Yes, const T&,
-                     const T>::ResultT n ( CONV<NumberType> ( floor ( x ) ).template convert<T>() );
+    /**
+     * @brief returns the end iterator
+     */
+    iterator end() const {
+        return iterator();
+    }
 
-            res.m_numer = typename rat::op_plus ()
-                          ( m[0][0], typename rat::op_multiplies () ( n, m[0][1] ) );
+private:
+    std::istream& m_is;
+    std::vector<char> m_buf;
+    const char m_delim;
+};
 
-            m[0][0] = RATIONAL_MOVE ( m[0][1] );
-            m[0][1] = res.m_numer;
+/**
+ * @ingroup main
+ * @brief Generates the digits of the positional expansion of a %Rational on demand
+ *
+ * Each call of next() calculates exactly one digit after the radix point, so only the
+ * requested digits of fractions with long reptends are ever calculated. The position of
+ * the first digit of the reptend is known in advance, while its length is not calculated
+ * at all (see Commons::Math::Rational::decompose() for that).
+ *
+ * @code
+ * Commons::Math::RationalDigits<Commons::Math::Rational<long> > d ( r, 10, 50 );
+ *
+ * std::cout << d.whole() << '.';
+ *
+ * for ( int digit; d.next ( digit ); ) {
+ *     if ( d.position() == d.period_start() + 1u && !d.terminating() ) std::cout << '(';
+ *     std::cout << digit;
+ * }
+ * @endcode
+ *
+ * @tparam R the Commons::Math::Rational type to expand
+ */
+template<class R>
+class RationalDigits {
 
-            res.m_denom = typename rat::op_plus ()
-                          ( m[1][0], typename rat::op_multiplies () ( n, m[1][1] ) );
+    RATIONAL_NOCOPYASSIGN ( RationalDigits );
 
-            m[1][0] = RATIONAL_MOVE ( m[1][1] );
-            m[1][1] = res.m_denom;
+    typedef typename R::integer_type integer_type;
 
-            typename tmp::_ifThenElse<tmp::_isClassT<NumberType>::Yes, const NumberType&,
-                     const NumberType>::ResultT
-                     d ( x - CONV<T> ( n ).template convert<NumberType>() );
+public:
+    typedef int value_type; ///< the type of the digits
+    typedef _reader_iterator<RationalDigits> iterator; ///< input iterator over the digits
 
-            if ( !_approxUtils<NumberType, EPSILON>::approximated ( d, NumberType() ) ) {
-                x = _approxUtils<NumberType, EPSILON>::reciprocal ( d );
-            } else {
-                break;
-            }
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic push
+    /**
+     * @brief Constructs a digit generator
+     *
+     * @param[in] r the %Rational to expand
+     * @param[in] base the base of the expansion, at least @c 2
+     * @param[in] limit the maximum amount of digits to generate
+     */
+    explicit RationalDigits ( const R& r, int base = 10,
+                              std::size_t limit = static_cast<std::size_t> ( -1 ) ) :
+        m_base ( base ), m_denom ( r.denominator() ), m_whole ( typename R::op_divides() (
+                    r.numerator(), r.denominator() ) ), m_rem ( typename R::op_modulus() (
+                                r.numerator(), r.denominator() ) ), m_pre ( 0u ), m_pos ( 0u ),
+        m_limit ( limit ), m_neg ( r.numerator() < R::zero_ ), m_term ( false ) {
+
+        if ( m_rem < R::zero_ ) m_rem = RATIONAL_MOVE ( typename R::op_negate() ( m_rem ) );
+
+        // the period depends on the reduced denominator, which GCD_null doesn't provide
+        const integer_type g ( R::_euclid ( m_rem, m_denom ) );
+
+        if ( std::not_equal_to<integer_type>() ( g, R::one_ ) ) {
+            m_rem   = RATIONAL_MOVE ( typename R::op_divides() ( m_rem, g ) );
+            m_denom = RATIONAL_MOVE ( typename R::op_divides() ( m_denom, g ) );
         }
 
-        r = RATIONAL_MOVE ( res );
+        integer_type d ( m_denom );
 
-#ifdef __EXCEPTIONS
-    } else {
-        throw std::domain_error ( "rational approximation overflow" );
+        m_pre  = R::_strip_base ( d, m_base );
+        m_term = !std::not_equal_to<integer_type>() ( d, R::one_ );
     }
-#endif
-}
 #pragma GCC diagnostic pop
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename NumberType, template<typename> class EPSILON,
-         template<typename> class CONV>
-struct _approxFract<T, GCD, CHKOP, Alloc, NumberType, false, EPSILON, CONV> {
-    void operator() ( const Rational<T, GCD, CHKOP, Alloc>&,
-                      const NumberType& ) const RATIONAL_NOEXCEPT {}
-};
+    /**
+     * @brief calculates the next digit
+     *
+     * @param[out] digit the next digit within @c 0 and @c base - 1
+     *
+     * @return @c false if the expansion terminated or the limit is reached
+     */
+    bool next ( int& digit ) {
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-struct _abs<T, GCD, CHKOP, Alloc, true> {
+        if ( m_pos == m_limit || !std::not_equal_to<integer_type>() ( m_rem, R::zero_ ) ) {
+            return false;
+        }
+
+        const integer_type t ( typename R::op_multiplies() ( m_rem, m_base ) );
+        const integer_type q ( typename R::op_divides() ( t, m_denom ) );
+
+        m_rem = RATIONAL_MOVE ( typename R::op_minus() ( t, typename R::op_multiplies() ( q,
+                                m_denom ) ) );
+        digit = static_cast<int> ( typename RationalTraits<integer_type>::type_convert ( q ).
+                                   template convert<long>() );
+        ++m_pos;
+
+        return true;
+    }
+
+    /**
+     * @brief the whole part, truncated towards zero
+     */
+    const integer_type& whole() const {
+        return m_whole;
+    }
 
-    RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc>
-    operator() ( const Rational<T, GCD, CHKOP, Alloc>& r ) const {
-        return r.numerator() < Rational<T, GCD, CHKOP, Alloc>::zero_ ? -r : r;
+    /**
+     * @brief @c true if the %Rational is negative
+     */
+    bool negative() const {
+        return m_neg;
     }
-};
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-struct _abs<T, GCD, CHKOP, Alloc, false> {
+    /**
+     * @brief the amount of digits before the reptend
+     *
+     * The digit at the (zero based) index period_start() is the first digit of the reptend.
+     */
+    std::size_t period_start() const {
+        return m_pre;
+    }
 
-    RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc>
-    operator() ( const Rational<T, GCD, CHKOP, Alloc>& r ) const {
-        return r;
+    /**
+     * @brief @c true if the expansion has no reptend
+     */
+    bool terminating() const {
+        return m_term;
     }
-};
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-struct _mod<T, GCD, CHKOP, Alloc, true> {
+    /**
+     * @brief the amount of digits generated so far
+     */
+    std::size_t position() const {
+        return m_pos;
+    }
 
-    typedef std::pair<T, Rational<T, GCD, CHKOP, Alloc> > pair_type;
+    /**
+     * @brief calculates the first digit and returns an iterator pointing to it
+     */
+    iterator begin() {
+        return iterator ( this );
+    }
 
-    pair_type operator() ( const Rational<T, GCD, CHKOP, Alloc>& r ) const;
+    /**
+     * @brief returns the end iterator
+     */
+    iterator end() const {
+        return iterator();
+    }
+
+private:
+    const integer_type m_base;
+    integer_type m_denom;
+    const integer_type m_whole;
+    integer_type m_rem;
+    std::size_t m_pre;
+    std::size_t m_pos;
+    const std::size_t m_limit;
+    const bool m_neg;
+    bool m_term;
 };
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-typename _mod<T, GCD, CHKOP, Alloc, true>::pair_type
-_mod<T, GCD, CHKOP, Alloc, true>::operator() ( const Rational<T, GCD, CHKOP, Alloc>& r ) const {
+/**
+ * @ingroup main
+ * @brief Generates the convergents of a %Rational
+ *
+ * The convergents @f$ \frac{p_k}{q_k} @f$ are calculated incrementally by the recurrence
+ * cf() uses, while the partial quotients are extracted like by seq(). If requested, the
+ * semiconvergents @f$ \frac{p_{k-2} + j p_{k-1}}{q_{k-2} + j q_{k-1}} @f$,
+ * @f$ 0 < j < a_k @f$ are generated between the convergents, so that all %Rationals are
+ * generated in the order of increasing denominators.
+ *
+ * The generation stops at the %Rational itself, before the first denominator greater than
+ * a bound, or after the first %Rational within a tolerance.
+ *
+ * @code
+ * Commons::Math::RationalConvergents<Commons::Math::Rational<long> > c ( pi_approx );
+ *
+ * c.denominator_bound ( 1000 );
+ *
+ * for ( Commons::Math::Rational<long> r; c.next ( r ); ) std::cout << r << std::endl;
+ * @endcode
+ *
+ * @see Commons::Math::cf()
+ * @see Commons::Math::seq()
+ *
+ * @tparam R the Commons::Math::Rational type
+ */
+template<class R>
+class RationalConvergents {
 
-    const Rational<T, GCD, CHKOP, Alloc>& h ( Rational<T, GCD, CHKOP, Alloc> (
-                ( typename Rational<T, GCD, CHKOP, Alloc>::op_modulus()
-                  ( r.m_numer, r.m_denom ) ), r.m_denom ) );
+    RATIONAL_NOCOPYASSIGN ( RationalConvergents );
 
-    return std::make_pair ( typename Rational<T, GCD, CHKOP, Alloc>::op_divides() ( r.m_numer,
-                            r.m_denom ), h );
-}
+    typedef typename R::integer_type integer_type;
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-struct _mod<T, GCD, CHKOP, Alloc, false> {
+public:
+    typedef R value_type; ///< the type of the convergents
+    typedef _reader_iterator<RationalConvergents> iterator; ///< input iterator over the convergents
 
-    typedef std::pair<T, Rational<T, GCD, CHKOP, Alloc> > pair_type;
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic push
+    /**
+     * @brief Constructs a convergent generator
+     *
+     * @param[in] r the %Rational to approximate
+     * @param[in] semiconvergents @c true to generate the semiconvergents too
+     */
+    explicit RationalConvergents ( const R& r, bool semiconvergents = false ) : m_r ( r ),
+        m_u ( r.numerator() < R::zero_ ? integer_type ( typename R::op_negate() (
+                    r.numerator() ) ) : r.numerator() ), m_v ( r.denominator() ), m_a (),
+        m_j (), m_bound (), m_tol (), m_semi ( semiconvergents ), m_neg ( r.numerator() <
+                R::zero_ ), m_first ( true ), m_fetch ( true ), m_bounded ( false ),
+        m_tolerant ( false ), m_stop ( false ) {
 
-    RATIONAL_CONSTEXPR pair_type operator() ( const Rational<T, GCD, CHKOP, Alloc>& r ) const {
-        return std::make_pair ( typename Rational<T, GCD, CHKOP, Alloc>::op_divides() ( r.m_numer,
-                                r.m_denom ), Rational<T, GCD, CHKOP, Alloc> (
-                                    ( typename Rational<T, GCD, CHKOP, Alloc>::op_modulus()
-                                      ( r.m_numer, r.m_denom ) ), r.m_denom ) );
+        m_p[0] = m_q[1] = R::zero_;
+        m_p[1] = m_q[0] = R::one_;
     }
-};
+#pragma GCC diagnostic pop
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-struct _pow<T, GCD, CHKOP, Alloc, false> {
-    Rational<T, GCD, CHKOP, Alloc> operator() ( const Rational<T, GCD, CHKOP, Alloc>& r,
-            const T& exp ) const;
-};
+    /**
+     * @brief stops the generation before the first denominator greater than @c q
+     *
+     * @param[in] q the maximum denominator
+     *
+     * @return a reference to this generator
+     */
+    RationalConvergents& denominator_bound ( const integer_type& q ) {
+        m_bound = q;
+        m_bounded = true;
+        return *this;
+    }
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc> Rational<T, GCD, CHKOP, Alloc>
-_pow<T, GCD, CHKOP, Alloc, false>::operator() ( const Rational<T, GCD, CHKOP, Alloc>& r,
-        const T& exp ) const {
-#ifdef __EXCEPTIONS
-    if ( exp > Rational<T, GCD, CHKOP, Alloc>::zero_ ) {
-#endif
+    /**
+     * @brief stops the generation after the first %Rational with an error of at most @c eps
+     *
+     * @param[in] eps the tolerance
+     *
+     * @return a reference to this generator
+     */
+    RationalConvergents& tolerance ( const R& eps ) {
+        m_tol = eps;
+        m_tolerant = true;
+        return *this;
+    }
 
-        Rational<T, GCD, CHKOP, Alloc> b ( r );
-        Rational<T, GCD, CHKOP, Alloc> result ( Rational<T, GCD, CHKOP, Alloc>::one_,
-                                                Rational<T, GCD, CHKOP, Alloc>::one_ );
-        T e ( exp );
+    /**
+     * @brief calculates the next convergent or semiconvergent
+     *
+     * @param[out] r the %Rational to assign the convergent to
+     *
+     * @return @c false if there are no more convergents
+     */
+    bool next ( R& r ) {
 
-        do {
+        if ( m_stop ) return false;
 
-            if ( ( e & 1 ) != Rational<T, GCD, CHKOP, Alloc>::zero_ ) result *= b;
+        if ( m_fetch ) {
 
-            e >>= 1;
-            b *= b;
+            if ( !std::not_equal_to<integer_type>() ( m_v, R::zero_ ) ) return false;
 
-        } while ( e != Rational<T, GCD, CHKOP, Alloc>::zero_ );
+            m_a = typename R::op_divides() ( m_u, m_v );
 
-        return result;
+            const integer_type w ( typename R::op_minus() ( m_u,
+                                   typename R::op_multiplies() ( m_a, m_v ) ) );
 
-#ifdef __EXCEPTIONS
-    } else {
-        throw std::domain_error ( "power is undefined for zero" );
-    }
-#endif
-}
+            m_u = RATIONAL_MOVE ( m_v );
+            m_v = RATIONAL_MOVE ( w );
+            m_j = R::zero_;
+            m_fetch = false;
+        }
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-struct _pow<T, GCD, CHKOP, Alloc, true> {
+        integer_type p, q;
 
-    Rational<T, GCD, CHKOP, Alloc> operator() ( const Rational<T, GCD, CHKOP, Alloc>& r,
-            const T& exp ) const {
+        if ( m_semi && !m_first && ( m_j = typename R::op_plus() ( m_j, R::one_ ) ) < m_a ) {
 
-#ifdef __EXCEPTIONS
-        if ( exp >= Rational<T, GCD, CHKOP, Alloc>::zero_ ) {
-#endif
-            return _pow<T, GCD, CHKOP, Alloc, false>() ( r, exp );
+            p = typename R::op_plus() ( typename R::op_multiplies() ( m_j, m_p[1] ), m_p[0] );
+            q = typename R::op_plus() ( typename R::op_multiplies() ( m_j, m_q[1] ), m_q[0] );
 
-#ifdef __EXCEPTIONS
         } else {
-            throw std::domain_error ( "power is undefined for negative numbers" );
+
+            p = typename R::op_plus() ( typename R::op_multiplies() ( m_a, m_p[1] ), m_p[0] );
+            q = typename R::op_plus() ( typename R::op_multiplies() ( m_a, m_q[1] ), m_q[0] );
+
+            m_p[0] = m_p[1];
+            m_p[1] = p;
+            m_q[0] = m_q[1];
+            m_q[1] = q;
+
+            m_first = false;
+            m_fetch = true;
         }
-#endif
-    }
-};
 
-template<typename T, bool IsSigned, template<class, typename, bool> class CHKOP,
-         template<typename> class CONV> struct GCD_null {
+        if ( m_bounded && m_bound < q ) {
+            m_stop = true;
+            return false;
+        }
 
-    RATIONAL_CONSTEXPR const T& operator() ( const T&, const T& ) const RATIONAL_NOEXCEPT {
-        return one_;
-    }
+        // the convergents are reduced already
+        r.m_numer = m_neg ? integer_type ( typename R::op_negate() ( p ) ) : p;
+        r.m_denom = q;
 
-private:
-    const static T one_;
-};
+        if ( m_tolerant && ( m_r < r ? R ( r ) -= m_r : R ( m_r ) -= r ) <= m_tol ) m_stop = true;
 
-template<typename T, bool IsSigned, template<class, typename, bool> class CHKOP,
-         template<typename> class CONV>
-const T GCD_null<T, IsSigned, CHKOP, CONV>::one_ = T ( 1 );
+        return true;
+    }
 
-template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
-struct GCD_euclid_fast<T, false, CHKOP, CONV> {
+    /**
+     * @brief calculates the first convergent and returns an iterator pointing to it
+     */
+    iterator begin() {
+        return iterator ( this );
+    }
 
-    T operator() ( const T& a, const T& b ) const;
+    /**
+     * @brief returns the end iterator
+     */
+    iterator end() const {
+        return iterator();
+    }
 
 private:
-    static const T zero_;
+    const R m_r;
+    integer_type m_u;
+    integer_type m_v;
+    integer_type m_a;
+    integer_type m_j;
+    integer_type m_p[2];
+    integer_type m_q[2];
+    integer_type m_bound;
+    R m_tol;
+    const bool m_semi;
+    const bool m_neg;
+    bool m_first;
+    bool m_fetch;
+    bool m_bounded;
+    bool m_tolerant;
+    bool m_stop;
 };
 
-template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
-const T GCD_euclid_fast<T, false, CHKOP, CONV>::zero_ = T();
-
-template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
-T GCD_euclid_fast<T, false, CHKOP, CONV>::operator() ( const T& a, const T& b ) const {
-
-    T x ( a ), y ( b );
+/**
+ * @ingroup main
+ * @brief Generates the Farey sequence of order @c n
+ *
+ * All reduced fractions with denominators not greater than @c n within a range are generated
+ * in increasing order by the next term recurrence
+ * @f$ \frac{p_{k+1}}{q_{k+1}} = \frac{\lfloor\frac{n + q_{k-1}}{q_k}\rfloor p_k - p_{k-1}}
+ * {\lfloor\frac{n + q_{k-1}}{q_k}\rfloor q_k - q_{k-1}} @f$, i.e. without any gcd
+ * calculation or allocation and with a constant amount of state. The first two terms of a
+ * range are found by descending the Stern-Brocot tree towards its lower bound.
+ *
+ * @code
+ * Commons::Math::FareySequence<Commons::Math::Rational<long> > f ( 5 );
+ *
+ * // 0/1 1/5 1/4 1/3 2/5 1/2 3/5 2/3 3/4 4/5 1/1
+ * for ( Commons::Math::Rational<long> r; f.next ( r ); ) std::cout << r << ' ';
+ * @endcode
+ *
+ * @see Commons::Math::farey()
+ *
+ * @tparam R the Commons::Math::Rational type
+ */
+template<class R>
+class FareySequence {
 
-    while ( std::not_equal_to<T>() ( y, zero_ ) ) {
+    RATIONAL_NOCOPYASSIGN ( FareySequence );
 
-        x %= y;
-        y ^= x;
-        x ^= y;
-        y ^= x;
-    }
+    typedef typename R::integer_type integer_type;
+    typedef typename R::op_plus op_plus;
+    typedef typename R::op_minus op_minus;
+    typedef typename R::op_multiplies op_multiplies;
+    typedef typename R::op_divides op_divides;
 
-    return x;
-}
+public:
+    typedef R value_type; ///< the type of the fractions
+    typedef _reader_iterator<FareySequence> iterator; ///< input iterator over the fractions
 
-template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
-struct GCD_euclid_fast<T, true, CHKOP, CONV> {
+    /**
+     * @brief Constructs a Farey sequence generator
+     *
+     * @param[in] n the order, i.e. the maximum denominator
+     * @param[in] lo the lower bound of the range (inclusive)
+     * @param[in] hi the upper bound of the range (inclusive)
+     */
+    explicit FareySequence ( const integer_type& n, const R& lo = R(),
+                             const R& hi = R ( R::one_, R::one_ ) ) : m_n ( n ),
+        m_hn ( hi.numerator() ), m_hd ( hi.denominator() ), m_done ( ! ( R::zero_ < n ) ||
+                hi < lo ) {
 
-    T operator() ( const T& a, const T& b ) const;
+        if ( !m_done ) _init ( lo.numerator(), lo.denominator() );
+    }
 
-private:
-    static const T zero_;
-};
+    /**
+     * @brief gets the next fraction
+     *
+     * @param[out] r the %Rational to assign the fraction to
+     *
+     * @return @c false if the end of the range is reached
+     */
+    bool next ( R& r ) {
 
-template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
-const T GCD_euclid_fast<T, true, CHKOP, CONV>::zero_ = T();
+        if ( m_done || op_multiplies() ( m_hn, m_cd ) < op_multiplies() ( m_cn, m_hd ) ) {
+            m_done = true;
+            return false;
+        }
 
-template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
-T GCD_euclid_fast<T, true, CHKOP, CONV>::operator() ( const T& a, const T& b ) const {
-    typename tmp::_ifThenElse<tmp::_isClassT<T>::Yes, const T&,
-             const T>::ResultT h ( GCD_euclid_fast<T, false, CHKOP, CONV>() ( a, b ) );
-    return h < zero_ ? T ( -h ) : h;
-}
+        r.m_numer = m_cn;
+        r.m_denom = m_cd;
 
-template<typename T, template<class, typename = T, bool = false> class CHKOP,
-         template<typename> class CONV> struct GCD_euclid<T, false, CHKOP, CONV> {
+        const integer_type k ( op_divides() ( op_plus() ( m_n, m_cd ), m_nd ) );
+        integer_type x ( op_minus() ( op_multiplies() ( k, m_nn ), m_cn ) );
 
-    T operator() ( const T& a, const T& b ) const {
+        m_cn = m_nn;
+        m_nn = RATIONAL_MOVE ( x );
 
-        T x ( a ), y ( b );
+        x = op_minus() ( op_multiplies() ( k, m_nd ), m_cd );
 
-        while ( std::not_equal_to<T>() ( y, zero_ ) ) {
+        m_cd = m_nd;
+        m_nd = RATIONAL_MOVE ( x );
 
-            typename tmp::_ifThenElse<tmp::_isClassT<T>::Yes, const T&,
-                     const T>::ResultT h ( CHKOP<std::modulus<T> >() ( x, y ) );
+        return true;
+    }
 
-            x = RATIONAL_MOVE ( y );
-            y = RATIONAL_MOVE ( h );
-        }
+    /**
+     * @brief gets the first fraction and returns an iterator pointing to it
+     */
+    iterator begin() {
+        return iterator ( this );
+    }
 
-        return x;
+    /**
+     * @brief returns the end iterator
+     */
+    iterator end() const {
+        return iterator();
     }
 
 private:
-    static const T zero_;
-};
-
-template<typename T, template<class, typename = T, bool = false> class CHKOP,
-         template<typename> class CONV>
-const T GCD_euclid<T, false, CHKOP, CONV>::zero_ = T();
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic push
+    void _init ( const integer_type& xn, const integer_type& xd ) {
 
-template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
-struct GCD_euclid<T, true, CHKOP, CONV> {
+        const op_plus add = op_plus();
+        const op_minus sub = op_minus();
+        const op_multiplies mul = op_multiplies();
+        const op_divides div = op_divides();
 
-    T operator() ( const T& a, const T& b ) const;
+        integer_type a ( div ( xn, xd ) );
 
-private:
-    static const T zero_;
-};
+        if ( xn < R::zero_ && std::not_equal_to<integer_type>() ( mul ( a, xd ), xn ) ) {
+            a = sub ( a, R::one_ );
+        }
 
-template<typename T, template<class, typename = T, bool = false> class CHKOP,
-         template<typename> class CONV>
-const T GCD_euclid<T, true, CHKOP, CONV>::zero_ = T();
+        // the neighbours of x in the Farey sequence of order n, at first of order 1
+        integer_type ln ( a ), ld ( R::one_ ), rn ( add ( a, R::one_ ) ), rd ( R::one_ );
 
-template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
-T GCD_euclid<T, true, CHKOP, CONV>::operator() ( const T& a, const T& b ) const {
-    typename tmp::_ifThenElse<tmp::_isClassT<T>::Yes, const T&,
-             const T>::ResultT h ( GCD_euclid<T, false, CHKOP, CONV>() ( a, b ) );
-    return h < zero_ ? T ( -h ) : h;
-}
+        while ( true ) {
 
-template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
-struct GCD_stein<T, false, CHKOP, CONV> {
+            const integer_type A ( sub ( mul ( xn, ld ), mul ( ln, xd ) ) ),
+                  B ( sub ( mul ( rn, xd ), mul ( xn, rd ) ) );
 
-    T operator() ( const T& a, const T& b ) const;
+            if ( !std::not_equal_to<integer_type>() ( A, R::zero_ ) ) {
 
-private:
-    static const T zero_;
-};
+                const integer_type k ( div ( sub ( m_n, rd ), ld ) );
 
-template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
-const T GCD_stein<T, false, CHKOP, CONV>::zero_ = T();
+                m_cn = ln;
+                m_cd = ld;
+                m_nn = add ( rn, mul ( k, ln ) );
+                m_nd = add ( rd, mul ( k, ld ) );
 
-template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
-T GCD_stein<T, false, CHKOP, CONV>::operator() ( const T& a, const T& b ) const {
+                return;
+            }
 
-    T x ( a ), y ( b ), f = zero_;
+            if ( !std::not_equal_to<integer_type>() ( B, R::zero_ ) ) {
 
-    while ( std::not_equal_to<T>() ( y, zero_ ) ) {
+                const integer_type k ( div ( sub ( m_n, ld ), rd ) );
 
-        if ( x < y ) {
+                ln = add ( ln, mul ( k, rn ) );
+                ld = add ( ld, mul ( k, rd ) );
 
-            y ^= x;
-            x ^= y;
-            y ^= x;
+                break;
+            }
 
-        } else if ( T ( x & 1 ) == zero_ ) {
+            integer_type k ( std::min<integer_type> ( div ( A, B ), div ( sub ( m_n, ld ), rd ) ) );
 
-            x >>= 1;
+            if ( R::zero_ < k ) {
+                ln = add ( ln, mul ( k, rn ) );
+                ld = add ( ld, mul ( k, rd ) );
+                continue;
+            }
 
-            if ( T ( y & 1 ) == zero_ ) {
-                y >>= 1;
-                ++f;
+            if ( R::zero_ < ( k = std::min<integer_type> ( div ( B, A ),
+                                  div ( sub ( m_n, rd ), ld ) ) ) ) {
+                rn = add ( rn, mul ( k, ln ) );
+                rd = add ( rd, mul ( k, ld ) );
+                continue;
             }
 
-        } else if ( T ( y & 1 ) == zero_ ) {
-            y >>= 1;
-        } else {
-            x -= y;
+            break;
         }
+
+        // the upper neighbour is the first term, its successor the second
+        const integer_type k ( div ( add ( m_n, ld ), rd ) );
+
+        m_cn = rn;
+        m_cd = rd;
+        m_nn = sub ( mul ( k, rn ), ln );
+        m_nd = sub ( mul ( k, rd ), ld );
     }
+#pragma GCC diagnostic pop
 
-    return x << CONV<T> ( f ).template convert<unsigned long int>();
-}
+    const integer_type m_n;
+    const integer_type m_hn;
+    const integer_type m_hd;
+    integer_type m_cn;
+    integer_type m_cd;
+    integer_type m_nn;
+    integer_type m_nd;
+    bool m_done;
+};
 
-template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
-struct GCD_stein<T, true, CHKOP, CONV> {
+/**
+ * @ingroup main
+ * @brief Writes the Farey sequence of order @c n within a range
+ *
+ * If @c threads is greater than @c 1 and C++11 is available, the range is split into
+ * @c threads parts of equal length, which are generated in parallel and written in order.
+ *
+ * @see Commons::Math::FareySequence
+ *
+ * @param[in] n the order, i.e. the maximum denominator
+ * @param[in] lo the lower bound of the range (inclusive)
+ * @param[in] hi the upper bound of the range (inclusive)
+ * @param[out] out iterator to output the sequence to
+ * @param[in] threads the maximum amount of threads to use
+ *
+ * @return iterator pointing to the end of @c out
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc, typename OIter>
+OIter farey ( const T& n, const Rational<T, GCD, CHKOP, Alloc>& lo,
+              const Rational<T, GCD, CHKOP, Alloc>& hi, OIter out, unsigned int threads = 1u ) {
 
-    T operator() ( const T& a, const T& b ) const;
+    typedef Rational<T, GCD, CHKOP, Alloc> rat;
 
-private:
-    static const T zero_;
-};
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    if ( threads > 1u && lo < hi ) {
 
-template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
-const T GCD_stein<T, true, CHKOP, CONV>::zero_ = T();
+        std::vector<rat> bounds ( 1u, lo );
+        std::vector<std::vector<rat> > parts ( threads );
 
-template<typename T, template<class, typename, bool> class CHKOP, template<typename> class CONV>
-T GCD_stein<T, true, CHKOP, CONV>::operator() ( const T& a, const T& b ) const {
-    return GCD_stein<T, false, CHKOP, CONV>()
-           ( a < zero_ ? T ( -a ) : a, b < zero_ ? T ( -b ) : b );
-}
+        for ( unsigned int i = 1u; i < threads; ++i ) {
+            bounds.push_back ( lo + ( hi - lo ) * rat ( T ( i ), T ( threads ) ) );
+        }
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-struct _lcm<T, GCD, CHKOP, Alloc, true> {
-    T operator() ( const T& a, const T& b ) const;
-};
+        bounds.push_back ( hi );
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-T _lcm<T, GCD, CHKOP, Alloc, true>::operator() ( const T& a, const T& b ) const {
+        _parallel_run ( threads, [&n, &bounds, &parts, threads] ( unsigned int i ) {
 
-    typename tmp::_ifThenElse<tmp::_isClassT<T>::Yes, const T&, const T>::ResultT
-    x ( a < Rational<T, GCD, CHKOP, Alloc>::zero_ ? T ( -a ) : a ),
-      y ( b < Rational<T, GCD, CHKOP, Alloc>::zero_ ? T ( -b ) : b );
+            FareySequence<rat> f ( n, bounds[i], bounds[i + 1u] );
 
-    return typename Rational<T, GCD, CHKOP, Alloc>::op_multiplies()
-           ( ( typename Rational<T, GCD, CHKOP, Alloc>::op_divides() ( static_cast<T> ( x ),
-                   ( a != Rational<T, GCD, CHKOP, Alloc>::zero_ ? GCD<T, false,
-                     CHKOP, TYPE_CONVERT>() ( x, y ) : b ) ) ), static_cast<T> ( y ) );
-}
+            for ( rat r; f.next ( r ); ) {
+                if ( i + 1u == threads || r < bounds[i + 1u] ) parts[i].push_back ( r );
+            }
+        } );
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-struct _lcm<T, GCD, CHKOP, Alloc, false> {
+        for ( const std::vector<rat> &p : parts ) out = std::copy ( p.begin(), p.end(), out );
 
-    RATIONAL_CONSTEXPR T operator() ( const T& a, const T& b ) const {
-        return typename Rational<T, GCD, CHKOP, Alloc>::op_multiplies()
-               ( typename Rational<T, GCD, CHKOP, Alloc>::op_divides()
-                 ( a, ( a ? GCD<T, false, CHKOP, TYPE_CONVERT>() ( a, b ) : b ) ), b );
+        return out;
+    }
+#else
+    ( void ) threads;
+#endif
+
+    FareySequence<rat> f ( n, lo, hi );
+
+    for ( rat r; f.next ( r ); ) * ( out++ ) = r;
+
+    return out;
+}
+
+template<typename T>
+struct _bs_unit {
+    T operator() ( std::size_t ) const {
+        return T ( 1 );
     }
 };
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-struct _swapSign<T, GCD, CHKOP, Alloc, true> {
+template<class R, typename P, typename Q, typename A, typename B>
+void _binary_splitting ( std::size_t first, std::size_t last, P &p, Q &q, A &a, B &b,
+                         typename R::integer_type *m, unsigned int threads ) {
 
-    Rational<T, GCD, CHKOP, Alloc>& operator() ( Rational<T, GCD, CHKOP, Alloc>& r ) const {
+    typedef typename R::integer_type value_type;
 
-        if ( r.m_denom < zero_ ) {
-            r.m_numer =  -r.m_numer;
-            r.m_denom = -r.m_denom;
-        }
+    if ( last - first == 1u ) {
 
-        return r;
+        m[0] = value_type ( p ( first ) );
+        m[1] = value_type ( q ( first ) );
+        m[2] = value_type ( b ( first ) );
+        m[3] = typename R::op_multiplies() ( value_type ( a ( first ) ), m[0] );
+
+        return;
     }
 
-private:
-    const static T zero_;
-};
+    const std::size_t mid = first + ( last - first ) / 2u;
+    value_type l[4], r[4];
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-const T _swapSign<T, GCD, CHKOP, Alloc, true>::zero_ = T();
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    if ( threads > 1u ) {
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-struct _swapSign<T, GCD, CHKOP, Alloc, false> {
+        _fork_join ( [first, mid, &p, &q, &a, &b, &l, threads]() {
+            _binary_splitting<R> ( first, mid, p, q, a, b, l, threads / 2u );
+        }, [mid, last, &p, &q, &a, &b, &r, threads]() {
+            _binary_splitting<R> ( mid, last, p, q, a, b, r, threads - threads / 2u );
+        } );
 
-    RATIONAL_CONSTEXPR Rational<T, GCD, CHKOP, Alloc> &
-    operator() ( Rational<T, GCD, CHKOP, Alloc>& r ) const RATIONAL_NOEXCEPT {
-        return r;
+    } else
+#else
+    ( void ) threads;
+#endif
+    {
+        _binary_splitting<R> ( first, mid, p, q, a, b, l, 1u );
+        _binary_splitting<R> ( mid, last, p, q, a, b, r, 1u );
     }
-};
 
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc>
-struct _psq {
+    m[3] = typename R::op_plus() ( typename R::op_multiplies() (
+                                       typename R::op_multiplies() ( r[2], r[1] ), l[3] ),
+                                   typename R::op_multiplies() (
+                                       typename R::op_multiplies() ( l[2], l[0] ), r[3] ) );
 
-    Rational<T, GCD, CHKOP, Alloc> operator() ( const Rational<T, GCD, CHKOP, Alloc>& x,
-            const Rational<T, GCD, CHKOP, Alloc>& y ) const {
+    for ( int i = 0; i < 3; ++i ) m[i] = typename R::op_multiplies() ( l[i], r[i] );
+}
 
-        typename tmp::_ifThenElse<tmp::_isClassT<typename Rational<T, GCD,
-                 CHKOP, Alloc>::mod_type::first_type>::Yes,
-                 const typename Rational<T, GCD, CHKOP, Alloc>::mod_type::first_type&,
-                 const typename Rational<T, GCD, CHKOP, Alloc>::mod_type::first_type>::ResultT
-                 m ( x.mod().first );
+/**
+ * @ingroup main
+ * @brief Sums a hypergeometric-type series exactly by binary splitting
+ *
+ * Calculates the partial sum
+ * @f$ S = \sum_{n=first}^{last-1} \frac{a(n)}{b(n)} \prod_{k=first}^{n} \frac{p(k)}{q(k)} @f$.
+ *
+ * Instead of adding the terms one after another, which needs a gcd calculation per term and
+ * lets the operands grow with every addition, the products @f$ P, Q, B @f$ and the numerator
+ * @f$ T @f$ of @f$ S = \frac{T}{BQ} @f$ are calculated for both halves of the range
+ * recursively and combined by @f$ P = P_l P_r @f$, @f$ Q = Q_l Q_r @f$,
+ * @f$ B = B_l B_r @f$ and @f$ T = B_r Q_r T_l + B_l P_l T_r @f$. The fraction gets reduced only
+ * once at the end. This is efficient for big storage types, i.e. @c mpz_class.
+ *
+ * If @c threads is greater than @c 1 and C++11 is available, the subtrees are calculated in
+ * parallel, in which case the functors must be callable concurrently.
+ *
+ * @code
+ * struct one {
+ *     mpz_class operator() ( std::size_t ) const { return mpz_class ( 1 ); }
+ * };
+ *
+ * struct square {
+ *     mpz_class operator() ( std::size_t n ) const {
+ *         return mpz_class ( static_cast<unsigned long> ( n * n ) );
+ *     }
+ * };
+ *
+ * // the partial sum of 1/(n^2) for n = 1, ..., 100
+ * const Commons::Math::Rational<mpz_class, Commons::Math::GCD_gmp> zeta2 (
+ *     Commons::Math::binary_splitting<Commons::Math::Rational<mpz_class,
+ *     Commons::Math::GCD_gmp> > ( 1u, 101u, one(), one(), one(), square() ) );
+ * @endcode
+ *
+ * @tparam R the Commons::Math::Rational type of the result
+ * @tparam P functor returning the numerator of the term ratio for a @c std::size_t index
+ * @tparam Q functor returning the denominator of the term ratio for a @c std::size_t index
+ * @tparam A functor returning the numerator of the term coefficient for a @c std::size_t index
+ * @tparam B functor returning the denominator of the term coefficient for a @c std::size_t index
+ *
+ * @param[in] first the index of the first term
+ * @param[in] last the index after the last term
+ * @param[in] p the numerators of the term ratios
+ * @param[in] q the denominators of the term ratios
+ * @param[in] a the numerators of the term coefficients
+ * @param[in] b the denominators of the term coefficients
+ * @param[in] threads the maximum amount of threads to use
+ *
+ * @return the partial sum, or @c 0 if the range is empty
+ */
+template<class R, typename P, typename Q, typename A, typename B>
+R binary_splitting ( std::size_t first, std::size_t last, P p, Q q, A a, B b,
+                     unsigned int threads = 1u ) {
 
-        if ( std::not_equal_to<typename Rational<T, GCD, CHKOP, Alloc>::mod_type::first_type>()
-                ( m, typename Rational<T, GCD, CHKOP, Alloc>::mod_type::first_type() ) ) {
+    if ( last <= first ) return R();
 
-            const Rational<T, GCD, CHKOP, Alloc> psq ( m );
+    typename R::integer_type m[4];
 
-            return ( psq * psq ) == y ? psq : x;
-        }
+    _binary_splitting<R> ( first, last, p, q, a, b, m, threads ? threads : 1u );
 
-        return x;
-    }
-};
+    return R ( m[3], typename R::op_multiplies() ( m[2], m[1] ) );
+}
 
-#ifdef __EXCEPTIONS
-template<typename T>
-struct ENABLE_OVERFLOW_CHECK<std::plus<T>, T, true> {
+/**
+ * @ingroup main
+ * @brief Sums a hypergeometric series exactly by binary splitting
+ *
+ * Calculates the partial sum
+ * @f$ S = \sum_{n=first}^{last-1} \prod_{k=first}^{n} \frac{p(k)}{q(k)} @f$.
+ *
+ * @code
+ * // one as in binary_splitting(std::size_t, std::size_t, P, Q, A, B, unsigned int)
+ * struct index_or_one {
+ *     mpz_class operator() ( std::size_t n ) const {
+ *         return mpz_class ( static_cast<unsigned long> ( n ? n : 1u ) );
+ *     }
+ * };
+ *
+ * // e as the partial sum of 1/n! for n = 0, ..., 99
+ * const Commons::Math::Rational<mpz_class, Commons::Math::GCD_gmp> e (
+ *     Commons::Math::binary_splitting<Commons::Math::Rational<mpz_class,
+ *     Commons::Math::GCD_gmp> > ( 0u, 100u, one(), index_or_one() ) );
+ * @endcode
+ *
+ * @see binary_splitting(std::size_t, std::size_t, P, Q, A, B, unsigned int)
+ *
+ * @param[in] first the index of the first term
+ * @param[in] last the index after the last term
+ * @param[in] p the numerators of the term ratios
+ * @param[in] q the denominators of the term ratios
+ * @param[in] threads the maximum amount of threads to use
+ *
+ * @return the partial sum, or @c 0 if the range is empty
+ */
+template<class R, typename P, typename Q>
+R binary_splitting ( std::size_t first, std::size_t last, P p, Q q, unsigned int threads = 1u ) {
+    return binary_splitting<R> ( first, last, p, q, _bs_unit<typename R::integer_type>(),
+                                 _bs_unit<typename R::integer_type>(), threads );
+}
 
-    T operator() ( const T& x, const T& y ) const {
+template<class R, typename RAIter, class Op>
+R _reduce_tree ( RAIter first, RAIter last, Op op, unsigned int threads ) {
 
-        if ( ! ( ( ( y > T() ) && ( x > ( std::numeric_limits<T>::max() - y ) ) ) ||
-                 ( ( y < T() ) && ( x < ( std::numeric_limits<T>::min() - y ) ) ) ) ) {
+    // for built-in storage types the operands don't grow, thus only split for the threads
+    if ( last - first <= ( tmp::_isClassT<typename R::integer_type>::Yes ? 16 : 1024 ) ) {
 
-            return std::plus<T>() ( x, y );
-        }
+        R r ( *first );
 
-        throw std::domain_error ( "addition overflow" );
+        while ( ++first != last ) r = op ( r, *first );
+
+        return r;
     }
-};
-#endif
 
-#ifdef __EXCEPTIONS
-template<typename T>
-struct ENABLE_OVERFLOW_CHECK<std::minus<T>, T, true> {
+    const RAIter mid ( first + ( last - first ) / 2 );
 
-    T operator() ( const T& x, const T& y ) const {
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    if ( threads > 1u ) {
 
-        if ( ! ( ( y > T() && x < std::numeric_limits<T>::min() + y ) ||
-                 ( y < T() && x > std::numeric_limits<T>::max() + y ) ) ) {
+        R l, r;
 
-            return std::minus<T>() ( x, y );
-        }
+        _fork_join ( [first, mid, op, &l, threads]() {
+            l = _reduce_tree<R> ( first, mid, op, threads / 2u );
+        }, [mid, last, op, &r, threads]() {
+            r = _reduce_tree<R> ( mid, last, op, threads - threads / 2u );
+        } );
 
-        throw std::domain_error ( "subtraction overflow" );
+        return op ( l, r );
     }
-};
+#else
+    ( void ) threads;
 #endif
 
-#ifdef __EXCEPTIONS
-template<typename T>
-struct ENABLE_OVERFLOW_CHECK<std::negate<T>, T, true> {
+    return op ( _reduce_tree<R> ( first, mid, op, 1u ), _reduce_tree<R> ( mid, last, op, 1u ) );
+}
 
-    T operator() ( const T& x ) const {
+/**
+ * @ingroup main
+ * @brief Reduces a range of %Rationals by an associative operation in a balanced tree
+ *
+ * The range is split in halves recursively, and the results of the halves are combined by
+ * @c op. This way the operands of the big operations are of about the same size, which keeps
+ * the intermediate denominators small compared to a left fold. Since all %Rationals are
+ * reduced, the result of an exactly associative @c op, as addition and multiplication are, is
+ * the same as of @c std::accumulate().
+ *
+ * If @c threads is greater than @c 1 and C++11 is available, the subtrees are calculated in
+ * parallel, in which case @c op must be callable concurrently.
+ *
+ * @note for built-in storage types the intermediate results of a different grouping may
+ * overflow, where the ones of a left fold do not, and vice versa
+ *
+ * @see Commons::Math::parallel_sum()
+ * @see Commons::Math::parallel_product()
+ *
+ * @tparam RAIter a random access iterator
+ * @tparam Op the binary operation
+ *
+ * @param[in] first iterator pointing to the begin of the range
+ * @param[in] last iterator pointing to the end of the range
+ * @param[in] init the initial value
+ * @param[in] op the associative binary operation
+ * @param[in] threads the maximum amount of threads to use
+ *
+ * @return @c init combined with the reduction of the range, or @c init if the range is empty
+ */
+template<typename RAIter, class Op>
+typename std::iterator_traits<RAIter>::value_type
+parallel_reduce ( RAIter first, RAIter last,
+                  const typename std::iterator_traits<RAIter>::value_type& init, Op op,
+                  unsigned int threads = 1u ) {
 
-        if ( x != std::numeric_limits<T>::min() ) {
-            return std::negate<T>() ( x );
-        }
+    typedef typename std::iterator_traits<RAIter>::value_type rat;
 
-        throw std::domain_error ( "negation overflow" );
-    }
-};
-#endif
+    return first == last ? init : op ( init, _reduce_tree<rat> ( first, last, op,
+                                       threads ? threads : 1u ) );
+}
 
-#ifdef __EXCEPTIONS
-template<typename T>
-struct ENABLE_OVERFLOW_CHECK<std::multiplies<T>, T, true> {
-    T operator() ( const T& x, const T& y ) const;
-};
-#endif
+/**
+ * @ingroup main
+ * @brief Sums a range of %Rationals in a balanced tree
+ *
+ * @see Commons::Math::parallel_reduce()
+ *
+ * @tparam RAIter a random access iterator
+ *
+ * @param[in] first iterator pointing to the begin of the range
+ * @param[in] last iterator pointing to the end of the range
+ * @param[in] threads the maximum amount of threads to use
+ *
+ * @return the sum, or @c 0 if the range is empty
+ */
+template<typename RAIter>
+typename std::iterator_traits<RAIter>::value_type
+parallel_sum ( RAIter first, RAIter last, unsigned int threads = 1u ) {
 
-#ifdef __EXCEPTIONS
-template<typename T>
-T ENABLE_OVERFLOW_CHECK<std::multiplies<T>, T, true>::operator() ( const T& x, const T& y ) const {
+    typedef typename std::iterator_traits<RAIter>::value_type rat;
+
+    return first == last ? rat() : _reduce_tree<rat> ( first, last, std::plus<rat>(),
+            threads ? threads : 1u );
+}
+
+/**
+ * @ingroup main
+ * @brief Multiplies a range of %Rationals in a balanced tree
+ *
+ * @see Commons::Math::parallel_reduce()
+ *
+ * @tparam RAIter a random access iterator
+ *
+ * @param[in] first iterator pointing to the begin of the range
+ * @param[in] last iterator pointing to the end of the range
+ * @param[in] threads the maximum amount of threads to use
+ *
+ * @return the product, or @c 1 if the range is empty
+ */
+template<typename RAIter>
+typename std::iterator_traits<RAIter>::value_type
+parallel_product ( RAIter first, RAIter last, unsigned int threads = 1u ) {
+
+    typedef typename std::iterator_traits<RAIter>::value_type rat;
+
+    return first == last ? rat ( rat::one_, rat::one_ ) : _reduce_tree<rat> ( first, last,
+            std::multiplies<rat>(), threads ? threads : 1u );
+}
+
+inline const char *_eval_end ( const char *s ) {
+    return s ? s + std::strlen ( s ) : s;
+}
+
+inline const char *_eval_begin ( const char *s ) {
+    return s;
+}
+
+inline const char *_eval_begin ( const std::string& s ) {
+    return s.data();
+}
 
-    bool overflow = false;
+inline const char *_eval_end ( const std::string& s ) {
+    return s.data() + s.size();
+}
 
-    if ( x > T() ) {
-        if ( y > T() ) {
-            if ( x > ( std::numeric_limits<T>::max() / y ) ) {
-                overflow = true;
-            }
-        } else {
-            if ( y < ( std::numeric_limits<T>::min() / x ) ) {
-                overflow = true;
-            }
-        }
-    } else {
-        if ( y > T() ) {
-            if ( x < ( std::numeric_limits<T>::min() / y ) ) {
-                overflow = true;
-            }
-        } else {
-            if ( ( x != T() ) && ( y < ( std::numeric_limits<T>::max() / x ) ) ) {
-                overflow = true;
-            }
-        }
-    }
+template<class R, class IIter, class OIter, class EIter>
+OIter _eval_batch ( IIter first, IIter last, std::size_t index, OIter out, EIter& err ) {
 
-    if ( overflow ) throw std::domain_error ( "multiplication overflow" );
+    typename R::eval_state state;
+    R r;
 
-    return std::multiplies<T>() ( x, y );
-}
-#endif
+    for ( ; first != last; ++first, ++index ) {
+
+        const char *b = _eval_begin ( *first ), *e = _eval_end ( *first );
 
+        if ( from_chars ( b, e, r ) != e ) {
 #ifdef __EXCEPTIONS
-template<typename T>
-struct ENABLE_OVERFLOW_CHECK<std::divides<T>, T, true> {
-    T operator() ( const T& x, const T& y ) const;
-};
+            try {
 #endif
-
+                r = R::eval ( b, e, state );
 #ifdef __EXCEPTIONS
-template<typename T>
-T ENABLE_OVERFLOW_CHECK<std::divides<T>, T, true>::operator() ( const T& x, const T& y ) const {
+            } catch ( const std::exception &ex ) {
+                * ( err++ ) = std::make_pair ( index, std::string ( ex.what() ) );
+                r = R();
+            }
+#endif
+        }
 
-    if ( ! ( ( y == T() ) || ( ( x == std::numeric_limits<T>::min() ) && ( y == -1 ) ) ) ) {
-        return std::divides<T>() ( x, y );
+        * ( out++ ) = r;
     }
 
-    throw std::domain_error ( "division overflow" );
+    return out;
 }
-#endif
 
-#ifdef __EXCEPTIONS
-template<typename T>
-struct ENABLE_OVERFLOW_CHECK<std::modulus<T>, T, true> {
+/**
+ * @ingroup main
+ * @brief Evaluates a batch of expression strings
+ *
+ * Every string of the range is parsed as by Rational(const char *expr), where plain
+ * fractions are read by from_chars() without the expression parser. The parser's scratch
+ * state is reused for all strings.
+ *
+ * If the evaluation of a string fails, @c 0 is written to @c out and a
+ * @c std::pair<std::size_t, std::string> of the index of the string within the range and the
+ * error message is written to @c err. Thus an invalid string doesn't stop the batch. If
+ * exceptions are disabled, errors aren't detected.
+ *
+ * If @c threads is greater than @c 1 and C++11 is available, the range gets split into
+ * @c threads chunks, which are evaluated in parallel, each with its own scratch state, and
+ * written in order. In this case forward iterators are needed.
+ *
+ * @code
+ * const char *in[] = { "1/2 + 1/3", "3/4", "1/0", "(2+3" };
+ *
+ * std::vector<Commons::Math::Rational<long> > v;
+ * std::vector<std::pair<std::size_t, std::string> > e;
+ *
+ * // v: 5/6 3/4 0 0, e: (2, "division by zero in expression"), (3, "invalid expression")
+ * Commons::Math::eval_batch<Commons::Math::Rational<long> > ( in, in + 4,
+ *     std::back_inserter ( v ), std::back_inserter ( e ), 4u );@endcode
+ *
+ * @tparam R the Commons::Math::Rational type
+ * @tparam IIter input iterator over @c const @c char* or @c std::string
+ * @tparam OIter output iterator for @c R
+ * @tparam EIter output iterator for @c std::pair<std::size_t, std::string>
+ *
+ * @param[in] first iterator pointing to the first string
+ * @param[in] last iterator pointing past the last string
+ * @param[out] out iterator to output the values to
+ * @param[out] err iterator to output the errors to
+ * @param[in] threads the maximum amount of threads to use
+ *
+ * @return iterator pointing to the end of @c out
+ */
+template<class R, class IIter, class OIter, class EIter>
+OIter eval_batch ( IIter first, IIter last, OIter out, EIter err, unsigned int threads = 1u ) {
 
-    T operator() ( const T& x, const T& y ) const {
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    typedef std::pair<std::size_t, std::string> error;
 
-        if ( ! ( ( y == T() ) || ( ( x == std::numeric_limits<T>::min() ) && ( y == -1 ) ) ) ) {
-            return std::modulus<T>() ( x, y );
+    const std::size_t n = threads > 1u ? std::distance ( first, last ) : 0u;
+
+    if ( n > threads ) {
+
+        const std::size_t chunk = ( n + threads - 1u ) / threads;
+
+        std::vector<std::vector<R> > parts ( threads );
+        std::vector<std::vector<error> > failed ( threads );
+        std::vector<IIter> bounds ( 1u, first );
+
+        for ( std::size_t b = chunk; b < n; b += chunk ) {
+            std::advance ( first, chunk );
+            bounds.push_back ( first );
         }
 
-        throw std::domain_error ( "modulus overflow" );
-    }
-};
-#endif
+        bounds.push_back ( last );
 
-#ifdef __EXCEPTIONS
-template<typename T>
-struct ENABLE_OVERFLOW_CHECK<std::plus<T>, T, false> {
+        const unsigned int k = static_cast<unsigned int> ( bounds.size() - 1u );
 
-    T operator() ( const T& x, const T& y ) const {
+        _parallel_run ( k, [&parts, &failed, &bounds, chunk] ( unsigned int i ) {
 
-        if ( ! ( std::numeric_limits<T>::max() - x < y ) ) {
-            return std::plus<T>() ( x, y );
+            std::back_insert_iterator<std::vector<error> > e ( failed[i] );
+
+            parts[i].reserve ( chunk );
+            _eval_batch<R> ( bounds[i], bounds[i + 1u], i * chunk,
+                             std::back_inserter ( parts[i] ), e );
+        } );
+
+        for ( std::size_t i = 0u; i < threads; ++i ) {
+            out = std::copy ( parts[i].begin(), parts[i].end(), out );
+            err = std::copy ( failed[i].begin(), failed[i].end(), err );
         }
 
-        throw std::domain_error ( "unsigned addition wrap" );
+        return out;
     }
-};
+#else
+    ( void ) threads;
 #endif
 
-#ifdef __EXCEPTIONS
-template<typename T>
-struct ENABLE_OVERFLOW_CHECK<std::minus<T>, T, false> {
+    return _eval_batch<R> ( first, last, 0u, out, err );
+}
 
-    T operator() ( const T& x, const T& y ) const {
+/**
+ * @ingroup main
+ * @brief Writes a sequence of %Rationals in binary format to a stream
+ *
+ * The %Rationals are serialized into a buffer, which is written to the stream
+ * only if it is full, on flush() and on destruction.
+ *
+ * @see Commons::Math::serialize()
+ * @see Commons::Math::RationalBinaryReader
+ */
+class RationalBinaryWriter {
 
-        if ( ! ( x < y ) ) return std::minus<T>() ( x, y );
+    RATIONAL_NOCOPYASSIGN ( RationalBinaryWriter );
 
-        throw std::domain_error ( "unsigned subtraction wrap" );
+public:
+    /**
+     * @brief Constructs a writer on a stream
+     *
+     * @param[in] os the stream to write to, it should be opened in binary mode
+     * @param[in] bufsize the size of the buffer
+     */
+    explicit RationalBinaryWriter ( std::ostream& os, std::size_t bufsize = 1u << 16 )
+        : m_os ( os ), m_buf ( bufsize < 64u ? 64u : bufsize ), m_pos ( 0u ) {}
+
+    ~RationalBinaryWriter() {
+        flush();
     }
-};
-#endif
 
-template<typename T>
-struct ENABLE_OVERFLOW_CHECK<std::negate<T>, T, false> {
+    /**
+     * @brief appends @c r
+     *
+     * @param[in] r the %Rational to write
+     *
+     * @return the writer itself
+     */
+    template<typename T, template<typename, bool, template<class, typename, bool> class,
+             template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+             template<typename> class Alloc>
+    RationalBinaryWriter& write ( const Rational<T, GCD, CHKOP, Alloc>& r ) {
 
-#ifndef __EXCEPTIONS
-    T operator() ( const T& x ) const {
-        return std::negate<T>() ( x );
-#else
-    T operator() ( const T& ) const {
-        throw std::domain_error ( "unsigned negation wrap" );
-#endif
-    }
-};
+        unsigned char *e = serialize ( &m_buf[0] + m_pos, &m_buf[0] + m_buf.size(), r );
 
-#ifdef __EXCEPTIONS
-template<typename T>
-struct ENABLE_OVERFLOW_CHECK<std::multiplies<T>, T, false> {
+        if ( !e ) {
 
-    T operator() ( const T& x, const T& y ) const {
+            flush();
 
-        if ( y == T ( 0 ) || ! ( x > std::numeric_limits<T>::max() / y ) ) {
-            return std::multiplies<T>() ( x, y );
+            const std::size_t n = serialized_size ( r );
+
+            if ( n > m_buf.size() ) m_buf.resize ( n );
+
+            e = serialize ( &m_buf[0], &m_buf[0] + m_buf.size(), r );
         }
 
-        throw std::domain_error ( "unsigned multiplication wrap" );
+        m_pos = static_cast<std::size_t> ( e - &m_buf[0] );
+
+        return *this;
     }
-};
-#endif
 
-/**
- * @ingroup main
- * @brief Traits class to choose an appropriate Commons::Math::Rational
- */
-template<typename T>
-struct CFRationalTraits {
-    typedef Rational<T> rational_type;
+    /**
+     * @brief appends all %Rationals of @c [first, last)
+     *
+     * @tparam IIter input iterator type
+     *
+     * @param[in] first iterator pointing to the first %Rational
+     * @param[in] last iterator pointing past the last %Rational
+     *
+     * @return the writer itself
+     */
+    template<class IIter>
+    RationalBinaryWriter& write ( IIter first, IIter last ) {
+
+        while ( first != last ) write ( *first++ );
+
+        return *this;
+    }
+
+    /**
+     * @brief writes the buffered data to the stream
+     */
+    void flush() {
+
+        if ( m_pos ) m_os.write ( reinterpret_cast<const char *> ( &m_buf[0] ),
+                                      static_cast<std::streamsize> ( m_pos ) );
+
+        m_pos = 0u;
+    }
+
+private:
+    std::ostream& m_os;
+    std::vector<unsigned char> m_buf;
+    std::size_t m_pos;
 };
 
 /**
  * @ingroup main
- * @brief Constructs a Rational of a given continued fraction sequence
- *
- * @see Commons::Math::CFRationalTraits
+ * @brief Reads a sequence of %Rationals in binary format from a stream
  *
- * @tparam IIter an input iterator
+ * If the stream ends within a %Rational or contains garbage, the @c failbit is set.
  *
- * @param[in] first iterator pointing to the begin of the sequence
- * @param[in] last iterator pointing to the end of the sequence
+ * @see Commons::Math::deserialize()
+ * @see Commons::Math::RationalBinaryWriter
  *
- * @return the Commons::Math::Rational representing the sequence
+ * @tparam R the Commons::Math::Rational type to read
  */
-template<typename IIter>
-typename CFRationalTraits<typename std::iterator_traits<IIter>::value_type>::rational_type
-cf ( IIter first, IIter last ) {
+template<class R>
+class RationalBinaryReader {
 
-    typedef typename std::iterator_traits<IIter>::value_type value_type;
-    typedef typename CFRationalTraits<typename
-    std::iterator_traits<IIter>::value_type>::rational_type rat;
+    RATIONAL_NOCOPYASSIGN ( RationalBinaryReader );
 
-    value_type m[2][2] = {
-        { value_type(), value_type ( 1 ) },
-        { value_type ( 1 ), value_type() }
-    };
+public:
+    typedef R value_type; ///< the type of the records
+    typedef _reader_iterator<RationalBinaryReader> iterator; ///< input iterator over the records
 
-    value_type n ( m[0][0] ), d ( m[0][1] );
+    /**
+     * @brief Constructs a reader on a stream
+     *
+     * @param[in] is the stream to read from, it should be opened in binary mode
+     * @param[in] bufsize the initial size of the buffer
+     */
+    explicit RationalBinaryReader ( std::istream& is, std::size_t bufsize = 1u << 16 )
+        : m_is ( is ), m_buf ( bufsize < 64u ? 64u : bufsize ), m_pos ( 0u ), m_end ( 0u ) {}
 
-    while ( first != last ) {
+    /**
+     * @brief reads the next %Rational
+     *
+     * @param[out] r the %Rational to assign to
+     *
+     * @return @c false if there are no more %Rationals
+     */
+    bool next ( R& r ) {
 
-        n = typename rat::op_plus() (
-                typename rat::op_multiplies() ( *first, m[0][1] ), m[0][0] );
+        for ( ;; ) {
 
-        m[0][0] = RATIONAL_MOVE ( m[0][1] );
-        m[0][1] = n;
+            bool more = false;
+            const unsigned char *e = deserialize ( &m_buf[0] + m_pos, &m_buf[0] + m_end, r,
+                                                   &more );
 
-        d = typename rat::op_plus() (
-                typename rat::op_multiplies() ( *first++, m[1][1] ), m[1][0] );
+            if ( e ) {
+                m_pos = static_cast<std::size_t> ( e - &m_buf[0] );
+                return true;
+            }
 
-        m[1][0] = RATIONAL_MOVE ( m[1][1] );
-        m[1][1] = d;
+            // garbage won't get valid by reading further
+            if ( !more ) {
+                m_is.setstate ( std::ios_base::failbit );
+                return false;
+            }
+
+            if ( !fill() ) return false;
+        }
     }
 
-    return rat ( n, d );
-}
+    /**
+     * @brief reads the first %Rational and returns an iterator pointing to it
+     */
+    iterator begin() {
+        return iterator ( this );
+    }
 
-/**
- * @ingroup main
- * @brief Extracts a continued fraction sequence of a Rational
- *
- * @see Commons::Math::Rational::mod()
- *
- * @tparam OIter an output iterator
- *
- * @param[in] r the Commons::Math::Rational to extract the continued fraction sequence from
- * @param[out] out iterator to ouput the sequence to
- *
- * @return iterator pointing to the end of @c out
- */
-template<typename T, template<typename, bool, template<class, typename, bool> class,
-         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
-         template<typename> class Alloc, typename OIter>
-OIter seq ( const Rational<T, GCD, CHKOP, Alloc>& r, OIter out ) {
+    /**
+     * @brief returns the end iterator
+     */
+    iterator end() const {
+        return iterator();
+    }
 
-    typedef Rational<T, GCD, CHKOP, Alloc> rat;
+private:
+    bool fill() {
 
-    rat h ( r );
+        if ( m_pos ) {
+            std::copy ( m_buf.begin() + static_cast<std::ptrdiff_t> ( m_pos ),
+                        m_buf.begin() + static_cast<std::ptrdiff_t> ( m_end ), m_buf.begin() );
+            m_end -= m_pos;
+            m_pos = 0u;
+        }
 
-    typename rat::mod_type mt;
+        if ( m_end == m_buf.size() ) m_buf.resize ( m_buf.size() << 1 );
 
-    do {
+        const std::streamsize n = m_is.rdbuf()->sgetn ( reinterpret_cast<char *>
+                                  ( &m_buf[0] + m_end ),
+                                  static_cast<std::streamsize> ( m_buf.size() - m_end ) );
 
-        mt = RATIONAL_MOVE ( h.mod() );
-        * ( out++ ) = RATIONAL_MOVE ( mt.first );
+        if ( n <= 0 ) {
+            m_is.setstate ( m_end ? std::ios_base::eofbit | std::ios_base::failbit :
+                            std::ios_base::eofbit );
+            return false;
+        }
 
-    } while ( std::not_equal_to<T>() ( mt.second.numerator(), T() ) &&
-              ( h = RATIONAL_MOVE ( mt.second.invert() ), true ) );
+        m_end += static_cast<std::size_t> ( n );
 
-    return out;
-}
+        return true;
+    }
+
+    std::istream& m_is;
+    std::vector<unsigned char> m_buf;
+    std::size_t m_pos;
+    std::size_t m_end;
+};
 
 }
 
@@ -3630,6 +6718,58 @@ modf ( const Commons::Math::Rational<T, GCD, CHKOP, Alloc>& __x,
     return tmp.second;
 }
 
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+/**
+ * @ingroup main
+ * @brief Specialization of @c std::hash for @c %Rational types
+ *
+ * Hashes numerator and denominator directly by Commons::Math::HashTraits. As all %Rationals
+ * are reduced, equal %Rationals have equal hashes, regardless of their GCD algorithm and
+ * checked operator.
+ *
+ * @b Example: @code{.cpp}
+ * std::unordered_map<Commons::Math::Rational<long>, std::string> names;
+ *
+ * names[Commons::Math::Rational<long> ( 1, 2 )] = "half";@endcode
+ *
+ * @tparam T the storage type
+ * @tparam GCD the GCD algorithm
+ * @tparam CHKOP checked operator @see ENABLE_OVERFLOW_CHECK
+ * @tparam Alloc the allocator
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+struct hash<Commons::Math::Rational<T, GCD, CHKOP, Alloc> > {
+
+    typedef Commons::Math::Rational<T, GCD, CHKOP, Alloc> argument_type; ///< the %Rational
+    typedef std::size_t result_type; ///< the hash
+
+    /**
+     * @brief hashes a %Rational
+     *
+     * @param[in] r the %Rational
+     */
+    result_type operator() ( const argument_type& r ) const {
+        return Commons::Math::_rational_hash ( r );
+    }
+};
+
+// fractions of GCD_null aren't reduced, so reduce them to hash equal values equally
+template<typename T, template<class, typename, bool> class CHKOP, template<typename> class Alloc>
+struct hash<Commons::Math::Rational<T, Commons::Math::GCD_null, CHKOP, Alloc> > {
+
+    typedef Commons::Math::Rational<T, Commons::Math::GCD_null, CHKOP, Alloc> argument_type;
+    typedef std::size_t result_type;
+
+    result_type operator() ( const argument_type& r ) const {
+        return Commons::Math::_rational_hash ( Commons::Math::Rational<T,
+                                               Commons::Math::GCD_euclid_fast, CHKOP,
+                                               Alloc> ( r.numerator(), r.denominator() ) );
+    }
+};
+#endif
+
 }
 
 /**
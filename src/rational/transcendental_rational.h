@@ -0,0 +1,456 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * @author Heiko Schäfer <heiko@rangun.de>
+ * @copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * @defgroup transcendental Transcendental functions
+ *
+ * The header `transcendental_rational.h` approximates @c exp, @c log, @c sin, @c cos and
+ * @c atan of a %Rational argument by a %Rational within a given error bound.
+ *
+ * The argument is reduced to a small interval, where the Taylor series is summed by
+ * Commons::Math::binary_splitting() in exact integer arithmetic. The amount of terms is
+ * derived from a bound of the remainder of the series, so the result is not limited by the
+ * precision of any floating point type. At last the simplest fraction within the remaining
+ * error bound is returned.
+ *
+ * @b Example: @code{.cpp}
+ * typedef Commons::Math::Rational<mpz_class, Commons::Math::GCD_gmp> rat;
+ *
+ * // e within 10^-100
+ * const rat e ( Commons::Math::exp ( rat ( 1, 1 ), rat ( mpz_class ( 1 ),
+ *               Commons::Math::RadixPowerTraits<mpz_class>::pow ( 10, 100u ) ) ) );@endcode
+ *
+ * For built-in storage types the error bound must be coarse enough for the intermediate
+ * results to fit, otherwise they will overflow.
+ */
+
+#ifndef COMMONS_MATH_TRANSCENDENTAL_RATIONAL_H
+#define COMMONS_MATH_TRANSCENDENTAL_RATIONAL_H
+
+#include <cstdlib>
+
+#include "rational.h"
+
+namespace Commons {
+
+namespace Math {
+
+template<class R>
+struct _series_p {
+
+    typedef typename R::integer_type integer_type;
+
+    _series_p ( const integer_type& p0, const integer_type& p ) : m_p0 ( p0 ), m_p ( p ) {}
+
+    integer_type operator() ( std::size_t k ) const {
+        return k ? m_p : m_p0;
+    }
+
+private:
+    integer_type m_p0;
+    integer_type m_p;
+};
+
+template<class R>
+struct _series_q {
+
+    typedef typename R::integer_type integer_type;
+
+    enum KIND { ATAN, EXP, SIN, COS };
+
+    _series_q ( const integer_type& q0, const integer_type& q, KIND kind ) : m_q0 ( q0 ),
+        m_q ( q ), m_kind ( kind ) {}
+
+    integer_type operator() ( std::size_t k ) const {
+
+        if ( !k ) return m_q0;
+
+        const unsigned long n = static_cast<unsigned long> ( k );
+        const typename R::op_multiplies mul = typename R::op_multiplies();
+
+        switch ( m_kind ) {
+        case EXP:
+            return mul ( m_q, integer_type ( n ) );
+        case SIN:
+            return mul ( m_q, mul ( integer_type ( 2u * n ), integer_type ( 2u * n + 1u ) ) );
+        case COS:
+            return mul ( m_q, mul ( integer_type ( 2u * n - 1u ), integer_type ( 2u * n ) ) );
+        default:
+            return m_q;
+        }
+    }
+
+private:
+    integer_type m_q0;
+    integer_type m_q;
+    KIND m_kind;
+};
+
+template<class R>
+struct _series_odd {
+    typename R::integer_type operator() ( std::size_t k ) const {
+        return typename R::integer_type ( 2u * static_cast<unsigned long> ( k ) + 1u );
+    }
+};
+
+// the smallest n with n! >= c/eps
+template<class R>
+std::size_t _factorial_terms ( const R& eps, const typename R::integer_type& c ) {
+
+    typedef typename R::integer_type integer_type;
+
+    const typename R::op_multiplies mul = typename R::op_multiplies();
+    const integer_type l ( mul ( c, eps.denominator() ) );
+    integer_type f ( 1 );
+    std::size_t n = 0u;
+
+    while ( mul ( f, eps.numerator() ) < l ) {
+        f = mul ( f, integer_type ( static_cast<unsigned long> ( ++n ) ) );
+    }
+
+    return n;
+}
+
+// the smallest n with base^n >= 1/eps
+template<class R>
+std::size_t _geometric_terms ( const R& eps, long base ) {
+
+    typedef typename R::integer_type integer_type;
+
+    const typename R::op_multiplies mul = typename R::op_multiplies();
+    const integer_type b ( base );
+    integer_type f ( 1 );
+    std::size_t n = 0u;
+
+    for ( ; mul ( f, eps.numerator() ) < eps.denominator(); ++n ) f = mul ( f, b );
+
+    return n;
+}
+
+// atan(z) (or atanh(z) if hyperbolic) for |z| <= 1/sqrt(base) within eps
+template<class R>
+R _atan_series ( const R& z, const R& eps, long base, bool hyperbolic = false ) {
+
+    typedef typename R::integer_type integer_type;
+
+    const typename R::op_multiplies mul = typename R::op_multiplies();
+    const integer_type n2 ( mul ( z.numerator(), z.numerator() ) );
+
+    return binary_splitting<R> ( 0u, _geometric_terms ( eps, base ),
+                                 _series_p<R> ( z.numerator(), hyperbolic ? n2 :
+                                         typename R::op_minus() ( integer_type(), n2 ) ),
+                                 _series_q<R> ( z.denominator(),
+                                         mul ( z.denominator(), z.denominator() ),
+                                         _series_q<R>::ATAN ),
+                                 _bs_unit<integer_type>(), _series_odd<R>() );
+}
+
+// the simplest fraction within eps of pi by Machin's formula
+template<class R>
+R _pi ( const R& eps ) {
+
+    const R e ( eps * R ( 1, 8 ) ), h ( eps * R ( 1, 2 ) ),
+          p ( R ( 16, 1 ) * _atan_series ( R ( 1, 5 ), e, 25l ) -
+              R ( 4, 1 ) * _atan_series ( R ( 1, 239 ), e, 57121l ) );
+
+    return simplest ( p - h, p + h );
+}
+
+template<class R>
+R _sincos_series ( const R& y, const R& eps, bool sine ) {
+
+    typedef typename R::integer_type integer_type;
+
+    const typename R::op_multiplies mul = typename R::op_multiplies();
+    const integer_type n2 ( typename R::op_minus() ( integer_type(),
+                            mul ( y.numerator(), y.numerator() ) ) ),
+                            d2 ( mul ( y.denominator(), y.denominator() ) );
+
+    // the series are alternating and |y| < 1, so the remainder is less than 1/(2N)!
+    const std::size_t n = _factorial_terms ( eps, integer_type ( 1 ) ) / 2u + 1u;
+
+    return sine ? binary_splitting<R> ( 0u, n, _series_p<R> ( y.numerator(), n2 ),
+                                        _series_q<R> ( y.denominator(), d2,
+                                                _series_q<R>::SIN ) ) :
+           binary_splitting<R> ( 0u, n, _series_p<R> ( integer_type ( 1 ), n2 ),
+                                 _series_q<R> ( integer_type ( 1 ), d2, _series_q<R>::COS ) );
+}
+
+template<class R>
+R _sincos ( const R& x, const R& eps, bool sine ) {
+
+    typedef typename R::integer_type integer_type;
+
+#ifdef __EXCEPTIONS
+    if ( !( R() < eps ) ) throw std::domain_error ( "error bound must be positive" );
+#endif
+
+    const R a ( x.abs() ), tau ( eps * R ( 1, 8 ) );
+
+    // x = k pi/2 + y, where k <= 2x/3 + 1 and pi/2 is calculated within tau/k
+    const integer_type kb ( ( a * R ( 2, 3 ) ).mod().first + integer_type ( 2 ) );
+    const R p ( _pi ( tau * R ( integer_type ( 2 ), kb ) ) * R ( 1, 2 ) );
+    const integer_type k ( ( a / p + R ( 1, 2 ) ).mod().first );
+    const R y ( a - R ( k, integer_type ( 1 ) ) * p );
+    const R z ( simplest ( y - tau, y + tau ) );
+
+    const integer_type q ( typename R::op_modulus() ( k, integer_type ( 4 ) ) );
+    const bool odd = std::not_equal_to<integer_type>() ( typename R::op_modulus() (
+                         q, integer_type ( 2 ) ), integer_type() );
+
+    R r ( _sincos_series ( z, tau, sine != odd ) );
+
+    // sin(y + pi/2) = cos(y), cos(y + pi/2) = -sin(y), both negated for y + pi
+    if ( ( sine ? integer_type ( 1 ) < q : ( odd ? q < integer_type ( 3 ) : !(
+                     q < integer_type ( 2 ) ) ) ) != ( sine && x < R() ) ) r = -r;
+
+    const R h ( eps * R ( 1, 2 ) );
+
+    return simplest ( r - h, r + h );
+}
+
+/**
+ * @ingroup transcendental
+ * @brief Approximates @f$ e^x @f$ within an error bound
+ *
+ * The argument gets halved until @f$ |y| = |\frac{x}{2^s}| \leq 1 @f$, the series
+ * @f$ \sum \frac{y^n}{n!} @f$ is summed and squared @f$ s @f$ times to get @f$ e^x @f$.
+ * After each squaring the result is rounded to the simplest fraction within a relative error
+ * bound, which is derived from @c eps and an upper bound of @f$ e^x @f$, so the size of the
+ * operands is limited by the precision needed instead of doubling with each squaring.
+ *
+ * @param[in] x the argument
+ * @param[in] eps the error bound @f$ > 0 @f$
+ *
+ * @return the simplest %Rational @c r with @f$ |r - e^x| < eps @f$
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc> exp ( const Rational<T, GCD, CHKOP, Alloc>& x,
+                                     const Rational<T, GCD, CHKOP, Alloc>& eps ) {
+
+    typedef Rational<T, GCD, CHKOP, Alloc> rat;
+    typedef typename rat::integer_type integer_type;
+
+#ifdef __EXCEPTIONS
+    if ( !( rat() < eps ) ) throw std::domain_error ( "error bound must be positive" );
+#endif
+
+    const typename rat::op_multiplies mul = typename rat::op_multiplies();
+    const rat one ( 1, 1 ), h ( eps * rat ( 1, 2 ) );
+    const bool neg = x < rat();
+
+    // 10/7 < log2(e) < 13/9, so e^x <= 2^(n + 1) for x >= 0 and e^x <= 2^-n otherwise
+    integer_type n ( ( x.abs() * ( neg ? rat ( 10, 7 ) : rat ( 13, 9 ) ) ).mod().first ),
+                 p ( neg ? 1 : 2 );
+
+    for ( ; integer_type() < n; n = typename rat::op_minus() ( n, integer_type ( 1 ) ) ) {
+        p = mul ( p, integer_type ( 2 ) );
+    }
+
+    const rat b ( neg ? rat ( integer_type ( 1 ), p ) : rat ( p, integer_type ( 1 ) ) );
+
+    // e^x < eps/2, so 0 is within eps
+    if ( b < h ) return rat();
+
+    rat y ( x );
+    std::size_t s = 0u;
+    integer_type m ( 1 );
+
+    for ( ; one < y.abs(); ++s ) {
+        y *= rat ( 1, 2 );
+        m = mul ( m, integer_type ( 2 ) );
+    }
+
+    // the series and each rounding contribute a relative error of at most rho, the s squarings
+    // raise that to less than 4m rho, i.e. an absolute error of less than eps/4
+    const rat rho ( eps / ( b * rat ( mul ( integer_type ( 16 ), m ), integer_type ( 1 ) ) ) ),
+          tau ( rho * rat ( 1, 8 ) );
+
+    // another tau for keeping the operands small
+    y = simplest ( std::max ( y - tau, -one ), std::min ( y + tau, one ) );
+
+    const integer_type yn ( y.numerator() ), yd ( y.denominator() );
+
+    rat r ( binary_splitting<rat> ( 0u, _factorial_terms ( tau, integer_type ( 2 ) ),
+                                    _series_p<rat> ( integer_type ( 1 ), yn ),
+                                    _series_q<rat> ( integer_type ( 1 ), yd,
+                                            _series_q<rat>::EXP ) ) );
+
+    while ( s-- ) {
+        r *= r;
+        const rat d ( r * rho );
+        r = simplest ( r - d, r + d );
+    }
+
+    return simplest ( r - h, r + h );
+}
+
+/**
+ * @ingroup transcendental
+ * @brief Approximates @f$ \log x @f$ within an error bound
+ *
+ * The argument gets written as @f$ x = 2^k m @f$ with @f$ \frac{2}{3} \leq m \leq
+ * \frac{4}{3} @f$ and @f$ \log x = 2k \operatorname{atanh} \frac{1}{3} +
+ * 2 \operatorname{atanh} \frac{m - 1}{m + 1} @f$ is summed.
+ *
+ * If exceptions are enabled, a @c std::domain_error is thrown if @f$ x \leq 0 @f$.
+ *
+ * @param[in] x the argument
+ * @param[in] eps the error bound @f$ > 0 @f$
+ *
+ * @return the simplest %Rational @c r with @f$ |r - \log x| < eps @f$
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc> log ( const Rational<T, GCD, CHKOP, Alloc>& x,
+                                     const Rational<T, GCD, CHKOP, Alloc>& eps ) {
+
+    typedef Rational<T, GCD, CHKOP, Alloc> rat;
+    typedef typename rat::integer_type integer_type;
+
+#ifdef __EXCEPTIONS
+    if ( !( rat() < x ) ) throw std::domain_error ( "log is undefined for x <= 0" );
+    if ( !( rat() < eps ) ) throw std::domain_error ( "error bound must be positive" );
+#endif
+
+    const std::size_t dn = RadixPowerTraits<integer_type>::digits ( x.numerator(), 2 ),
+                      dd = RadixPowerTraits<integer_type>::digits ( x.denominator(), 2 );
+
+    // 2^(dn - dd - 1) < x < 2^(dn - dd + 1)
+    long k = static_cast<long> ( dn ) - static_cast<long> ( dd );
+
+    rat m ( dn < dd ? x * rat ( RadixPowerTraits<integer_type>::pow ( 2, dd - dn ),
+                                integer_type ( 1 ) ) :
+            x * rat ( integer_type ( 1 ), RadixPowerTraits<integer_type>::pow ( 2, dn - dd ) ) );
+
+    for ( ; rat ( 4, 3 ) < m; ++k ) m *= rat ( 1, 2 );
+    for ( ; m < rat ( 2, 3 ); --k ) m *= rat ( 2, 1 );
+
+    const rat tau ( eps * rat ( integer_type ( 1 ),
+                                integer_type ( 16 ) * integer_type ( std::labs ( k ) + 1l ) ) );
+
+    // log is 3/2-Lipschitz for m >= 2/3
+    m = simplest ( m - tau, m + tau );
+
+    rat r ( _atan_series ( ( m - rat ( 1, 1 ) ) / ( m + rat ( 1, 1 ) ), tau, 9l, true ) );
+
+    if ( k ) r += rat ( integer_type ( k ), integer_type ( 1 ) ) *
+                      _atan_series ( rat ( 1, 3 ), tau, 9l, true );
+
+    r *= rat ( 2, 1 );
+
+    const rat h ( eps * rat ( 1, 2 ) );
+
+    return simplest ( r - h, r + h );
+}
+
+/**
+ * @ingroup transcendental
+ * @brief Approximates @f$ \sin x @f$ within an error bound
+ *
+ * The argument gets reduced to @f$ |y| \leq \frac{\pi}{4} @f$ by subtracting a multiple
+ * of @f$ \frac{\pi}{2} @f$, which is calculated as precise as needed for the size of @c x.
+ *
+ * @param[in] x the argument
+ * @param[in] eps the error bound @f$ > 0 @f$
+ *
+ * @return the simplest %Rational @c r with @f$ |r - \sin x| < eps @f$
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc> sin ( const Rational<T, GCD, CHKOP, Alloc>& x,
+                                     const Rational<T, GCD, CHKOP, Alloc>& eps ) {
+    return _sincos ( x, eps, true );
+}
+
+/**
+ * @ingroup transcendental
+ * @brief Approximates @f$ \cos x @f$ within an error bound
+ *
+ * @see sin()
+ *
+ * @param[in] x the argument
+ * @param[in] eps the error bound @f$ > 0 @f$
+ *
+ * @return the simplest %Rational @c r with @f$ |r - \cos x| < eps @f$
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc> cos ( const Rational<T, GCD, CHKOP, Alloc>& x,
+                                     const Rational<T, GCD, CHKOP, Alloc>& eps ) {
+    return _sincos ( x, eps, false );
+}
+
+/**
+ * @ingroup transcendental
+ * @brief Approximates @f$ \arctan x @f$ within an error bound
+ *
+ * The argument gets reduced by @f$ \arctan x = \frac{\pi}{2} - \arctan \frac{1}{x} @f$ to
+ * @f$ |x| \leq 1 @f$ and further by @f$ \arctan x = \arctan \frac{1}{2} +
+ * \arctan \frac{2x - 1}{x + 2} @f$ to @f$ |y| \leq \frac{1}{3} @f$.
+ *
+ * @param[in] x the argument
+ * @param[in] eps the error bound @f$ > 0 @f$
+ *
+ * @return the simplest %Rational @c r with @f$ |r - \arctan x| < eps @f$
+ */
+template<typename T, template<typename, bool, template<class, typename, bool> class,
+         template<typename> class> class GCD, template<class, typename, bool> class CHKOP,
+         template<typename> class Alloc>
+Rational<T, GCD, CHKOP, Alloc> atan ( const Rational<T, GCD, CHKOP, Alloc>& x,
+                                      const Rational<T, GCD, CHKOP, Alloc>& eps ) {
+
+    typedef Rational<T, GCD, CHKOP, Alloc> rat;
+
+#ifdef __EXCEPTIONS
+    if ( !( rat() < eps ) ) throw std::domain_error ( "error bound must be positive" );
+#endif
+
+    const rat one ( 1, 1 ), tau ( eps * rat ( 1, 8 ) ), y ( simplest ( x - tau, x + tau ) );
+    const bool inv = one < y.abs();
+    const rat a ( inv ? y.abs().inverse() : y.abs() );
+
+    rat r ( rat ( 1, 3 ) < a ? _atan_series ( rat ( 1, 2 ), tau, 4l ) +
+            _atan_series ( ( a * rat ( 2, 1 ) - one ) / ( a + rat ( 2, 1 ) ), tau, 9l ) :
+            _atan_series ( a, tau, 9l ) );
+
+    if ( inv ) r = _pi ( tau * rat ( 2, 1 ) ) * rat ( 1, 2 ) - r;
+    if ( y < rat() ) r = -r;
+
+    const rat h ( eps * rat ( 1, 2 ) );
+
+    return simplest ( r - h, r + h );
+}
+
+}
+
+}
+
+#endif /* COMMONS_MATH_TRANSCENDENTAL_RATIONAL_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
@@ -0,0 +1,206 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <numeric>
+
+#include "atomictest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION ( AtomicTest );
+
+using namespace Commons::Math;
+
+namespace {
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+// adds the values on the given amount of threads, each taking every threads-th value
+template<class A, class R>
+void accumulate ( A &a, const std::vector<R> &v, unsigned int threads ) {
+
+    std::vector<std::thread> pool;
+
+    for ( unsigned int t = 0u; t < threads; ++t ) {
+        pool.emplace_back ( [&a, &v, t, threads]() {
+            for ( std::size_t i = t; i < v.size(); i += threads ) a.add ( v[i] );
+        } );
+    }
+
+    for ( std::thread &t : pool ) t.join();
+}
+#endif
+
+}
+
+void AtomicTest::testAtomic() {
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+
+    typedef AtomicRational<int32_t> atomic_rational;
+    typedef atomic_rational::rational_type rat;
+
+    atomic_rational a, b ( rat ( 6, 8 ) );
+
+    CPPUNIT_ASSERT ( a.is_lock_free() );
+    CPPUNIT_ASSERT_EQUAL ( rat(), a.load() );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 3, 4 ), b.load() );
+
+    a.store ( rat ( 1, 2 ) );
+
+    CPPUNIT_ASSERT_EQUAL ( rat ( 1, 2 ), a.fetch_add ( rat ( 1, 3 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 5, 6 ), a.fetch_sub ( rat ( 1, 2 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 1, 3 ), a.fetch_mul ( rat ( 9, 4 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 3, 4 ), a.fetch_div ( rat ( -3, 2 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( -1, 2 ), a.load() );
+
+    CPPUNIT_ASSERT_EQUAL ( rat ( 1, 4 ), a += rat ( 3, 4 ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( -1, 12 ), a -= rat ( 1, 3 ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( -1, 3 ), a *= rat ( 4 ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 1, 2 ), a /= rat ( -2, 3 ) );
+
+    CPPUNIT_ASSERT_EQUAL ( rat ( 1, 2 ), a.exchange ( rat ( 2, 3 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 7, 5 ), a = rat ( 7, 5 ) );
+
+    rat e ( 2, 3 );
+
+    CPPUNIT_ASSERT ( !a.compare_exchange_strong ( e, rat ( 1 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 7, 5 ), e );
+    CPPUNIT_ASSERT ( a.compare_exchange_strong ( e, rat ( 1 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 1 ), a.load ( std::memory_order_acquire ) );
+
+    e = rat ( 1 );
+
+    while ( !a.compare_exchange_weak ( e, e + rat ( 1, 7 ), std::memory_order_acq_rel ) );
+
+    CPPUNIT_ASSERT_EQUAL ( rat ( 8, 7 ), a.load() );
+
+    // compared by value, not by how the expected value was built
+    e = rat ( 16, 14 );
+
+    CPPUNIT_ASSERT ( a.compare_exchange_strong ( e, rat ( -8, 7 ), std::memory_order_release ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( -8, 7 ), a.load() );
+
+#ifdef __EXCEPTIONS
+    AtomicRational<int8_t, GCD_euclid, ENABLE_OVERFLOW_CHECK> o ( Rational<int8_t, GCD_euclid,
+            ENABLE_OVERFLOW_CHECK> ( 127, 2 ) );
+
+    CPPUNIT_ASSERT_THROW ( o.fetch_mul ( 3 ), std::domain_error );
+    CPPUNIT_ASSERT_THROW ( a.fetch_div ( rat() ), std::domain_error );
+    CPPUNIT_ASSERT_EQUAL ( 127, static_cast<int> ( o.load().numerator() ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( -8, 7 ), a.load() );
+#endif
+#endif
+}
+
+void AtomicTest::testConcurrent() {
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+
+    typedef AtomicRational<int32_t> atomic_rational;
+    typedef atomic_rational::rational_type rat;
+
+    const int n = 20000;
+
+    atomic_rational s, p ( rat ( 5, 7 ) ), c;
+    std::vector<std::thread> pool;
+
+    for ( int t = 0; t < 4; ++t ) {
+
+        pool.emplace_back ( [&s, &p, &c, t]() {
+
+            const rat x ( 1, t + 2 ), f ( t & 1 ? rat ( 2, 3 ) : rat ( 3, 2 ) );
+
+            for ( int i = 0; i < n; ++i ) {
+
+                s.fetch_add ( x );
+
+                // bounded by 1, so never overflows
+                p.fetch_mul ( f );
+                p.fetch_div ( f );
+
+                rat e ( c.load ( std::memory_order_relaxed ) );
+
+                while ( !c.compare_exchange_weak ( e, e + rat ( 1, 4 ) ) );
+            }
+        } );
+    }
+
+    for ( std::thread &t : pool ) t.join();
+
+    CPPUNIT_ASSERT_EQUAL ( rat ( 77 * n, 60 ), s.load() );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 5, 7 ), p.load() );
+    CPPUNIT_ASSERT_EQUAL ( rat ( n ), c.load() );
+#endif
+}
+
+void AtomicTest::testAccumulator() {
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+
+    typedef ShardedRationalAccumulator<long> accumulator;
+    typedef accumulator::rational_type rat;
+
+    std::vector<rat> v;
+
+    for ( long i = 1; i <= 5000; ++i ) v.push_back ( rat ( i % 13 - 6, i % 8 + 1 ) );
+
+    const rat &s ( std::accumulate ( v.begin(), v.end(), rat() ) );
+
+    accumulator a ( 3u ), z ( 0u );
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 3u ), a.shards() );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 1u ), z.shards() );
+    CPPUNIT_ASSERT_EQUAL ( rat(), a.value() );
+
+    accumulate ( a, v, 5u );
+
+    CPPUNIT_ASSERT_EQUAL ( s, a.value() );
+
+    ( z += rat ( 1, 2 ) ) += rat ( 1, 3 );
+
+    CPPUNIT_ASSERT_EQUAL ( rat ( 5, 6 ), z.value() );
+
+    a.clear();
+    a.add ( rat ( -3, 4 ) );
+
+    CPPUNIT_ASSERT_EQUAL ( rat ( -3, 4 ), a.value() );
+#endif
+}
+
+void AtomicTest::testAccumulator_gmp() {
+#if defined(HAVE_GMPXX_H) && (defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L)
+
+    typedef ShardedRationalAccumulator<mpz_class, GCD_gmp> accumulator;
+
+    std::vector<gmp_rational> v;
+
+    // runs of equal denominators and mixed ones
+    for ( long i = 1; i <= 3000; ++i ) {
+        v.push_back ( gmp_rational ( i % 17 - 8, i < 1000 ? 60 : i % 23 + 1 ) );
+    }
+
+    const gmp_rational &s ( std::accumulate ( v.begin(), v.end(), gmp_rational() ) );
+
+    accumulator a ( 4u ), b ( 1u );
+
+    accumulate ( a, v, 4u );
+    accumulate ( b, v, 1u );
+
+    CPPUNIT_ASSERT_EQUAL ( s, a.value() );
+    CPPUNIT_ASSERT_EQUAL ( s, b.value() );
+#endif
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ATOMICTESTCASE_H
+#define ATOMICTESTCASE_H
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+#define RATIONAL_OVERRIDE override
+#define RATIONAL_FINAL final
+#else
+#define RATIONAL_OVERRIDE
+#define RATIONAL_FINAL
+#endif
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifdef HAVE_GMPXX_H
+#include "gmp_rational.h"
+#endif
+
+#include "atomic_rational.h"
+
+#pragma GCC diagnostic ignored "-Winline"
+#pragma GCC diagnostic ignored "-Weffc++"
+#pragma GCC diagnostic push
+class AtomicTest RATIONAL_FINAL : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE ( AtomicTest );
+    CPPUNIT_TEST ( testAtomic );
+    CPPUNIT_TEST ( testConcurrent );
+    CPPUNIT_TEST ( testAccumulator );
+    CPPUNIT_TEST ( testAccumulator_gmp );
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void testAtomic();
+    void testConcurrent();
+    void testAccumulator();
+    void testAccumulator_gmp();
+};
+#pragma GCC diagnostic pop
+
+#endif /* ATOMICTESTCASE_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
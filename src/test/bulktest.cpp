@@ -0,0 +1,124 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+
+#include "bulktest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION ( BulkTest );
+
+using namespace Commons::Math;
+
+BulkTest::BulkTest() : CppUnit::TestFixture() {}
+
+void BulkTest::setUp() {
+
+    std::strcpy ( m_path, "/tmp/bulktestXXXXXX" );
+
+    const int fd = mkstemp ( m_path );
+
+    CPPUNIT_ASSERT ( fd != -1 );
+
+    close ( fd );
+}
+
+void BulkTest::tearDown() {
+    unlink ( m_path );
+}
+
+void BulkTest::testBulkParse() {
+
+    const std::string txt ( "1/2\n  -3/4 \r\n\n(1 + 1) / 3\n42\n0.25" );
+
+    std::vector<long_rational> v;
+
+    bulk_parse ( txt.data(), txt.data() + txt.size(), v );
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 5u ), v.size() );
+    CPPUNIT_ASSERT_EQUAL ( long_rational ( 1, 2 ), v[0] );
+    CPPUNIT_ASSERT_EQUAL ( long_rational ( -3, 4 ), v[1] );
+    CPPUNIT_ASSERT_EQUAL ( long_rational ( 2, 3 ), v[2] );
+    CPPUNIT_ASSERT_EQUAL ( long_rational ( 42, 1 ), v[3] );
+    CPPUNIT_ASSERT_EQUAL ( long_rational ( 1, 4 ), v[4] );
+
+    std::vector<long> n, d;
+
+    bulk_parse_columns<long_rational> ( txt.data(), txt.data() + txt.size(), n, d );
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 5u ), n.size() );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 5u ), d.size() );
+    CPPUNIT_ASSERT_EQUAL ( -3L, n[1] );
+    CPPUNIT_ASSERT_EQUAL ( 4L, d[1] );
+
+#ifdef __EXCEPTIONS
+    const std::string bad ( "1/2\nfoo\n" );
+
+    CPPUNIT_ASSERT_THROW ( bulk_parse ( bad.data(), bad.data() + bad.size(), v ),
+                           std::runtime_error );
+#endif
+}
+
+void BulkTest::testBulkReadWrite() {
+
+    std::vector<long_rational> v, w;
+
+    for ( long i = 1; i <= 20000; ++i ) v.push_back ( long_rational ( ( i % 7 ) - 3, i ) );
+
+    {
+        RationalWriter out ( m_path, 256u );
+        out.write ( v.begin(), v.end() );
+    }
+
+    bulk_read ( m_path, w, 4u );
+
+    CPPUNIT_ASSERT ( v == w );
+
+    std::vector<long> n, d;
+
+    bulk_read_columns<long_rational> ( m_path, n, d, 3u );
+
+    CPPUNIT_ASSERT_EQUAL ( v.size(), n.size() );
+
+    for ( std::size_t i = 0u; i < v.size(); ++i ) {
+        CPPUNIT_ASSERT_EQUAL ( v[i].numerator(), n[i] );
+        CPPUNIT_ASSERT_EQUAL ( v[i].denominator(), d[i] );
+    }
+
+#ifdef __EXCEPTIONS
+    CPPUNIT_ASSERT_THROW ( bulk_read ( "/nonexistent/bulktest", w ), std::runtime_error );
+#endif
+}
+
+void BulkTest::testBulkReadWrite_gmp() {
+#ifdef HAVE_GMPXX_H
+
+    std::vector<gmp_rational> v, w;
+
+    gmp_rational r ( 1, 3 );
+
+    for ( int i = 0; i < 200; ++i, r *= gmp_rational ( -7, 5 ) ) v.push_back ( r );
+
+    bulk_write ( m_path, v.begin(), v.end() );
+    bulk_read ( m_path, w, 2u );
+
+    CPPUNIT_ASSERT ( v == w );
+#endif
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BULKTESTCASE_H
+#define BULKTESTCASE_H
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+#define RATIONAL_OVERRIDE override
+#define RATIONAL_FINAL final
+#else
+#define RATIONAL_OVERRIDE
+#define RATIONAL_FINAL
+#endif
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "bulk_rational.h"
+
+#ifdef HAVE_GMPXX_H
+#include "gmp_rational.h"
+#endif
+
+#pragma GCC diagnostic ignored "-Winline"
+#pragma GCC diagnostic ignored "-Weffc++"
+#pragma GCC diagnostic push
+class BulkTest RATIONAL_FINAL : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE ( BulkTest );
+    CPPUNIT_TEST ( testBulkParse );
+    CPPUNIT_TEST ( testBulkReadWrite );
+    CPPUNIT_TEST ( testBulkReadWrite_gmp );
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    typedef Commons::Math::Rational<long> long_rational;
+
+    BulkTest();
+
+    void setUp() RATIONAL_OVERRIDE;
+    void tearDown() RATIONAL_OVERRIDE;
+
+    void testBulkParse();
+    void testBulkReadWrite();
+    void testBulkReadWrite_gmp();
+
+private:
+    char m_path[32];
+};
+#pragma GCC diagnostic pop
+
+#endif /* BULKTESTCASE_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
@@ -23,6 +23,28 @@ CPPUNIT_TEST_SUITE_REGISTRATION ( ExprTest );
 
 using namespace Commons::Math;
 
+#ifdef HAVE_GMPXX_H
+namespace {
+
+std::size_t gmp_allocs = 0u;
+
+void *(*gmp_alloc) ( std::size_t );
+void *(*gmp_realloc) ( void *, std::size_t, std::size_t );
+void (*gmp_free) ( void *, std::size_t );
+
+void *count_alloc ( std::size_t n ) {
+    ++gmp_allocs;
+    return gmp_alloc ( n );
+}
+
+void *count_realloc ( void *p, std::size_t o, std::size_t n ) {
+    ++gmp_allocs;
+    return gmp_realloc ( p, o, n );
+}
+
+}
+#endif
+
 ExprTest::ExprTest() : CppUnit::TestFixture() {}
 
 void ExprTest::setUp() {}
@@ -478,4 +500,259 @@ void ExprTest::testIntegrate() {
 #endif
 }
 
+void ExprTest::testPlaceholders() {
+
+    typedef RationalPlaceholders<long_rational> P;
+
+    const long_rational h ( 1, 2 ), t ( 1, 3 );
+
+    std::vector<long_rational> x, y, z, r, s;
+
+    for ( long i = 1; i <= 100; ++i ) {
+        x.push_back ( long_rational ( i, 3 ) );
+        y.push_back ( long_rational ( -i, 7 ) );
+        z.push_back ( long_rational ( 1, i ) );
+    }
+
+    evaluate ( h * P::_1 + t * P::_2, std::back_inserter ( r ),
+               x.begin(), x.end(), y.begin() );
+
+    CPPUNIT_ASSERT_EQUAL ( x.size(), r.size() );
+
+    for ( std::size_t i = 0u; i < r.size(); ++i ) {
+        CPPUNIT_ASSERT_EQUAL ( h * x[i] + t * y[i], r[i] );
+    }
+
+    evaluate ( h * P::_1 + t * P::_2, std::back_inserter ( s ),
+               x.begin(), x.end(), y.begin(), 4 );
+
+    CPPUNIT_ASSERT ( r == s );
+
+    r.clear();
+    s.clear();
+
+    evaluate ( ( P::_1 - P::_2 ) * P::_3 / ( 1 + P::_1 * P::_1 ), std::back_inserter ( r ),
+               x.begin(), x.end(), y.begin(), z.begin() );
+    evaluate ( ( P::_1 - P::_2 ) * P::_3 / ( 1 + P::_1 * P::_1 ), std::back_inserter ( s ),
+               x.begin(), x.end(), y.begin(), z.begin(), 3 );
+
+    CPPUNIT_ASSERT_EQUAL ( x.size(), r.size() );
+    CPPUNIT_ASSERT ( r == s );
+
+    for ( std::size_t i = 0u; i < r.size(); ++i ) {
+        CPPUNIT_ASSERT_EQUAL ( ( x[i] - y[i] ) * z[i] / ( 1 + x[i] * x[i] ), r[i] );
+    }
+
+    r.clear();
+    s.clear();
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    const auto &v
+#else
+    const RationalExpressionTraits<long_rational>::variable_type &v
+#endif
+    ( mk_rat_proto_var ( long_rational() ) );
+
+    evaluate ( v * v + P::_1, std::back_inserter ( r ), z.begin(), z.end() );
+    evaluate ( v * v + P::_1, std::back_inserter ( s ), z.begin(), z.end(), 2 );
+
+    CPPUNIT_ASSERT ( r == s );
+
+    for ( std::size_t i = 0u; i < r.size(); ++i ) {
+        CPPUNIT_ASSERT_EQUAL ( eval_rat_expr ( v * v + v, z[i] ), r[i] );
+    }
+
+    r.clear();
+    s.clear();
+
+    // a column of integers gets converted row by row
+    std::vector<long> l;
+
+    for ( long i = 1; i <= 100; ++i ) l.push_back ( i * 7 - 350 );
+
+    evaluate ( P::_1 * P::_2 + P::_1, std::back_inserter ( r ), l.begin(), l.end(), x.begin() );
+    evaluate ( P::_1 * P::_2 + P::_1, std::back_inserter ( s ), l.begin(), l.end(), x.begin(),
+               3 );
+
+    CPPUNIT_ASSERT_EQUAL ( l.size(), r.size() );
+    CPPUNIT_ASSERT ( r == s );
+
+    for ( std::size_t i = 0u; i < r.size(); ++i ) {
+        CPPUNIT_ASSERT_EQUAL ( long_rational ( l[i], 1 ) * x[i] + long_rational ( l[i], 1 ), r[i] );
+    }
+}
+
+void ExprTest::testChains() {
+
+    typedef RationalPlaceholders<long_rational> P;
+
+    const long_rational a ( 1, 6 ), b ( -3, 4 ), c ( 5, 6 ), d ( 7, 10 );
+    long_rational v[4] = { a, b, c, d };
+
+    std::vector<long_rational> r;
+
+    evaluate ( P::_1 + P::_2 + P::_3 + P::_4, std::back_inserter ( r ), v, v + 1, v + 1, v + 2,
+               v + 3 );
+    evaluate ( P::_1 - P::_2 + ( P::_3 - P::_4 ), std::back_inserter ( r ), v, v + 1, v + 1,
+               v + 2, v + 3 );
+    evaluate ( P::_1 - ( P::_2 - P::_3 - P::_4 ) + long_rational ( 1, 6 ), std::back_inserter ( r ),
+               v, v + 1, v + 1, v + 2, v + 3 );
+    evaluate ( P::_1 * P::_2 * P::_3 * P::_4, std::back_inserter ( r ), v, v + 1, v + 1, v + 2,
+               v + 3 );
+    evaluate ( 2 * P::_1 * ( P::_2 * P::_3 + P::_4 + P::_1 ) * P::_4, std::back_inserter ( r ),
+               v, v + 1, v + 1, v + 2, v + 3 );
+    evaluate ( P::_1 - P::_1 + P::_2 - P::_2, std::back_inserter ( r ), v, v + 1, v + 1, v + 2,
+               v + 3 );
+
+    CPPUNIT_ASSERT_EQUAL ( a + b + c + d, r[0] );
+    CPPUNIT_ASSERT_EQUAL ( a - b + ( c - d ), r[1] );
+    CPPUNIT_ASSERT_EQUAL ( a - ( b - c - d ) + long_rational ( 1, 6 ), r[2] );
+    CPPUNIT_ASSERT_EQUAL ( a * b * c * d, r[3] );
+    CPPUNIT_ASSERT_EQUAL ( 2 * a * ( b * c + d + a ) * d, r[4] );
+    CPPUNIT_ASSERT_EQUAL ( long_rational(), r[5] );
+
+    // the unreduced products would overflow long
+    const long_rational e ( 3000017, 1999993 ), f ( 1999993, 3000017 );
+    const long_rational w[2] = { e, f };
+
+    r.clear();
+    evaluate ( P::_1 * P::_2 * P::_1 * P::_2 * P::_1, std::back_inserter ( r ), w, w + 1,
+               w + 1 );
+
+    CPPUNIT_ASSERT_EQUAL ( e, r[0] );
+
+#ifdef __EXCEPTIONS
+    typedef Rational<long, GCD_euclid_fast, ENABLE_OVERFLOW_CHECK> chk_rational;
+    typedef RationalPlaceholders<chk_rational> C;
+
+    const chk_rational ce ( 3000017, 1999993 ), cf ( 1999993, 3000017 );
+    std::vector<chk_rational> cr;
+
+    CPPUNIT_ASSERT_NO_THROW ( evaluate ( C::_1 * C::_2 * C::_1 * C::_2 * C::_1,
+                                         std::back_inserter ( cr ), &ce, &ce + 1, &cf ) );
+    CPPUNIT_ASSERT_EQUAL ( ce, cr[0] );
+#endif
+
+#ifdef HAVE_GMPXX_H
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    const auto &x
+#else
+    const RationalExpressionTraits<gmp_rational>::variable_type &x
+#endif
+    ( mk_rat_proto_var ( gmp_rational() ) );
+
+    const gmp_rational y ( 3, 7 );
+
+    CPPUNIT_ASSERT_EQUAL ( y + y * y + y * y * y + y * y * y * y - 1,
+                           eval_rat_expr ( x + x * x + x * x * x + x * x * x * x - 1, y ) );
+    CPPUNIT_ASSERT_EQUAL ( y - gmp_rational ( 1, 5 ) + y * y - gmp_rational ( 1, 9 ),
+                           eval_rat_expr ( x - gmp_rational ( 1, 5 ) + x * x -
+                                   gmp_rational ( 1, 9 ), y ) );
+#endif
+}
+
+void ExprTest::testRewrites() {
+
+    typedef RationalPlaceholders<long_rational> P;
+
+    const long_rational a ( 3, 4 ), b ( -5, 6 );
+
+    const RationalExpressionTraits<long_rational>::expr_type
+    &l ( mk_rat_lit ( a ) * mk_rat_lit ( b ) - a / mk_rat_lit ( b ) + inv ( -mk_rat_lit ( a ) ) );
+
+    CPPUNIT_ASSERT_EQUAL ( a * b - a / b + ( -a ).inverse(), eval_rat_expr ( l ) );
+    CPPUNIT_ASSERT_EQUAL ( long_rational ( 1, 6 ), eval_rat_expr ( abs ( mk_rat_lit ( b ) ) %
+                           mk_rat_lit ( long_rational ( 1, 3 ) ) ) );
+    CPPUNIT_ASSERT_EQUAL ( long_rational ( 3, 2 ),
+                           eval_rat_expr ( sqrt ( mk_rat_lit ( long_rational ( 9, 4 ) ) ) ) );
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    const auto &x
+#else
+    const RationalExpressionTraits<long_rational>::variable_type &x
+#endif
+    ( mk_rat_proto_var ( long_rational() ) );
+
+    const long_rational v[] = { long_rational ( 3, 4 ), long_rational ( -5, 6 ),
+                                long_rational ( 7 ), long_rational ( -1, 9 ), long_rational()
+                              };
+
+    std::vector<long_rational> sq, tw;
+
+    evaluate ( P::_1 * P::_1, std::back_inserter ( sq ), v, v + 5 );
+    evaluate ( P::_2 + P::_2, std::back_inserter ( tw ), v, v + 5, v );
+
+    for ( std::size_t i = 0u; i < 5u; ++i ) {
+
+        CPPUNIT_ASSERT_EQUAL ( v[i] * v[i], eval_rat_expr ( x * x, v[i] ) );
+        CPPUNIT_ASSERT_EQUAL ( v[i] + v[i], eval_rat_expr ( x + x, v[i] ) );
+        CPPUNIT_ASSERT_EQUAL ( v[i] * v[i] + v[i] + v[i],
+                               eval_rat_expr ( x * x + ( x + x ), v[i] ) );
+        CPPUNIT_ASSERT_EQUAL ( v[i] * v[i], sq[i] );
+        CPPUNIT_ASSERT_EQUAL ( v[i] + v[i], tw[i] );
+        CPPUNIT_ASSERT_EQUAL ( v[i] + 1, eval_rat_expr ( inv ( inv ( x + 1 ) ), v[i] ) );
+    }
+
+    CPPUNIT_ASSERT_EQUAL ( long_rational(), eval_rat_expr ( inv ( inv ( x ) ), long_rational() ) );
+}
+
+void ExprTest::testReferences() {
+#ifdef HAVE_GMPXX_H
+
+    const gmp_rational a ( 3, 4 ), b ( -5, 6 ), c ( 7, 8 ), d ( 1, 9 ), y ( 2, 3 );
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    const auto &x
+#else
+    const RationalExpressionTraits<gmp_rational>::variable_type &x
+#endif
+    ( mk_rat_proto_var ( gmp_rational() ) );
+
+    const gmp_rational &r ( a * y * y + b * y - c / ( y + d ) );
+
+    mp_get_memory_functions ( &gmp_alloc, &gmp_realloc, &gmp_free );
+    mp_set_memory_functions ( count_alloc, count_realloc, gmp_free );
+
+    gmp_allocs = 0u;
+
+    {
+        // lvalue operands are referenced, not copied
+        const gmp_rational &e ( eval_rat_expr ( a * x * x + b * x - c / ( x + d ), y ) );
+        CPPUNIT_ASSERT_EQUAL ( r, e );
+    }
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+
+    gmp_allocs = 0u;
+
+    {
+        const auto e = a * x * x + b * x - c / ( x + d );
+        CPPUNIT_ASSERT_EQUAL ( std::size_t ( 0u ), gmp_allocs );
+
+        // temporary subexpressions are moved into the stored expression
+        const auto f = ( a * x ) * x + ( b * x - c / ( x + d ) );
+        CPPUNIT_ASSERT_EQUAL ( std::size_t ( 0u ), gmp_allocs );
+
+        CPPUNIT_ASSERT_EQUAL ( r, eval_rat_expr ( e, y ) );
+        CPPUNIT_ASSERT_EQUAL ( r, eval_rat_expr ( f, y ) );
+    }
+
+    gmp_allocs = 0u;
+
+    {
+        gmp_rational t ( 7, 8 );
+        const std::size_t t_allocs = gmp_allocs;
+
+        // temporary operands are moved, not copied
+        const auto e = a * x * x + b * x - std::move ( t ) / ( x + d );
+        CPPUNIT_ASSERT_EQUAL ( t_allocs, gmp_allocs );
+        CPPUNIT_ASSERT_EQUAL ( r, eval_rat_expr ( e, y ) );
+    }
+#endif
+
+    mp_set_memory_functions ( gmp_alloc, gmp_realloc, gmp_free );
+#endif
+}
+
 // kate: indent-mode cstyle; indent-width 4; replace-tabs on;
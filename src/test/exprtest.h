@@ -48,6 +48,10 @@ class ExprTest RATIONAL_FINAL : public CppUnit::TestFixture {
     CPPUNIT_TEST ( testExpression );
     CPPUNIT_TEST ( testExpression_gmp );
     CPPUNIT_TEST ( testIntegrate );
+    CPPUNIT_TEST ( testPlaceholders );
+    CPPUNIT_TEST ( testChains );
+    CPPUNIT_TEST ( testRewrites );
+    CPPUNIT_TEST ( testReferences );
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -62,6 +66,10 @@ public:
     void testExpression();
     void testExpression_gmp();
     void testIntegrate();
+    void testPlaceholders();
+    void testChains();
+    void testRewrites();
+    void testReferences();
 
 private:
 #ifdef HAVE_GMPXX_H
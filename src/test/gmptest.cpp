@@ -19,6 +19,10 @@
 
 #include <numeric>
 
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+#include <unordered_set>
+#endif
+
 #include "gmptest.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION ( GMPTest );
@@ -45,6 +49,59 @@ private:
 };
 #endif
 
+struct _bs_one {
+    mpz_class operator() ( std::size_t ) const {
+        return mpz_class ( 1 );
+    }
+};
+
+struct _bs_index {
+    mpz_class operator() ( std::size_t n ) const {
+        return mpz_class ( static_cast<unsigned long> ( n ? n : 1u ) );
+    }
+};
+
+struct _bs_square {
+    mpz_class operator() ( std::size_t n ) const {
+        return mpz_class ( static_cast<unsigned long> ( n * n ) );
+    }
+};
+
+struct _bs_odd {
+    mpz_class operator() ( std::size_t n ) const {
+        return mpz_class ( static_cast<unsigned long> ( 2u * n + 1u ) );
+    }
+};
+
+// fails for indices beyond 100
+struct _bs_limited {
+    mpz_class operator() ( std::size_t n ) const {
+
+        if ( n > 100u ) throw std::out_of_range ( "index beyond 100" );
+
+        return mpz_class ( static_cast<unsigned long> ( n ? n : 1u ) );
+    }
+};
+
+// the term ratios of atan(1/x)
+struct _bs_atan_p {
+    mpz_class operator() ( std::size_t n ) const {
+        return mpz_class ( n ? -1 : 1 );
+    }
+};
+
+struct _bs_atan_q {
+
+    explicit _bs_atan_q ( unsigned long x ) : m_x ( x ) {}
+
+    mpz_class operator() ( std::size_t n ) const {
+        return mpz_class ( n ? m_x * m_x : m_x );
+    }
+
+private:
+    unsigned long m_x;
+};
+
 GMPTest::GMPTest() : CppUnit::TestFixture(), m_sqrt2(), m_twosqrt(), m_onethird(),
     m_oneseventh() {}
 
@@ -504,8 +561,264 @@ void GMPTest::testIOStreamOps() {
 
 }
 
+void GMPTest::testToChars() {
+
+    const gmp_rational a ( mpz_class ( "-1208925819614629174706176" ), mpz_class ( 3 ) );
+
+    std::vector<char> buf ( formatted_size ( a, true ) );
+    char *e = to_chars ( &buf[0], &buf[0] + buf.size(), a, true );
+
+    CPPUNIT_ASSERT ( e != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "-402975273204876391568725 1/3" ),
+                           std::string ( &buf[0], e ) );
+
+    e = to_chars ( &buf[0], &buf[0] + buf.size(), a );
+
+    CPPUNIT_ASSERT ( e != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "-1208925819614629174706176/3" ),
+                           std::string ( &buf[0], e ) );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "-1208925819614629174706176/3" ), a.str() );
+    CPPUNIT_ASSERT ( to_chars ( &buf[0], &buf[0] + 8, a ) == 0L );
+
+    // no terminating NUL gets written
+    const char *const v[] = { "0", "9", "99", "-10", "1000", "-999", "1208925819614629174706176" };
+
+    for ( std::size_t i = 0u; i < sizeof ( v ) / sizeof ( v[0] ); ++i ) {
+
+        const gmp_rational x ( ( mpz_class ( v[i] ) ) );
+
+        std::vector<char> c ( formatted_size ( x ), '#' );
+
+        e = to_chars ( &c[0], &c[0] + c.size(), x );
+
+        CPPUNIT_ASSERT_EQUAL ( std::string ( v[i] ), std::string ( &c[0], e ) );
+        CPPUNIT_ASSERT_EQUAL ( std::string ( static_cast<std::size_t> ( &c[0] + c.size() - e ),
+                                             '#' ), std::string ( e, &c[0] + c.size() ) );
+    }
+}
+
+void GMPTest::testRadix() {
+
+    const gmp_rational a ( mpz_class ( "-1208925819614629174706176" ), mpz_class ( 3 ) );
+
+    std::vector<char> buf ( formatted_size ( a, 62, true ) );
+    char *e = to_chars ( &buf[0], &buf[0] + buf.size(), a, 62, true );
+
+    CPPUNIT_ASSERT ( e != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "-20u4wMXIiVBrxV 1/3" ), std::string ( &buf[0], e ) );
+
+    buf.resize ( formatted_size ( a, 2 ) );
+    e = to_chars ( &buf[0], &buf[0] + buf.size(), a, 2 );
+
+    CPPUNIT_ASSERT ( e != 0L );
+    CPPUNIT_ASSERT_EQUAL ( "-1" + std::string ( 80u, '0' ) + "/11", std::string ( &buf[0], e ) );
+
+    // the chunked expansion has to match the digit by digit expansion
+    const gmp_rational b ( mpz_class ( "-340282366920938463463374607431768211457" ),
+                           mpz_class ( "18446744073709551629" ) );
+
+    for ( int base = 2; base <= 62; base += 15 ) {
+
+        const std::size_t n = 1000u;
+
+        std::vector<char> x ( n ), y ( n ), z ( n );
+
+        CPPUNIT_ASSERT ( RadixExpandTraits<mpz_class>::expand ( &x[0], &x[0] + n,
+                         mpz_class ( 11080585 ), mpz_class ( 78256779 ), base, n ) ==
+                         &x[0] + n );
+        CPPUNIT_ASSERT ( RadixExpandTraits<long>::expand ( &y[0], &y[0] + n, 11080585L,
+                         78256779L, base, n ) == &y[0] + n );
+        CPPUNIT_ASSERT ( x == y );
+
+        // the digit by digit expansion takes its fast path for unbounded types as well
+        CPPUNIT_ASSERT ( _radix_expand<mpz_class>::expand ( &z[0], &z[0] + n,
+                         mpz_class ( 11080585 ), mpz_class ( 78256779 ), base, n ) ==
+                         &z[0] + n );
+        CPPUNIT_ASSERT ( x == z );
+    }
+
+    CPPUNIT_ASSERT ( to_chars ( &buf[0], &buf[0] + buf.size(), a, 63 ) == 0L );
+    CPPUNIT_ASSERT ( to_chars ( &buf[0], &buf[0] + buf.size(), a, 1 ) == 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 0u ), formatted_size ( a, 0 ) );
+    CPPUNIT_ASSERT ( RadixExpandTraits<mpz_class>::expand ( &buf[0], &buf[0] + buf.size(),
+                     mpz_class ( 1 ), mpz_class ( 3 ), 0, 4u ) == 0L );
+
+    buf.resize ( fixed_size ( b, 200u ) );
+    e = to_chars_fixed ( &buf[0], &buf[0] + buf.size(), b, 200u );
+
+    CPPUNIT_ASSERT ( e != 0L );
+
+    const std::string s ( &buf[0], e );
+
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "-18446744073709551603.00000000000000000921" ),
+                           s.substr ( 0u, 42u ) );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 222u ), s.size() );
+    CPPUNIT_ASSERT ( to_chars_fixed ( &buf[0], &buf[0] + 30u, b, 200u ) == 0L );
+}
+
+void GMPTest::testRationalDigits() {
+
+    // a reptend far too long to be calculated as a whole
+    const gmp_rational a ( mpz_class ( 1 ), mpz_class ( "2305843009213693951" ) * 40 );
+
+    RationalDigits<gmp_rational> d ( a, 10, 200u );
+
+    CPPUNIT_ASSERT_EQUAL ( 0l, d.whole().get_si() );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 3 ), d.period_start() );
+    CPPUNIT_ASSERT ( !d.terminating() );
+
+    std::string s ( "0." );
+
+    for ( RationalDigits<gmp_rational>::iterator i ( d.begin() ); i != d.end(); ++i ) {
+        s.push_back ( static_cast<char> ( '0' + *i ) );
+    }
+
+    std::vector<char> buf ( fixed_size ( a, 200u ) );
+
+    CPPUNIT_ASSERT_EQUAL ( std::string ( &buf[0], to_chars_fixed ( &buf[0],
+                                         &buf[0] + buf.size(), a, 200u ) ), s );
+}
+
+void GMPTest::testBinarySplitting() {
+
+    gmp_rational e, z, a;
+    mpz_class f ( 1 ), x ( 5 );
+
+    for ( unsigned long n = 0u; n < 60u; ++n ) {
+        if ( n ) f *= n;
+        e += gmp_rational ( mpz_class ( 1 ), f );
+    }
+
+    for ( unsigned long n = 1u; n < 60u; ++n ) z += gmp_rational ( 1ul, n * n );
+
+    for ( unsigned long n = 0u; n < 40u; ++n, x *= 25 ) {
+        a += gmp_rational ( mpz_class ( n % 2u ? -1 : 1 ), x * ( 2u * n + 1u ) );
+    }
+
+    for ( unsigned int t = 1u; t <= 4u; t *= 4u ) {
+
+        CPPUNIT_ASSERT_EQUAL ( e, binary_splitting<gmp_rational> ( 0u, 60u, _bs_one(),
+                               _bs_index(), t ) );
+        CPPUNIT_ASSERT_EQUAL ( z, binary_splitting<gmp_rational> ( 1u, 60u, _bs_one(), _bs_one(),
+                               _bs_one(), _bs_square(), t ) );
+        CPPUNIT_ASSERT_EQUAL ( a, binary_splitting<gmp_rational> ( 0u, 40u, _bs_atan_p(),
+                               _bs_atan_q ( 5u ), _bs_one(), _bs_odd(), t ) );
+    }
+
+    // Machin's formula
+    const gmp_rational pi ( gmp_rational ( 16, 1 ) * binary_splitting<gmp_rational> ( 0u, 100u,
+                            _bs_atan_p(), _bs_atan_q ( 5u ), _bs_one(), _bs_odd(), 2u ) -
+                            gmp_rational ( 4, 1 ) * binary_splitting<gmp_rational> ( 0u, 30u,
+                                    _bs_atan_p(), _bs_atan_q ( 239u ), _bs_one(), _bs_odd() ) );
+
+    std::vector<char> buf ( fixed_size ( pi, 50u ) );
+
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "3.14159265358979323846264338327950288419716939937510" ),
+                           std::string ( &buf[0], to_chars_fixed ( &buf[0], &buf[0] + buf.size(),
+                                         pi, 50u ) ) );
+
+    CPPUNIT_ASSERT_EQUAL ( gmp_rational(), binary_splitting<gmp_rational> ( 3u, 3u, _bs_one(),
+                           _bs_index() ) );
+
+#ifdef __EXCEPTIONS
+    // the failing terms are calculated on the calling thread
+    CPPUNIT_ASSERT_THROW ( binary_splitting<gmp_rational> ( 0u, 128u, _bs_one(), _bs_limited(),
+                           2u ), std::out_of_range );
+#endif
+}
+
+void GMPTest::testParallelReduce() {
+
+    std::vector<gmp_rational> v;
+
+    for ( unsigned long i = 1u; i <= 3000u; ++i ) {
+        v.push_back ( gmp_rational ( mpz_class ( i % 2u ? 1 : -1 ) * ( i * i ), i * i + 1u ) );
+    }
+
+    const gmp_rational &s ( std::accumulate ( v.begin(), v.end(), gmp_rational() ) );
+    const gmp_rational &p ( std::accumulate ( v.begin(), v.end(), gmp_rational ( 1, 1 ),
+                            std::multiplies<gmp_rational>() ) );
+
+    for ( unsigned int t = 1u; t <= 8u; t *= 2u ) {
+
+        CPPUNIT_ASSERT_EQUAL ( s, parallel_sum ( v.begin(), v.end(), t ) );
+        CPPUNIT_ASSERT_EQUAL ( p, parallel_product ( v.begin(), v.end(), t ) );
+    }
+}
+
+void GMPTest::testSerialize() {
+
+    const gmp_rational a[] = {
+        gmp_rational(), gmp_rational ( -1, 3 ),
+        gmp_rational ( mpz_class ( "-1208925819614629174706176" ), mpz_class ( 3 ) ),
+        gmp_rational ( mpz_class ( "340282366920938463463374607431768211457" ),
+                       mpz_class ( "18446744073709551617" ) )
+    };
+
+    gmp_rational r;
+
+    for ( std::size_t i = 0u; i < sizeof ( a ) / sizeof ( a[0] ); ++i ) {
+
+        std::vector<unsigned char> buf ( serialized_size ( a[i] ) );
+        const unsigned char *e = serialize ( &buf[0], &buf[0] + buf.size(), a[i] );
+
+        CPPUNIT_ASSERT ( e != 0L );
+        CPPUNIT_ASSERT ( deserialize ( &buf[0], e, r ) == e );
+        CPPUNIT_ASSERT_EQUAL ( a[i], r );
+        CPPUNIT_ASSERT ( deserialize ( &buf[0], e - 1, r ) == 0L );
+    }
+
+    // -2^80/3 is { 0x2e (11 bytes, negative), 0x00 * 10, 0x01, 0x04 (1 byte), 0x03 }
+    unsigned char buf[16];
+
+    CPPUNIT_ASSERT ( serialize ( buf, buf + sizeof ( buf ), a[2] ) == buf + 14 );
+    CPPUNIT_ASSERT_EQUAL ( 0x2e, static_cast<int> ( buf[0] ) );
+    CPPUNIT_ASSERT_EQUAL ( 0x00, static_cast<int> ( buf[10] ) );
+    CPPUNIT_ASSERT_EQUAL ( 0x01, static_cast<int> ( buf[11] ) );
+    CPPUNIT_ASSERT_EQUAL ( 0x04, static_cast<int> ( buf[12] ) );
+    CPPUNIT_ASSERT_EQUAL ( 0x03, static_cast<int> ( buf[13] ) );
+
+    std::stringstream ss;
+
+    RationalBinaryWriter ( ss ).write ( a, a + sizeof ( a ) / sizeof ( a[0] ) );
+
+    RationalBinaryReader<gmp_rational> br ( ss, 8u );
+    std::vector<gmp_rational> out ( br.begin(), br.end() );
+
+    CPPUNIT_ASSERT ( std::equal ( a, a + sizeof ( a ) / sizeof ( a[0] ), out.begin() ) );
+}
+
 #pragma GCC diagnostic ignored "-Wuseless-cast"
 #pragma GCC diagnostic push
+void GMPTest::testHash() {
+
+    const mpz_class big ( "340282366920938463463374607431768211457" );
+
+    CPPUNIT_ASSERT_EQUAL ( HashTraits<mpz_class>::hash ( big ),
+                           HashTraits<mpz_class>::hash ( mpz_class ( big.get_str() ) ) );
+    CPPUNIT_ASSERT ( HashTraits<mpz_class>::hash ( big ) != HashTraits<mpz_class>::hash ( -big ) );
+    CPPUNIT_ASSERT ( HashTraits<mpz_class>::hash ( big ) !=
+                     HashTraits<mpz_class>::hash ( big + 1 ) );
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    const std::hash<gmp_rational> h = std::hash<gmp_rational>();
+
+    CPPUNIT_ASSERT_EQUAL ( h ( gmp_rational ( big, mpz_class ( 3 ) ) ),
+                           h ( gmp_rational ( big * 7, mpz_class ( 21 ) ) ) );
+    CPPUNIT_ASSERT_EQUAL ( h ( gmp_rational ( -1, 2 ) ), h ( gmp_rational ( 2, -4 ) ) );
+
+    std::unordered_set<gmp_rational> s;
+
+    for ( long i = -50; i <= 50; ++i ) {
+        for ( long j = 1; j <= 50; ++j ) s.insert ( gmp_rational ( big * i, mpz_class ( j ) ) );
+    }
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 3095u ), s.size() );
+    CPPUNIT_ASSERT ( s.count ( gmp_rational ( big, mpz_class ( 1 ) ) ) );
+    CPPUNIT_ASSERT ( !s.count ( gmp_rational ( big + 1, mpz_class ( 1 ) ) ) );
+#endif
+}
+
 void GMPTest::testAlgorithm() {
 
     const mpf_class &r (
@@ -567,6 +880,29 @@ void GMPTest::testAlgorithm() {
 
     CPPUNIT_ASSERT ( std::equal ( cal.begin(), cal.end(), cbl.begin() ) );
     CPPUNIT_ASSERT ( std::equal ( cbl.begin(), cbl.end(), cal.begin() ) );
+
+    // long enough for the Lehmer steps
+    mpz_class bn, bd;
+
+    mpz_ui_pow_ui ( bn.get_mpz_t(), 3ul, 3000ul );
+    mpz_ui_pow_ui ( bd.get_mpz_t(), 2ul, 4000ul );
+
+    const gmp_rational big ( -bn, bd + 1 );
+    std::vector<gmp_rational::integer_type> bigcf, smallcf;
+
+    seq ( big, std::back_inserter ( bigcf ) );
+
+    CPPUNIT_ASSERT ( bigcf.size() > 1000u );
+    CPPUNIT_ASSERT_EQUAL ( big, cf ( bigcf.begin(), bigcf.end() ) );
+    CPPUNIT_ASSERT_EQUAL ( big, cf_tree ( bigcf.begin(), bigcf.end() ) );
+    CPPUNIT_ASSERT_EQUAL ( big, cf_tree ( bigcf.begin(), bigcf.end(), 4u ) );
+    CPPUNIT_ASSERT_EQUAL ( cf ( cf_pi, cf_pi + 97 ), cf_tree ( cf_pi, cf_pi + 97, 3u ) );
+
+    seq ( gmp_rational ( 88, -77 ), std::back_inserter ( smallcf ) );
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 2u ), smallcf.size() );
+    CPPUNIT_ASSERT_EQUAL ( -1l, smallcf.front().get_si() );
+    CPPUNIT_ASSERT_EQUAL ( -7l, smallcf.back().get_si() );
 }
 #pragma GCC diagnostic pop
 
@@ -728,6 +1064,12 @@ void GMPTest::testStdMath() {
     CPPUNIT_ASSERT_EQUAL ( std::size_t ( 0 ), dc.pre_leading_zeros );
     CPPUNIT_ASSERT_EQUAL ( std::size_t ( 1776 ), rep.size() );
     CPPUNIT_ASSERT_EQUAL ( std::size_t ( 0 ), dc.leading_zeros );
+    CPPUNIT_ASSERT_EQUAL ( q - gmp_rational ( 3, 1 ), gmp_rational ( dc ) );
+
+    const gmp_rational::rf_info sevenths ( mpz_class ( "142857142857142857142857" ), 0u,
+                                           mpz_class ( 3 ), 2u );
+
+    CPPUNIT_ASSERT_EQUAL ( gmp_rational ( 22, 7000 ), gmp_rational ( sevenths ) );
 
 #if HAVE_MPREAL_H
     {
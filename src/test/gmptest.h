@@ -50,6 +50,13 @@ class GMPTest RATIONAL_FINAL : public CppUnit::TestFixture {
     CPPUNIT_TEST ( testRelOps );
     CPPUNIT_TEST ( testString );
     CPPUNIT_TEST ( testIOStreamOps );
+    CPPUNIT_TEST ( testToChars );
+    CPPUNIT_TEST ( testRadix );
+    CPPUNIT_TEST ( testRationalDigits );
+    CPPUNIT_TEST ( testBinarySplitting );
+    CPPUNIT_TEST ( testParallelReduce );
+    CPPUNIT_TEST ( testSerialize );
+    CPPUNIT_TEST ( testHash );
     CPPUNIT_TEST ( testAlgorithm );
     CPPUNIT_TEST ( testStdMath );
     CPPUNIT_TEST ( testGoldenRatio );
@@ -76,6 +83,13 @@ public:
     void testRelOps();
     void testString();
     void testIOStreamOps();
+    void testToChars();
+    void testRadix();
+    void testRationalDigits();
+    void testBinarySplitting();
+    void testParallelReduce();
+    void testSerialize();
+    void testHash();
     void testAlgorithm();
     void testStdMath();
     void testGoldenRatio();
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iterator>
+
+#include "polynomialtest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION ( PolynomialTest );
+
+using namespace Commons::Math;
+
+namespace {
+
+// Horner's scheme with reductions in every step
+template<class R>
+R horner ( const R *c, std::size_t n, const R& x ) {
+
+    R s;
+
+    while ( n-- > 0u ) s = s * x + c[n];
+
+    return s;
+}
+
+}
+
+void PolynomialTest::testPolynomial() {
+
+    typedef RationalPolynomial<long> poly;
+
+    const long_rational c[] = { long_rational ( 1, 2 ), long_rational ( -2, 3 ),
+                                long_rational ( 3, 4 ), long_rational(), long_rational ( -1, 6 ),
+                                long_rational(), long_rational()
+                              };
+
+    const poly p ( c, c + 7 ), z;
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 4u ), p.degree() );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 0u ), z.degree() );
+    CPPUNIT_ASSERT_EQUAL ( long_rational ( -2, 3 ), p.coefficient ( 1u ) );
+    CPPUNIT_ASSERT_EQUAL ( long_rational(), p.coefficient ( 3u ) );
+    CPPUNIT_ASSERT_EQUAL ( long_rational(), p.coefficient ( 5u ) );
+    CPPUNIT_ASSERT_EQUAL ( long_rational ( 17, 48 ), poly ( c, c + 3 ) ( long_rational ( 1, 2 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( long_rational(), z ( long_rational ( 3, 7 ) ) );
+
+    std::vector<long_rational> x, y, t;
+
+    for ( long i = -12; i <= 12; ++i ) x.push_back ( long_rational ( i, 6 ) );
+
+    x.push_back ( long_rational ( 5, 11 ) );
+    x.push_back ( long_rational ( -5, 11 ) );
+
+    for ( std::size_t i = 0u; i < x.size(); ++i ) {
+        CPPUNIT_ASSERT_EQUAL ( horner ( c, 5u, x[i] ), p ( x[i] ) );
+    }
+
+    p.evaluate ( x.begin(), x.end(), std::back_inserter ( y ) );
+    p.evaluate ( x.begin(), x.end(), std::back_inserter ( t ), 4u );
+    z.evaluate ( x.begin(), x.begin() + 3, std::back_inserter ( t ) );
+
+    CPPUNIT_ASSERT_EQUAL ( x.size(), y.size() );
+    CPPUNIT_ASSERT_EQUAL ( x.size() + 3u, t.size() );
+
+    for ( std::size_t i = 0u; i < x.size(); ++i ) {
+        CPPUNIT_ASSERT_EQUAL ( p ( x[i] ), y[i] );
+        CPPUNIT_ASSERT_EQUAL ( y[i], t[i] );
+    }
+
+    CPPUNIT_ASSERT_EQUAL ( long_rational(), t.back() );
+}
+
+void PolynomialTest::testPolynomial_gmp() {
+#ifdef HAVE_GMPXX_H
+
+    typedef RationalPolynomial<mpz_class, GCD_gmp> poly;
+
+    gmp_rational c[16];
+
+    // the Taylor polynomial of log(1 + x)
+    for ( long i = 1; i < 16; ++i ) c[i] = gmp_rational ( i & 1 ? 1 : -1, i );
+
+    const poly p ( c, c + 16 );
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 15u ), p.degree() );
+    CPPUNIT_ASSERT_EQUAL ( gmp_rational ( -1, 14 ), p.coefficient ( 14u ) );
+
+    std::vector<gmp_rational> x, y;
+
+    for ( long i = -30; i <= 60; ++i ) x.push_back ( gmp_rational ( i, 60 ) );
+
+    p.evaluate ( x.begin(), x.end(), std::back_inserter ( y ), 3u );
+
+    CPPUNIT_ASSERT_EQUAL ( x.size(), y.size() );
+
+    for ( std::size_t i = 0u; i < x.size(); ++i ) {
+        CPPUNIT_ASSERT_EQUAL ( horner ( c, 16u, x[i] ), y[i] );
+    }
+#endif
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;
@@ -17,8 +17,14 @@
  * along with rational.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <iomanip>
 #include <list>
 #include <numeric>
+#include <set>
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+#include <unordered_map>
+#endif
 
 #include "rationaltest.h"
 
@@ -26,6 +32,29 @@ CPPUNIT_TEST_SUITE_REGISTRATION ( RationalTest );
 
 using namespace Commons::Math;
 
+namespace Commons {
+
+namespace Math {
+
+// continued fractions of int16_t overflow early, which gets checked
+template<> struct CFRationalTraits<int16_t> {
+    typedef Rational<int16_t, GCD_euclid, ENABLE_OVERFLOW_CHECK> rational_type;
+};
+
+}
+
+}
+
+// an addition failing on a marked summand
+struct _marked_plus {
+    Rational<long> operator() ( const Rational<long> &x, const Rational<long> &y ) const {
+
+        if ( y == Rational<long> ( 7, 3 ) ) throw std::domain_error ( "marked summand" );
+
+        return x + y;
+    }
+};
+
 RationalTest::RationalTest() : CppUnit::TestFixture(), m_nullRational(), m_sqrt2(), m_accu(),
     m_accu_stein(), m_onethird(), m_oneseventh(), m_accu_ul(), m_twosqrt() {}
 
@@ -293,6 +322,63 @@ void RationalTest::testConstructFromExpression() {
     CPPUNIT_ASSERT_EQUAL ( static_cast<uint64_t> ( 2774848045u ), max_pi_stein.denominator() );
 }
 
+void RationalTest::testEvalBatch() {
+
+    typedef Rational<long> rat;
+    typedef std::pair<std::size_t, std::string> error;
+
+    const char *in[] = { "1/2 + 1/3", "3/4", "1/0", "(2+3", "", "-7/14", "x", "((1.5))" };
+    std::vector<std::string> s;
+
+    for ( std::size_t i = 0u; i < 100u; ++i ) s.push_back ( in[i % 8u] );
+
+    rat o[8];
+    std::vector<rat> v;
+    std::vector<error> e;
+
+    CPPUNIT_ASSERT ( eval_batch<rat> ( in, in + 8, o, std::back_inserter ( e ) ) == o + 8 );
+
+    const rat r[] = { rat ( 5, 6 ), rat ( 3, 4 ), rat(), rat(), rat(), rat ( -1, 2 ), rat(),
+                      rat ( 3, 2 )
+                    };
+
+    CPPUNIT_ASSERT ( std::equal ( o, o + 8, r ) );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 3u ), e.size() );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 2u ), e[0].first );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "division by zero in expression" ), e[0].second );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 3u ), e[1].first );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 6u ), e[2].first );
+
+    for ( unsigned int t = 1u; t <= 7u; t += 3u ) {
+
+        v.clear();
+        e.clear();
+
+        eval_batch<rat> ( s.begin(), s.end(), std::back_inserter ( v ), std::back_inserter ( e ),
+                          t );
+
+        CPPUNIT_ASSERT_EQUAL ( s.size(), v.size() );
+        CPPUNIT_ASSERT_EQUAL ( std::size_t ( 38u ), e.size() );
+
+        for ( std::size_t i = 0u; i < s.size(); ++i ) CPPUNIT_ASSERT_EQUAL ( r[i % 8u], v[i] );
+
+        for ( std::size_t i = 0u; i < e.size(); ++i ) {
+            CPPUNIT_ASSERT ( e[i].first % 8u == 2u || e[i].first % 8u == 3u ||
+                             e[i].first % 8u == 6u );
+            CPPUNIT_ASSERT ( !i || e[i - 1u].first < e[i].first );
+        }
+    }
+
+    rat::eval_state state;
+
+    for ( std::size_t i = 0u; i < 8u; ++i ) {
+        if ( i != 2u && i != 3u && i != 6u ) {
+            CPPUNIT_ASSERT_EQUAL ( r[i], rat::eval ( in[i], in[i] + std::strlen ( in[i] ),
+                                   state ) );
+        }
+    }
+}
+
 void RationalTest::testAssignedFromDouble() {
 
     const Rational<rational_type> &p = 19.0/51.0;
@@ -1160,15 +1246,635 @@ void RationalTest::testIOStreamOps() {
     CPPUNIT_ASSERT_EQUAL ( 8717442233u, in_pi.numerator() );
     CPPUNIT_ASSERT_EQUAL ( static_cast<uint64_t> ( 2774848045u ), in_pi.denominator() );
 
-#ifdef __EXCEPTIONS
     const Rational<uint64_t> out_mixed ( 2, 3, 4 );
 
     os.str ( "" );
     os << out_mixed.str ( true );
 
     std::istringstream is3 ( os.str() );
+    Rational<uint64_t> in_frac;
+
+    CPPUNIT_ASSERT ( is3 >> in_pi >> in_frac );
+    CPPUNIT_ASSERT_EQUAL ( Rational<uint64_t> ( 2u, 1u ), in_pi );
+    CPPUNIT_ASSERT_EQUAL ( Rational<uint64_t> ( 3u, 4u ), in_frac );
+    CPPUNIT_ASSERT ( ! ( is3 >> in_pi ) );
+    CPPUNIT_ASSERT ( is3.eof() );
+
+#ifdef __EXCEPTIONS
+    std::istringstream is4 ( "2 3/4 x" );
+
+    CPPUNIT_ASSERT_THROW ( is4 >> in_pi >> in_frac >> in_pi, std::runtime_error );
+#endif
+}
+
+void RationalTest::testRationalReader() {
+
+    std::istringstream is ( "  1/2 -3/4\t(1 + 1) / 3\n 1/8 * 8.897 - 3.6 *\n1  +7 - -1\n" );
+    Rational<rational_type> r;
+
+    CPPUNIT_ASSERT ( is >> r );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( 1, 2 ), r );
+    CPPUNIT_ASSERT ( is >> r );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( -3, 4 ), r );
+    CPPUNIT_ASSERT ( is >> r );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( 2, 3 ), r );
+    CPPUNIT_ASSERT ( is >> r );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( -19903, 8000 ), r );
+    CPPUNIT_ASSERT ( is >> r );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( 8, 1 ), r );
+    CPPUNIT_ASSERT ( ! ( is >> r ) );
+
+    std::istringstream cs ( "1/2 + 1, 3/4,-5\n7/8" );
+    std::vector<Rational<rational_type> > v;
+
+    cs >> rational_delimiter ( ',' );
+
+    while ( cs >> r ) v.push_back ( r );
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 4u ), v.size() );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( 3, 2 ), v[0] );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( 3, 4 ), v[1] );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( -5, 1 ), v[2] );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( 7, 8 ), v[3] );
+
+    std::istringstream rs ( "1/3 1/6\n1/2\n\n0.25" );
+    RationalReader<Rational<rational_type> > reader ( rs );
+
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( 5, 4 ),
+                           std::accumulate ( reader.begin(), reader.end(),
+                                             Rational<rational_type>() ) );
+
+    std::istringstream ds ( "1;2/3;  -4/5 ;6" );
+    RationalReader<Rational<rational_type> > dreader ( ds, ';' );
+
+    CPPUNIT_ASSERT ( dreader.next ( r ) );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( 1, 1 ), r );
+    CPPUNIT_ASSERT ( dreader.next ( r ) );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( 2, 3 ), r );
+    CPPUNIT_ASSERT ( dreader.next ( r ) );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( -4, 5 ), r );
+    CPPUNIT_ASSERT ( dreader.next ( r ) );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( 6, 1 ), r );
+    CPPUNIT_ASSERT ( !dreader.next ( r ) );
+
+    const char num[] = "-42/56 tail";
+
+    CPPUNIT_ASSERT_EQUAL ( static_cast<const char *> ( num + 6 ),
+                           from_chars ( num, num + sizeof ( num ) - 1, r ) );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( -3, 4 ), r );
+    CPPUNIT_ASSERT ( from_chars ( num + 7, num + sizeof ( num ) - 1, r ) == 0L );
+}
+
+void RationalTest::testToChars() {
+
+    char buf[32];
+    char *e;
+
+    const Rational<rational_type> a ( -245850922, 78256779 );
+
+    CPPUNIT_ASSERT ( formatted_size ( a ) >= 19u );
+    CPPUNIT_ASSERT ( ( e = to_chars ( buf, buf + sizeof ( buf ), a ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "-245850922/78256779" ), std::string ( buf, e ) );
+    CPPUNIT_ASSERT ( ( e = to_chars ( buf, buf + sizeof ( buf ), a, true ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "-3 11080585/78256779" ), std::string ( buf, e ) );
+    CPPUNIT_ASSERT_EQUAL ( a.str ( true ), std::string ( buf, e ) );
+
+    CPPUNIT_ASSERT ( ( e = to_chars ( buf, buf + sizeof ( buf ),
+                                      Rational<rational_type> ( -1, 8 ), true ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "1/8" ), std::string ( buf, e ) );
+    CPPUNIT_ASSERT ( ( e = to_chars ( buf, buf + sizeof ( buf ),
+                                      Rational<rational_type> ( -42, 1 ) ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "-42" ), std::string ( buf, e ) );
+    CPPUNIT_ASSERT ( ( e = to_chars ( buf, buf + sizeof ( buf ),
+                                      Rational<rational_type> ( 0, 1 ) ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "0" ), std::string ( buf, e ) );
+
+    CPPUNIT_ASSERT ( to_chars ( buf, buf + 10, a ) == 0L );
+    CPPUNIT_ASSERT ( to_chars ( buf, buf + 10, a, true ) == 0L );
+
+    const Rational<unsigned long> b ( 18446744073709551615ul, 2ul );
+
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "18446744073709551615/2" ), b.str() );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "9223372036854775807 1/2" ), b.str ( true ) );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "-2147483648/3" ),
+                           Rational<rational_type> ( std::numeric_limits<rational_type>::min(),
+                                   3 ).str() );
+
+    std::ostringstream os;
+    os << std::setw ( 6 ) << Rational<rational_type> ( 1, 2 );
+
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "   1/2" ), os.str() );
+}
+
+void RationalTest::testRadix() {
+
+    char buf[80];
+    char *e;
+
+    const Rational<rational_type> a ( -245850922, 78256779 );
+
+    CPPUNIT_ASSERT ( formatted_size ( a, 2 ) <= sizeof ( buf ) );
+    CPPUNIT_ASSERT ( ( e = to_chars ( buf, buf + sizeof ( buf ), a, 16 ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "-ea7632a/4aa1a8b" ), std::string ( buf, e ) );
+    CPPUNIT_ASSERT ( ( e = to_chars ( buf, buf + sizeof ( buf ), a, 62, true ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "-3 kUZ7/5IMA7" ), std::string ( buf, e ) );
+    CPPUNIT_ASSERT ( ( e = to_chars ( buf, buf + sizeof ( buf ), a, 10 ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( a.str(), std::string ( buf, e ) );
+
+    CPPUNIT_ASSERT ( ( e = to_chars ( buf, buf + sizeof ( buf ), Rational<rational_type> (
+                                          std::numeric_limits<rational_type>::min(), 3 ),
+                                      2 ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "-10000000000000000000000000000000/11" ),
+                           std::string ( buf, e ) );
+    CPPUNIT_ASSERT ( ( e = to_chars ( buf, buf + sizeof ( buf ),
+                                      Rational<unsigned long> ( 18446744073709551615ul, 7ul ),
+                                      8 ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "1777777777777777777777/7" ), std::string ( buf, e ) );
+    CPPUNIT_ASSERT ( to_chars ( buf, buf + 10, a, 2 ) == 0L );
+
+    CPPUNIT_ASSERT ( fixed_size ( a, 12 ) <= sizeof ( buf ) );
+    CPPUNIT_ASSERT ( ( e = to_chars_fixed ( buf, buf + sizeof ( buf ), a, 12 ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "-3.141592653589" ), std::string ( buf, e ) );
+    CPPUNIT_ASSERT ( ( e = to_chars_fixed ( buf, buf + sizeof ( buf ),
+                                            Rational<rational_type> ( -2, 3 ), 4 ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "-0.6666" ), std::string ( buf, e ) );
+    CPPUNIT_ASSERT ( ( e = to_chars_fixed ( buf, buf + sizeof ( buf ),
+                                            Rational<rational_type> ( 1, 7 ), 12, 2 ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "0.001001001001" ), std::string ( buf, e ) );
+    CPPUNIT_ASSERT ( ( e = to_chars_fixed ( buf, buf + sizeof ( buf ),
+                                            Rational<rational_type> ( 7, 2 ), 0 ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "3" ), std::string ( buf, e ) );
+
+    // no overflow in r * base for a denominator near the limits
+    CPPUNIT_ASSERT ( ( e = to_chars_fixed ( buf, buf + sizeof ( buf ),
+                                            Rational<unsigned long> ( 18446744073709551614ul,
+                                                    18446744073709551615ul ), 5, 16 ) ) != 0L );
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "0.fffff" ), std::string ( buf, e ) );
+    CPPUNIT_ASSERT ( to_chars_fixed ( buf, buf + 8, a, 12 ) == 0L );
+
+    const int invalid[] = { -2, 0, 1, 63 };
+
+    for ( std::size_t i = 0u; i < sizeof ( invalid ) / sizeof ( int ); ++i ) {
+        CPPUNIT_ASSERT ( to_chars ( buf, buf + sizeof ( buf ), a, invalid[i] ) == 0L );
+        CPPUNIT_ASSERT ( to_chars_fixed ( buf, buf + sizeof ( buf ), a, 4, invalid[i] ) == 0L );
+        CPPUNIT_ASSERT_EQUAL ( std::size_t ( 0u ), formatted_size ( a, invalid[i] ) );
+        CPPUNIT_ASSERT_EQUAL ( std::size_t ( 0u ), fixed_size ( a, 4, invalid[i] ) );
+    }
+}
+
+void RationalTest::testRationalDigits() {
+
+    RationalDigits<Rational<long> > a ( Rational<long> ( -245850922, 78256779 ), 10, 12 );
+
+    CPPUNIT_ASSERT_EQUAL ( -3l, a.whole() );
+    CPPUNIT_ASSERT ( a.negative() );
+    CPPUNIT_ASSERT ( !a.terminating() );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 0 ), a.period_start() );
+
+    std::string s;
+
+    for ( RationalDigits<Rational<long> >::iterator i ( a.begin() ); i != a.end(); ++i ) {
+        s.push_back ( static_cast<char> ( '0' + *i ) );
+    }
+
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "141592653589" ), s );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 12 ), a.position() );
+
+    int d;
+
+    RationalDigits<Rational<unsigned long> > b ( Rational<unsigned long> ( 1ul, 39880ul ) );
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 3 ), b.period_start() );
+    CPPUNIT_ASSERT ( !b.terminating() );
+
+    s.clear();
+
+    while ( b.position() < 10u && b.next ( d ) ) s.push_back ( static_cast<char> ( '0' + d ) );
+
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "0000250752" ), s );
+
+    RationalDigits<Rational<long> > c ( Rational<long> ( -5, 16 ), 2 );
+
+    CPPUNIT_ASSERT_EQUAL ( 0l, c.whole() );
+    CPPUNIT_ASSERT ( c.negative() );
+    CPPUNIT_ASSERT ( c.terminating() );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 4 ), c.period_start() );
+    CPPUNIT_ASSERT_EQUAL ( 4l, static_cast<long> ( std::distance ( c.begin(), c.end() ) ) );
+
+    RationalDigits<Rational<long> > e ( Rational<long> ( 7, 1 ) );
+
+    CPPUNIT_ASSERT ( e.begin() == e.end() );
+
+    typedef Rational<long, GCD_null> rat_null;
+
+    RationalDigits<rat_null> f ( rat_null ( 1, 12 ) );
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 2 ), f.period_start() );
+    CPPUNIT_ASSERT ( !f.terminating() );
+
+    s.clear();
+
+    while ( f.position() < 5u && f.next ( d ) ) s.push_back ( static_cast<char> ( '0' + d ) );
+
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "08333" ), s );
+
+    RationalDigits<rat_null> g ( rat_null ( 1, 4 ) );
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 2 ), g.period_start() );
+    CPPUNIT_ASSERT ( g.terminating() );
+
+    // the period is the one of the reduced fraction
+    RationalDigits<rat_null> h ( rat_null ( 3, 6 ) ), k ( rat_null ( -10, 6 ) );
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 1 ), h.period_start() );
+    CPPUNIT_ASSERT ( h.terminating() );
+    CPPUNIT_ASSERT ( h.next ( d ) );
+    CPPUNIT_ASSERT_EQUAL ( 5, d );
+    CPPUNIT_ASSERT ( !h.next ( d ) );
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 0 ), k.period_start() );
+    CPPUNIT_ASSERT ( !k.terminating() );
+    CPPUNIT_ASSERT_EQUAL ( -1l, k.whole() );
+    CPPUNIT_ASSERT ( k.next ( d ) );
+    CPPUNIT_ASSERT_EQUAL ( 6, d );
+}
+
+void RationalTest::testRationalConvergents() {
+
+    typedef Rational<long> rat;
+
+    const rat pi ( 245850922, 78256779 );
+    std::vector<rat> c;
+
+    {
+        RationalConvergents<rat> g ( pi );
+        c.assign ( g.begin(), g.end() );
+    }
+
+    CPPUNIT_ASSERT_EQUAL ( pi, c.back() );
+
+    std::vector<long> s;
+
+    seq ( pi, std::back_inserter ( s ) );
+
+    CPPUNIT_ASSERT_EQUAL ( s.size(), c.size() );
+
+    for ( std::size_t i = 0u; i < c.size(); ++i ) {
+        CPPUNIT_ASSERT_EQUAL ( cf ( s.begin(), s.begin() + i + 1 ), c[i] );
+    }
+
+    {
+        RationalConvergents<rat> g ( pi );
+        c.assign ( g.denominator_bound ( 1000l ).begin(), g.end() );
+    }
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 4 ), c.size() );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 355, 113 ), c.back() );
+
+    {
+        RationalConvergents<rat> g ( pi );
+        c.assign ( g.tolerance ( rat ( 1, 1000 ) ).begin(), g.end() );
+    }
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 3 ), c.size() );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 333, 106 ), c.back() );
+
+    const rat sc[] = {
+        rat ( 3, 1 ), rat ( 4, 1 ), rat ( 7, 2 ), rat ( 10, 3 ), rat ( 13, 4 ), rat ( 16, 5 ),
+        rat ( 19, 6 ), rat ( 22, 7 ), rat ( 25, 8 ), rat ( 47, 15 )
+    };
+
+    {
+        RationalConvergents<rat> g ( pi, true );
+        c.assign ( g.denominator_bound ( 20l ).begin(), g.end() );
+    }
+
+    CPPUNIT_ASSERT_EQUAL ( sizeof ( sc ) / sizeof ( sc[0] ), c.size() );
+    CPPUNIT_ASSERT ( std::equal ( c.begin(), c.end(), sc ) );
+
+    RationalConvergents<rat> n ( rat ( -7, 3 ) );
+    rat r;
+
+    CPPUNIT_ASSERT ( n.next ( r ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( -2, 1 ), r );
+    CPPUNIT_ASSERT ( n.next ( r ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( -7, 3 ), r );
+    CPPUNIT_ASSERT ( !n.next ( r ) );
+
+    RationalConvergents<Rational<unsigned long> > z ( Rational<unsigned long>(), true );
+
+    CPPUNIT_ASSERT_EQUAL ( 1l, static_cast<long> ( std::distance ( z.begin(), z.end() ) ) );
+}
+
+void RationalTest::testSimplest() {
+
+    typedef Rational<long> rat;
+
+    CPPUNIT_ASSERT_EQUAL ( rat ( 1, 3 ), simplest ( rat ( 333, 1000 ), rat ( 334, 1000 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 355, 113 ), simplest ( rat ( 3141592, 1000000 ),
+                           rat ( 3141593, 1000000 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 3, 1 ), simplest ( rat ( 3, 1 ), rat ( 7, 2 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 10, 3 ), simplest ( rat ( 3, 1 ), rat ( 7, 2 ), true ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 1, 2 ), simplest ( rat ( 2, 3 ), rat ( 1, 3 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 2, 5 ), simplest ( rat ( 1, 3 ), rat ( 1, 2 ), true ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( -1, 3 ), simplest ( rat ( -334, 1000 ), rat ( -333, 1000 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat(), simplest ( rat ( -1, 7 ), rat ( 5, 3 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( -1, 2 ), simplest ( rat ( -1, 1 ), rat(), true ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 5, 7 ), simplest ( rat ( 5, 7 ), rat ( 5, 7 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( Rational<unsigned long> ( 2, 1 ),
+                           simplest ( Rational<unsigned long> ( 7, 4 ),
+                                      Rational<unsigned long> ( 9, 4 ) ) );
+
+#ifdef __EXCEPTIONS
+    CPPUNIT_ASSERT_THROW ( simplest ( rat ( 5, 7 ), rat ( 5, 7 ), true ), std::domain_error );
+#endif
 
-    CPPUNIT_ASSERT_THROW ( is3 >> in_pi, std::runtime_error );
+    // the shortest fraction for all doubles closer to 0.1 than to its neighbours
+    const double d = 0.1, ulp = std::numeric_limits<double>::epsilon() * d;
+
+    CPPUNIT_ASSERT_EQUAL ( rat ( 1, 10 ), simplest ( rat ( d - ulp / 4 ), rat ( d + ulp / 4 ) ) );
+
+    CPPUNIT_ASSERT_EQUAL ( rat ( 3, 5 ), mediant ( rat ( 1, 2 ), rat ( 2, 3 ) ) );
+
+    CPPUNIT_ASSERT_EQUAL ( 0l, sb_depth ( rat ( 1, 1 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( 1l, sb_depth ( rat ( 1, 2 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( 3l, sb_depth ( rat ( 3, 5 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( 3l, sb_depth ( rat ( 4, 1 ) ) );
+
+    CPPUNIT_ASSERT_EQUAL ( rat ( 1, 2 ), sb_left ( rat ( 1, 1 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 2, 1 ), sb_right ( rat ( 1, 1 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 4, 7 ), sb_left ( rat ( 3, 5 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 5, 8 ), sb_right ( rat ( 3, 5 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 5, 1 ), sb_right ( rat ( 4, 1 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 7, 2 ), sb_left ( rat ( 4, 1 ) ) );
+
+    CPPUNIT_ASSERT_EQUAL ( rat ( 2, 3 ), sb_parent ( rat ( 3, 5 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 1, 1 ), sb_parent ( rat ( 1, 2 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 3, 1 ), sb_parent ( rat ( 4, 1 ) ) );
+
+    for ( rat r ( 13, 8 ); r != rat ( 1, 1 ); r = sb_parent ( r ) ) {
+        CPPUNIT_ASSERT ( sb_left ( sb_parent ( r ) ) == r || sb_right ( sb_parent ( r ) ) == r );
+        CPPUNIT_ASSERT_EQUAL ( sb_depth ( r ) - 1l, sb_depth ( sb_parent ( r ) ) );
+    }
+
+    // the node of an unreduced fraction is the one of the reduced fraction
+    typedef Rational<long, GCD_null> rat_null;
+
+    const rat_null half ( 2, 4 ), l ( sb_left ( half ) ), r ( sb_right ( half ) ),
+          p ( sb_parent ( half ) );
+
+    CPPUNIT_ASSERT_EQUAL ( 1l, l.numerator() );
+    CPPUNIT_ASSERT_EQUAL ( 3l, l.denominator() );
+    CPPUNIT_ASSERT_EQUAL ( 2l, r.numerator() );
+    CPPUNIT_ASSERT_EQUAL ( 3l, r.denominator() );
+    CPPUNIT_ASSERT_EQUAL ( 1l, p.numerator() );
+    CPPUNIT_ASSERT_EQUAL ( 1l, p.denominator() );
+    CPPUNIT_ASSERT_EQUAL ( 1l, sb_depth ( half ) );
+
+#ifdef __EXCEPTIONS
+    CPPUNIT_ASSERT_THROW ( sb_parent ( rat ( 1, 1 ) ), std::domain_error );
+    CPPUNIT_ASSERT_THROW ( sb_depth ( rat ( -1, 2 ) ), std::domain_error );
+#endif
+}
+
+void RationalTest::testFarey() {
+
+    typedef Rational<long> rat;
+
+    std::ostringstream os;
+    FareySequence<rat> f5 ( 5l );
+
+    for ( FareySequence<rat>::iterator i ( f5.begin() ); i != f5.end(); ++i ) os << *i << ' ';
+
+    CPPUNIT_ASSERT_EQUAL ( std::string ( "0 1/5 1/4 1/3 2/5 1/2 3/5 2/3 3/4 4/5 1 " ),
+                           os.str() );
+
+    std::vector<rat> v, w;
+
+    for ( long n = 1l; n <= 60l; ++n ) {
+
+        std::set<rat> s;
+
+        for ( long d = 1l; d <= n; ++d ) {
+            for ( long p = -d; p <= 4l * d; ++p ) s.insert ( rat ( p, d ) );
+        }
+
+        const rat lo[] = { rat(), rat ( -1, 1 ), rat ( 2, 7 ), rat ( 355, 113 ),
+                           rat ( -13, 61 ), rat ( 1, 3 ) };
+        const rat hi[] = { rat ( 1, 1 ), rat ( 2, 1 ), rat ( 17, 19 ), rat ( 7, 2 ),
+                           rat ( 1, 61 ), rat ( 1, 3 ) };
+
+        for ( std::size_t i = 0u; i < sizeof ( lo ) / sizeof ( lo[0] ); ++i ) {
+
+            v.clear();
+            w.clear();
+
+            farey ( n, lo[i], hi[i], std::back_inserter ( v ) );
+            std::copy ( s.lower_bound ( lo[i] ), s.upper_bound ( hi[i] ),
+                        std::back_inserter ( w ) );
+
+            CPPUNIT_ASSERT ( v == w );
+
+            v.clear();
+            farey ( n, lo[i], hi[i], std::back_inserter ( v ), 3u );
+
+            CPPUNIT_ASSERT ( v == w );
+        }
+    }
+
+    v.clear();
+    farey ( 0l, rat(), rat ( 1, 1 ), std::back_inserter ( v ) );
+    farey ( 5l, rat ( 1, 1 ), rat(), std::back_inserter ( v ) );
+
+    CPPUNIT_ASSERT ( v.empty() );
+
+    v.clear();
+    farey ( 1000l, rat(), rat ( 1, 1 ), std::back_inserter ( v ), 4u );
+
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 304193u ), v.size() );
+
+#ifdef __EXCEPTIONS
+    typedef Rational<int8_t, GCD_euclid, ENABLE_OVERFLOW_CHECK> chk_rat;
+
+    FareySequence<chk_rat> f127 ( 127 );
+    chk_rat r;
+
+    // the next term recurrence calculates 127 + 1
+    CPPUNIT_ASSERT_THROW ( f127.next ( r ), std::domain_error );
+#endif
+}
+
+void RationalTest::testParallelReduce() {
+
+    typedef Rational<int64_t, GCD_euclid_fast, ENABLE_OVERFLOW_CHECK> rat;
+
+    std::vector<rat> v;
+
+    for ( int64_t i = 0; i < 1000; ++i ) v.push_back ( rat ( i % 7 - 3, i % 12 + 1 ) );
+
+    const rat &s ( std::accumulate ( v.begin(), v.end(), rat() ) );
+
+    for ( unsigned int t = 1u; t <= 5u; t += 2u ) {
+
+        CPPUNIT_ASSERT_EQUAL ( s, parallel_sum ( v.begin(), v.end(), t ) );
+        CPPUNIT_ASSERT_EQUAL ( s + rat ( 1, 2 ), parallel_reduce ( v.begin(), v.end(),
+                               rat ( 1, 2 ), std::plus<rat>(), t ) );
+        CPPUNIT_ASSERT_EQUAL ( std::accumulate ( v.begin() + 1, v.begin() + 41, rat ( 1, 1 ),
+                               std::multiplies<rat>() ), parallel_product ( v.begin() + 1,
+                                       v.begin() + 41, t ) );
+    }
+
+    CPPUNIT_ASSERT_EQUAL ( rat(), parallel_sum ( v.begin(), v.begin() ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 1, 1 ), parallel_product ( v.begin(), v.begin(), 2u ) );
+    CPPUNIT_ASSERT_EQUAL ( rat ( 3, 4 ), parallel_reduce ( v.begin(), v.begin(), rat ( 3, 4 ),
+                           std::multiplies<rat>() ) );
+
+#ifdef __EXCEPTIONS
+    // exceptions of both halves reach the caller, the right one is reduced on its thread
+    std::vector<Rational<long> > w ( 4096u, Rational<long> ( 1, 2 ) );
+
+    w.back() = Rational<long> ( 7, 3 );
+
+    CPPUNIT_ASSERT_THROW ( parallel_reduce ( w.begin(), w.end(), Rational<long>(),
+                           _marked_plus(), 2u ), std::domain_error );
+
+    w.back() = Rational<long> ( 1, 2 );
+    w[1] = Rational<long> ( 7, 3 );
+
+    CPPUNIT_ASSERT_THROW ( parallel_reduce ( w.begin(), w.end(), Rational<long>(),
+                           _marked_plus(), 2u ), std::domain_error );
+#endif
+}
+
+void RationalTest::testSerialize() {
+
+    unsigned char buf[32];
+    unsigned char *e;
+    Rational<rational_type> r;
+
+    const Rational<rational_type> a[] = {
+        Rational<rational_type> ( 0, 1 ), Rational<rational_type> ( 1, 2 ),
+        Rational<rational_type> ( -63, 64 ), Rational<rational_type> ( -64, 65 ),
+        Rational<rational_type> ( std::numeric_limits<rational_type>::min(), 1 ),
+        Rational<rational_type> ( std::numeric_limits<rational_type>::max(), 2 )
+    };
+
+    for ( std::size_t i = 0u; i < sizeof ( a ) / sizeof ( a[0] ); ++i ) {
+
+        CPPUNIT_ASSERT ( ( e = serialize ( buf, buf + sizeof ( buf ), a[i] ) ) != 0L );
+        CPPUNIT_ASSERT ( static_cast<std::size_t> ( e - buf ) <= serialized_size ( a[i] ) );
+        CPPUNIT_ASSERT ( deserialize ( buf, e, r ) == e );
+        CPPUNIT_ASSERT_EQUAL ( a[i], r );
+
+        bool more = false;
+
+        CPPUNIT_ASSERT ( deserialize ( buf, e - 1, r, &more ) == 0L );
+        CPPUNIT_ASSERT ( more );
+    }
+
+    // zig-zag: -63/64 is { 0x7d, 0x80, 0x01 }
+    CPPUNIT_ASSERT ( ( e = serialize ( buf, buf + sizeof ( buf ), a[2] ) ) == buf + 3 );
+    CPPUNIT_ASSERT_EQUAL ( 0x7d, static_cast<int> ( buf[0] ) );
+    CPPUNIT_ASSERT_EQUAL ( 0x80, static_cast<int> ( buf[1] ) );
+    CPPUNIT_ASSERT_EQUAL ( 0x01, static_cast<int> ( buf[2] ) );
+
+    CPPUNIT_ASSERT ( serialize ( buf, buf + 2, a[2] ) == 0L );
+
+    const unsigned char zero_denom[] = { 0x02, 0x00 };
+    const unsigned char overflow[] = { 0x02, 0xff, 0xff, 0xff, 0xff, 0x7f };
+
+    const unsigned char unreduced[] = { 0x04, 0x08 };
+
+    bool more = true;
+
+    CPPUNIT_ASSERT ( deserialize ( zero_denom, zero_denom + 2, r, &more ) == 0L );
+    CPPUNIT_ASSERT ( !more );
+
+    more = true;
+
+    CPPUNIT_ASSERT ( deserialize ( overflow, overflow + 6, r, &more ) == 0L );
+    CPPUNIT_ASSERT ( !more );
+    CPPUNIT_ASSERT ( deserialize ( unreduced, unreduced + 2, r ) == unreduced + 2 );
+    CPPUNIT_ASSERT_EQUAL ( rational_type ( 1 ), r.numerator() );
+    CPPUNIT_ASSERT_EQUAL ( rational_type ( 2 ), r.denominator() );
+
+    const Rational<unsigned long> u ( 18446744073709551615ul, 2ul );
+    Rational<unsigned long> v;
+
+    CPPUNIT_ASSERT ( ( e = serialize ( buf, buf + sizeof ( buf ), u ) ) != 0L );
+    CPPUNIT_ASSERT ( deserialize ( buf, e, v ) == e );
+    CPPUNIT_ASSERT_EQUAL ( u, v );
+
+    std::vector<Rational<rational_type> > in, out;
+
+    for ( rational_type i = 1; i < 1000; ++i ) {
+        in.push_back ( Rational<rational_type> ( -i * i, i + 1 ) );
+    }
+
+    std::stringstream ss;
+
+    {
+        RationalBinaryWriter w ( ss, 64u );
+        w.write ( in.begin(), in.end() );
+    }
+
+    RationalBinaryReader<Rational<rational_type> > br ( ss, 64u );
+
+    std::copy ( br.begin(), br.end(), std::back_inserter ( out ) );
+
+    CPPUNIT_ASSERT ( in == out );
+    CPPUNIT_ASSERT ( !ss.fail() );
+
+    std::stringstream ts ( std::string ( "\x02\x04\x06", 3 ) );
+    RationalBinaryReader<Rational<rational_type> > tr ( ts );
+
+    CPPUNIT_ASSERT ( tr.next ( r ) );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( 1, 2 ), r );
+    CPPUNIT_ASSERT ( !tr.next ( r ) );
+    CPPUNIT_ASSERT ( ts.fail() );
+
+    // a corrupt record fails at once, without buffering the rest of the stream
+    std::stringstream cs ( std::string ( "\x02\x00", 2 ) + std::string ( 1u << 16, '\x02' ) );
+    RationalBinaryReader<Rational<rational_type> > cr ( cs, 64u );
+
+    CPPUNIT_ASSERT ( !cr.next ( r ) );
+    CPPUNIT_ASSERT ( cs.fail() );
+    CPPUNIT_ASSERT ( cs.rdbuf()->pubseekoff ( 0, std::ios_base::cur, std::ios_base::in ) <
+                     std::streampos ( 1024 ) );
+}
+
+void RationalTest::testHash() {
+
+    CPPUNIT_ASSERT_EQUAL ( HashTraits<long>::hash ( 42 ), HashTraits<int8_t>::hash ( 42 ) );
+    CPPUNIT_ASSERT ( HashTraits<long>::hash ( 1 ) != HashTraits<long>::hash ( -1 ) );
+
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
+    typedef Rational<long> rat;
+    typedef Rational<long, GCD_stein, ENABLE_OVERFLOW_CHECK> rat_chk;
+    typedef Rational<long, GCD_null> rat_null;
+
+    const std::hash<rat> h = std::hash<rat>();
+
+    // equal values hash equally, regardless of how they were built and their policies
+    CPPUNIT_ASSERT_EQUAL ( h ( rat ( 1, 2 ) ), h ( rat ( -3, -6 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( h ( rat ( -1, 2 ) ), h ( rat ( 2, -4 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( h ( rat() ), h ( rat ( 0, -7 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( h ( rat ( 5, 3 ) ), std::hash<rat_chk>() ( rat_chk ( 10, 6 ) ) );
+    CPPUNIT_ASSERT_EQUAL ( h ( rat ( 5, 3 ) ), std::hash<rat_null>() ( rat_null ( 10, 6 ) ) );
+    CPPUNIT_ASSERT ( h ( rat ( 1, 2 ) ) != h ( rat ( 2, 1 ) ) );
+    CPPUNIT_ASSERT ( h ( rat ( 1, 2 ) ) != h ( rat ( -1, 2 ) ) );
+
+    std::unordered_map<rat, int> m;
+
+    for ( long i = -50; i <= 50; ++i ) {
+        for ( long j = 1; j <= 50; ++j ) ++m[rat ( i, j )];
+    }
+
+    // the amount of distinct fractions with a denominator up to 50 and |x| <= 50
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 3095u ), m.size() );
+    CPPUNIT_ASSERT_EQUAL ( 50, m[rat()] );
+    CPPUNIT_ASSERT_EQUAL ( 25, m[rat ( 1, 2 )] );
+    CPPUNIT_ASSERT_EQUAL ( 1, m[rat ( -49, 50 )] );
 #endif
 }
 
@@ -1293,6 +1999,23 @@ void RationalTest::testAlgorithm() {
     CPPUNIT_ASSERT_EQUAL ( static_cast<std::vector<rational_type>::size_type> ( 5u ), o_pi.size() );
     CPPUNIT_ASSERT ( std::equal ( o_pi.begin(), o_pi.end(), cf_pi ) );
 
+    CPPUNIT_ASSERT_EQUAL ( cf ( cf_pi, cf_pi + 5 ), cf_tree ( cf_pi, cf_pi + 5 ) );
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type>(), cf_tree ( cf_pi, cf_pi ) );
+
+    const std::vector<rational_type> cf_phi ( 40u, 1 );
+
+    CPPUNIT_ASSERT_EQUAL ( Rational<rational_type> ( 165580141, 102334155 ),
+                           cf_tree ( cf_phi.begin(), cf_phi.end(), 2u ) );
+
+#ifdef __EXCEPTIONS
+    // the upper half overflows on the calling thread
+    std::vector<int16_t> cf_ovl ( 20u, 1 );
+
+    cf_ovl.resize ( 40u, 200 );
+
+    CPPUNIT_ASSERT_THROW ( cf_tree ( cf_ovl.begin(), cf_ovl.end(), 2u ), std::domain_error );
+#endif
+
     rational_type ccf[] = { 0, 3 };
     std::vector<rational_type> ocf;
 
@@ -1509,6 +2232,62 @@ void RationalTest::testStdMath() {
     CPPUNIT_ASSERT_EQUAL ( static_cast<Rational<unsigned long>::rf_info::digit_type> ( 2 ),
                            *unique_rep.rbegin() );
 
+    const Rational<unsigned long> r3 ( 1ul, 39880ul );
+
+    CPPUNIT_ASSERT_EQUAL ( 0ul, r3.decompose ( dc, pre, rep, true ) );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 3 ), pre.size() );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 166 ), rep.size() );
+
+    {
+        std::string digits;
+        std::vector<char> fixed ( fixed_size ( r3, 169u ) );
+
+        for ( std::size_t i = 0u; i < pre.size(); ++i ) digits.push_back ( '0' + pre[i] );
+        for ( std::size_t i = 0u; i < rep.size(); ++i ) digits.push_back ( '0' + rep[i] );
+
+        CPPUNIT_ASSERT_EQUAL ( "0." + digits, std::string ( &fixed[0], to_chars_fixed ( &fixed[0],
+                               &fixed[0] + fixed.size(), r3, 169u ) ) );
+    }
+
+    // the base factors get stripped even if the gcd policy doesn't reduce
+    typedef Rational<long, GCD_null> rat_null;
+
+    rat_null::rf_info ndc;
+    std::vector<rat_null::rf_info::digit_type> npre, nrep;
+
+    CPPUNIT_ASSERT_EQUAL ( 0l, rat_null ( 1, 4 ).decompose ( ndc, npre, nrep ) );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 2 ), npre.size() );
+    CPPUNIT_ASSERT ( nrep.empty() );
+    CPPUNIT_ASSERT_EQUAL ( 25l, ndc.pre );
+
+    CPPUNIT_ASSERT_EQUAL ( 0l, rat_null ( 1, 12 ).decompose ( ndc, npre, nrep ) );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 2 ), npre.size() );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 1 ), nrep.size() );
+    CPPUNIT_ASSERT_EQUAL ( 8l, ndc.pre );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 1 ), ndc.pre_leading_zeros );
+    CPPUNIT_ASSERT_EQUAL ( 3l, ndc.reptend );
+
+    // the lengths are the ones of the reduced fraction
+    CPPUNIT_ASSERT_EQUAL ( 0l, rat_null ( 2, 4 ).decompose ( ndc, npre, nrep ) );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 1 ), npre.size() );
+    CPPUNIT_ASSERT ( nrep.empty() );
+    CPPUNIT_ASSERT_EQUAL ( 5l, ndc.pre );
+
+    CPPUNIT_ASSERT_EQUAL ( 0l, rat_null ( 4, 8 ).decompose ( ndc, npre, nrep ) );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 1 ), npre.size() );
+    CPPUNIT_ASSERT ( nrep.empty() );
+    CPPUNIT_ASSERT_EQUAL ( 5l, ndc.pre );
+
+    CPPUNIT_ASSERT_EQUAL ( 0l, rat_null ( 3, 6 ).decompose ( ndc, npre, nrep ) );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 1 ), npre.size() );
+    CPPUNIT_ASSERT ( nrep.empty() );
+    CPPUNIT_ASSERT_EQUAL ( 5l, ndc.pre );
+
+    CPPUNIT_ASSERT_EQUAL ( -1l, rat_null ( -10, 6 ).decompose ( ndc, npre, nrep ) );
+    CPPUNIT_ASSERT ( npre.empty() );
+    CPPUNIT_ASSERT_EQUAL ( std::size_t ( 1 ), nrep.size() );
+    CPPUNIT_ASSERT_EQUAL ( -6l, ndc.reptend );
+
 #if defined(__GXX_EXPERIMENTAL_CXX0X__) || __cplusplus >= 201103L
 
     Rational<unsigned long>::rf_info adc;
@@ -45,6 +45,7 @@ class RationalTest RATIONAL_FINAL : public CppUnit::TestFixture {
     CPPUNIT_TEST ( testConstruct );
     CPPUNIT_TEST ( testConstructFromDouble );
     CPPUNIT_TEST ( testConstructFromExpression );
+    CPPUNIT_TEST ( testEvalBatch );
     CPPUNIT_TEST ( testAssignedFromDouble );
     CPPUNIT_TEST ( testAddition );
     CPPUNIT_TEST ( testSubtraction );
@@ -57,6 +58,16 @@ class RationalTest RATIONAL_FINAL : public CppUnit::TestFixture {
     CPPUNIT_TEST ( testGlobalOps );
     CPPUNIT_TEST ( testString );
     CPPUNIT_TEST ( testIOStreamOps );
+    CPPUNIT_TEST ( testToChars );
+    CPPUNIT_TEST ( testRadix );
+    CPPUNIT_TEST ( testRationalReader );
+    CPPUNIT_TEST ( testRationalDigits );
+    CPPUNIT_TEST ( testRationalConvergents );
+    CPPUNIT_TEST ( testSimplest );
+    CPPUNIT_TEST ( testFarey );
+    CPPUNIT_TEST ( testParallelReduce );
+    CPPUNIT_TEST ( testSerialize );
+    CPPUNIT_TEST ( testHash );
     CPPUNIT_TEST ( testPrecision );
     CPPUNIT_TEST ( testAlgorithm );
     CPPUNIT_TEST ( testStdMath );
@@ -76,6 +87,7 @@ public:
     void testConstruct();
     void testConstructFromDouble();
     void testConstructFromExpression();
+    void testEvalBatch();
     void testAssignedFromDouble();
     void testAddition();
     void testSubtraction();
@@ -88,6 +100,16 @@ public:
     void testGlobalOps();
     void testString();
     void testIOStreamOps();
+    void testToChars();
+    void testRadix();
+    void testRationalReader();
+    void testRationalDigits();
+    void testRationalConvergents();
+    void testSimplest();
+    void testFarey();
+    void testParallelReduce();
+    void testSerialize();
+    void testHash();
     void testPrecision();
     void testAlgorithm();
     void testStdMath();
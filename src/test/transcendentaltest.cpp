@@ -0,0 +1,146 @@
+/*
+ * Copyright 2026 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of rational.
+ *
+ * rational is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * rational is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with rational.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include "transcendentaltest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION ( TranscendentalTest );
+
+using namespace Commons::Math;
+
+#ifdef HAVE_GMPXX_H
+namespace {
+
+// the decimal number given by its digits and the amount of fractional digits
+gmp_rational decimal ( const char *digits, std::size_t places ) {
+    return gmp_rational ( mpz_class ( digits, 10 ), RadixPowerTraits<mpz_class>::pow ( 10,
+                          places ) );
+}
+
+}
+#endif
+
+void TranscendentalTest::testTranscendental() {
+
+    // the intermediate results need to fit into a long
+    const long_rational eps ( 1, 100 ), x[] = {
+        long_rational ( 1, 1 ), long_rational ( -2, 3 ), long_rational ( 1, 2 ),
+        long_rational ( 2, 1 ), long_rational ( -3, 1 ), long_rational ( 1, 10 )
+    };
+
+    for ( std::size_t i = 0u; i < sizeof ( x ) / sizeof ( x[0] ); ++i ) {
+
+        const double d = static_cast<double> ( x[i] );
+
+        if ( std::fabs ( d ) < 3.0 ) {
+            CPPUNIT_ASSERT ( std::fabs ( static_cast<double> ( exp ( x[i], eps ) ) -
+                                         std::exp ( d ) ) < 1e-2 );
+        }
+
+        if ( 0.0 < d ) {
+            CPPUNIT_ASSERT ( std::fabs ( static_cast<double> ( log ( x[i], eps ) ) -
+                                         std::log ( d ) ) < 1e-2 );
+        }
+
+        CPPUNIT_ASSERT ( std::fabs ( static_cast<double> ( sin ( x[i], eps ) ) -
+                                     std::sin ( d ) ) < 1e-2 );
+        CPPUNIT_ASSERT ( std::fabs ( static_cast<double> ( cos ( x[i], eps ) ) -
+                                     std::cos ( d ) ) < 1e-2 );
+        CPPUNIT_ASSERT ( std::fabs ( static_cast<double> ( atan ( x[i], eps ) ) -
+                                     std::atan ( d ) ) < 1e-2 );
+    }
+
+    // the simplest fractions within the bound
+    CPPUNIT_ASSERT_EQUAL ( long_rational ( 19, 7 ), exp ( long_rational ( 1, 1 ), eps ) );
+    CPPUNIT_ASSERT_EQUAL ( long_rational ( 22, 7 ), atan ( long_rational ( 1, 1 ), eps ) *
+                           long_rational ( 4, 1 ) );
+    CPPUNIT_ASSERT_EQUAL ( long_rational(), sin ( long_rational(), eps ) );
+    CPPUNIT_ASSERT_EQUAL ( long_rational ( 1, 1 ), cos ( long_rational(), eps ) );
+    CPPUNIT_ASSERT_EQUAL ( long_rational(), log ( long_rational ( 1, 1 ), eps ) );
+
+#ifdef __EXCEPTIONS
+    CPPUNIT_ASSERT_THROW ( log ( long_rational(), eps ), std::domain_error );
+    CPPUNIT_ASSERT_THROW ( log ( long_rational ( -1, 2 ), eps ), std::domain_error );
+    CPPUNIT_ASSERT_THROW ( exp ( long_rational ( 1, 1 ), long_rational() ), std::domain_error );
+#endif
+}
+
+void TranscendentalTest::testTranscendental_gmp() {
+#ifdef HAVE_GMPXX_H
+
+    const gmp_rational eps ( mpz_class ( 1 ), RadixPowerTraits<mpz_class>::pow ( 10, 50u ) ),
+          tol ( eps + decimal ( "1", 70u ) );
+
+    const gmp_rational one ( 1, 1 ), a ( -7, 3 ), b ( 100, 1 ), c ( -25, 2 ), d ( 1, 10 );
+
+    const struct {
+        gmp_rational r;
+        const char *digits;
+    } t[] = {
+        { exp ( one, eps ),
+            "27182818284590452353602874713526624977572470936999595749669676277240766" },
+        { exp ( a, eps ),
+            "0969719678644050628099066592983707314807208589248043936530471041083254" },
+        { exp ( gmp_rational ( 50, 1 ), eps ), "5184705528587072464087"
+            "4533229334853848274691005838464019040569338068568847937953984800903887" },
+        { log ( gmp_rational ( 2, 1 ), eps ),
+            "06931471805599453094172321214581765680755001343602552541206800094933936" },
+        { log ( gmp_rational ( mpz_class ( "100000000000000000000" ), 7 ), eps ),
+            "441057917108256003752544763502441044223849450429935983322071678694138723" },
+        { log ( gmp_rational ( 3, 1000 ), eps ),
+            "-58091429903140273606587291271305669181558139080635694763652893692652235" },
+        { sin ( one, eps ),
+            "08414709848078965066525023216302989996225630607983710656727517099919104" },
+        { cos ( one, eps ),
+            "05403023058681397174009366074429766037323104206179222276700972553811004" },
+        { sin ( b, eps ),
+            "-05063656411097587936565576104597854320650327212906573234433924735943579" },
+        { cos ( b, eps ),
+            "08623188722876839341019385139508425355100840085355108292801621126927211" },
+        { sin ( c, eps ),
+            "00663218973512006889294098198634594272735134410940920645600288285577620" },
+        { cos ( c, eps ),
+            "09977982791785806638025662028245475253770469797220760394157069013168393" },
+        { atan ( one, eps ) * gmp_rational ( 4, 1 ),
+            "31415926535897932384626433832795028841971693993751058209749445923078164" },
+        { atan ( a, eps ),
+            "-11659045405098131959192487626303088255466980635018772928200417704011546" },
+        { atan ( d, eps ),
+            "00996686524911620273784461198780205902432783225043146480155087768100277" }
+    };
+
+    for ( std::size_t i = 0u; i < sizeof ( t ) / sizeof ( t[0] ); ++i ) {
+        CPPUNIT_ASSERT ( ( t[i].r - decimal ( t[i].digits, 70u ) ).abs() <
+                         ( i == 12u ? tol * gmp_rational ( 4, 1 ) : tol ) );
+    }
+
+    // far less digits than the exact partial sums
+    CPPUNIT_ASSERT ( mpz_sizeinbase ( t[0].r.denominator().get_mpz_t(), 10 ) <= 26u );
+
+    // the squarings are rounded, so a large argument doesn't blow up the operands
+    const gmp_rational e5k ( exp ( gmp_rational ( 5000, 1 ), eps ) );
+
+    CPPUNIT_ASSERT ( mpz_sizeinbase ( e5k.denominator().get_mpz_t(), 10 ) <= 26u );
+    CPPUNIT_ASSERT ( ( log ( e5k, eps ) - gmp_rational ( 5000, 1 ) ).abs() < tol );
+    CPPUNIT_ASSERT_EQUAL ( gmp_rational(), exp ( gmp_rational ( -5000, 1 ), eps ) );
+#endif
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs on;